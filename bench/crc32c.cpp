@@ -0,0 +1,49 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <vector>
+#include <CommonLib/Communication/CRC32C.hpp>
+
+using CRC32C = Lib::Network::CRC32C;
+
+// Bytes checksummed for each case, so that every case runs for a while
+const std::size_t TOTAL_BYTES = 1ULL << 30;
+
+template <typename Func>
+double nsPerByte(const std::vector<unsigned char> &data, std::size_t size, Func func)
+{
+    std::size_t iterations = TOTAL_BYTES / size;
+    uint32_t crc = 0;
+    auto start = std::chrono::steady_clock::now();
+
+    for (std::size_t idx = 0; idx < iterations; idx++) crc = func(crc, data.data(), size);
+
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    asm volatile("" : : "r"(crc) : "memory");
+    return elapsed.count() / (double)(iterations * size);
+}
+
+int main()
+{
+    std::vector<unsigned char> data(1 << 20);
+    for (std::size_t idx = 0; idx < data.size(); idx++) data[idx] = (idx * 131) & 0xFF;
+
+    std::cout << "SSE4.2 available: " << (CRC32C::isHardwareAccelerated() ? "yes" : "no") << std::endl;
+    std::cout << std::left << std::setw(12) << "Size"
+              << std::right << std::setw(18) << "runtime ns/B"
+              << std::setw(18) << "slicing-8 ns/B"
+              << std::setw(14) << "runtime GB/s" << std::endl;
+
+    for (std::size_t size : {64, 1024, 16384, 1 << 20})
+    {
+        double runtime = nsPerByte(data, size, CRC32C::extend);
+        double software = nsPerByte(data, size, CRC32C::extendSoftware);
+
+        std::cout << std::left << std::setw(12) << size
+                  << std::right << std::fixed << std::setprecision(3)
+                  << std::setw(18) << runtime << std::setw(18) << software
+                  << std::setw(14) << 1.0 / runtime << std::endl;
+    }
+
+    return 0;
+}
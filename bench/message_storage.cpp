@@ -0,0 +1,135 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <vector>
+#include <new>
+#include <cstdlib>
+#include <CommonLib/Communication/Message.hpp>
+
+using Message = Lib::Network::Message;
+using SimpleMessage = Lib::Network::SimpleMessage;
+using DiscoverHelloMessage = Lib::Network::DiscoverHelloMessage;
+using DiscoverResponseMessage = Lib::Network::DiscoverResponseMessage;
+using ByteBufferView = Lib::Network::ByteBufferView;
+
+// Every allocation of the process goes through here, so that the
+// benchmark can count how many allocations and bytes each case needs.
+static std::size_t nofAllocations = 0;
+static std::size_t nofAllocatedBytes = 0;
+
+void *operator new(std::size_t size)
+{
+    nofAllocations++;
+    nofAllocatedBytes += size;
+    if (void *ptr = std::malloc(size)) return ptr;
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete[](void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, std::size_t) noexcept { std::free(ptr); }
+
+const std::size_t ITERATIONS = 1000000;
+
+struct Result
+{
+    double seconds;          // Elapsed time
+    std::size_t allocations; // Number of allocations
+    std::size_t bytes;       // Number of bytes allocated
+};
+
+template <typename Func>
+Result run(Func func)
+{
+    std::size_t allocations = nofAllocations;
+    std::size_t bytes = nofAllocatedBytes;
+    auto start = std::chrono::steady_clock::now();
+
+    for (std::size_t idx = 0; idx < ITERATIONS; idx++) func(idx);
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return {elapsed.count(), nofAllocations - allocations, nofAllocatedBytes - bytes};
+}
+
+void report(const std::string &name, std::size_t objectSize, const Result &res)
+{
+    std::cout << std::left << std::setw(34) << name
+              << std::right << std::setw(8) << objectSize
+              << std::setw(12) << (double)res.bytes / ITERATIONS
+              << std::setw(12) << (double)res.allocations / ITERATIONS
+              << std::setw(16) << std::fixed << std::setprecision(0) << res.allocations / res.seconds
+              << std::setw(14) << ITERATIONS / res.seconds << std::endl;
+}
+
+// The storage used before the inline buffer: a vector reserved up to the
+// capacity. Messages built without an explicit size reserved 64 KiB.
+void legacy_encode(std::size_t capacity, std::size_t idx)
+{
+    std::vector<unsigned char> buffer;
+    buffer.reserve(capacity);
+    buffer.resize(DiscoverHelloMessage::WIRE_SIZE);
+    buffer[0] = static_cast<unsigned char>(idx);
+    asm volatile("" : : "r"(buffer.data()) : "memory");
+}
+
+int main()
+{
+    std::cout << std::left << std::setw(34) << "Case"
+              << std::right << std::setw(8) << "sizeof"
+              << std::setw(12) << "Heap B/msg" << std::setw(12) << "Allocs/msg"
+              << std::setw(16) << "Allocs/s" << std::setw(14) << "Msgs/s" << std::endl;
+
+    report("legacy vector, 64 KiB reserve", sizeof(std::vector<unsigned char>),
+           run([](std::size_t idx) { legacy_encode(Lib::Network::MAX_MESSAGE_CAPACITY, idx); }));
+
+    report("legacy vector, exact reserve", sizeof(std::vector<unsigned char>),
+           run([](std::size_t idx) { legacy_encode(DiscoverHelloMessage::WIRE_SIZE, idx); }));
+
+    report("DiscoverHello encode", sizeof(DiscoverHelloMessage),
+           run([](std::size_t idx)
+    {
+        DiscoverHelloMessage msg(idx, 0);
+        msg.setUdpPort(1234);
+        msg.setTcpPort(4321);
+        msg.setIpAddress(0x0a000001);
+        msg.encode();
+        asm volatile("" : : "r"(msg.getData()) : "memory");
+    }));
+
+    DiscoverResponseMessage response(1, 1);
+    response.setAvailableMemory_mb(1024);
+    response.setCpuUsage(50);
+    response.encode();
+
+    report("DiscoverResponse decode (view)", sizeof(DiscoverResponseMessage),
+           run([&response](std::size_t)
+    {
+        ByteBufferView view(response);
+        DiscoverResponseMessage msg(view);
+        asm volatile("" : : "r"(msg.getData()) : "memory");
+    }));
+
+    report("DiscoverResponse copy", sizeof(DiscoverResponseMessage),
+           run([&response](std::size_t)
+    {
+        DiscoverResponseMessage msg(response);
+        asm volatile("" : : "r"(msg.getData()) : "memory");
+    }));
+
+    std::string text(1000, 'x');
+    report("SimpleMessage encode (1 KB)", sizeof(SimpleMessage),
+           run([&text](std::size_t idx)
+    {
+        SimpleMessage msg(idx, 0, text);
+        msg.encode();
+        asm volatile("" : : "r"(msg.getData()) : "memory");
+    }));
+
+    return 0;
+}
@@ -0,0 +1,55 @@
+-- dofile("C:/Users/ricca/Desktop/disqube/lua/batch.lua")
+
+-- Protocol: BATCH
+-- Many messages sent with a single datagram. After the 12 bytes of
+-- Common Header there are 2 bytes with the number N of messages,
+-- N * 2 bytes with the end offset of each message and the messages.
+
+Batch = Proto("Batch", "BATCH Protocol")
+
+-- Defining the fields for the protocol
+local f_count = ProtoField.uint16("Batch.count", "NOF MESSAGES", base.DEC)
+local f_offset = ProtoField.uint16("Batch.offset", "END OFFSET", base.DEC)
+local f_message = ProtoField.bytes("Batch.message", "MESSAGE")
+
+Batch.fields = { F_id, F_counter, F_flag, F_subtype, F_type, F_length, f_count, f_offset, f_message }
+
+-- Dissector Functior
+function Batch.dissector(buffer, pinfo, tree)
+    -- Check the buffer has enough length
+    if buffer:len() < 14 then
+        return false
+    end
+
+    -- Check that the subtype is BATCH
+    if CommonHeader.getHeaderSubtype(buffer) ~= 3 then
+        return false
+    end
+
+    pinfo.cols.protocol = "BATCH"
+
+    local subtree = tree:add(Batch, buffer(), "Batch Data")
+
+    -- Dissect the Common header
+    local remain_len = CommonHeader.dissect_common_header(buffer, subtree)
+
+    local count = buffer(remain_len, 2):le_uint()
+    subtree:add(f_count, count) -- MESSAGE DATA: NUMBER OF MESSAGES
+
+    -- Each message goes from the end of the previous one to its end offset
+    local table_start = remain_len + 2
+    local payload_start = table_start + count * 2
+    local start = 0
+
+    for idx = 0, count - 1 do
+        local stop = buffer(table_start + idx * 2, 2):le_uint()
+        subtree:add(f_offset, stop) -- MESSAGE DATA: END OFFSET
+        subtree:add(f_message, buffer(payload_start + start, stop - start)) -- MESSAGE DATA: MESSAGE
+        start = stop
+    end
+
+    return true
+end
+
+-- Batches can be sent to any port, hence the dissector is heuristic
+Batch:register_heuristic("udp", Batch.dissector)
@@ -6,9 +6,10 @@ F_counter = ProtoField.uint16("CommonHeader.counter", "MSG COUNTER", base.DEC)
 F_flag    = ProtoField.uint8 ("CommonHeader.flag", "PROTOCOL FLAG", base.BIN)
 F_subtype = ProtoField.uint8 ("CommonHeader.subtype", "SUBTYPE", base.DEC)
 F_type    = ProtoField.uint8 ("CommonHeader.type", "TYPE", base.DEC)
+F_length  = ProtoField.uint32("CommonHeader.length", "LENGTH", base.DEC)
 
 function CommonHeader.define_fields()
-    return {F_id, F_counter, F_flag, F_subtype, F_type}
+    return {F_id, F_counter, F_flag, F_subtype, F_type, F_length}
 end
 
 function CommonHeader.getHeaderSubtype(buffer)
@@ -22,6 +23,7 @@ function CommonHeader.dissect_common_header(buffer, subtree)
     local type = buffer(4, 1):uint()
     local subtype = buffer(5, 1):uint()
     local flag = buffer(6, 1):uint()
+    local length = buffer(8, 4):le_uint()
 
     -- Add fields to the subtree
     subtree:add(F_counter, counter) -- MESSAGE COUNTER
@@ -29,7 +31,8 @@ function CommonHeader.dissect_common_header(buffer, subtree)
     subtree:add(F_type, type)       -- MESSAGE TYPE
     subtree:add(F_subtype, subtype) -- MESSAGE SUBTYPE
     subtree:add(F_flag, flag)       -- MESSAGE PROTOCOL FLAG
+    subtree:add(F_length, length)   -- MESSAGE LENGTH
 
     -- Returns the total length of the header
-    return 8
+    return 12
 end
\ No newline at end of file
@@ -2,8 +2,8 @@
 
 -- Protocol: DISCOVER HELLO
 -- Sent by the Qube Master to the Qube Workers.
--- It is a UDP message with 12 byte of payload divided into
--- 8 bytes of Common Header and 4 bytes of actual data
+-- It is a UDP message with 20 byte of payload divided into
+-- 12 bytes of Common Header and 8 bytes of actual data
 
 Discover_hello = Proto("Discover_hello", "DISCOVER HELLO Protocol")
 
@@ -12,12 +12,12 @@ local f_tcp_prt = ProtoField.uint16("Discover_hello.tcp_prt", "TCP PORT", base.D
 local f_udp_prt = ProtoField.uint16("Discover_hello.udp_prt", "UDP PORT", base.DEC)
 local f_src_addr = ProtoField.uint32("Discover_hello.src_addr", "SRC IP ADDR", base.HEX)
 
-Discover_hello.fields = { F_id, F_counter, F_flag, F_subtype, F_type, f_tcp_prt, f_udp_prt, f_src_addr }
+Discover_hello.fields = { F_id, F_counter, F_flag, F_subtype, F_type, F_length, f_tcp_prt, f_udp_prt, f_src_addr }
 
 -- Dissector Functior
 function Discover_hello.dissector(buffer, pinfo, tree)
     -- Check the buffer has enough length
-    if buffer:len() < 16 and buffer:len() > 16 then
+    if buffer:len() < 20 and buffer:len() > 20 then
         return
     end
 
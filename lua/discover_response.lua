@@ -11,7 +11,7 @@ local resp_free_ram_kb = ProtoField.uint32("Discover_response.free_ram_kb", "FRE
 local resp_cpu_usage = ProtoField.uint8("Discover_response.cpu_usage", "CPU USAGE %", base.DEC)
 
 Discover_response.fields = {
-    F_id, F_counter, F_flag, F_subtype, F_type, resp_udp_prt, resp_tcp_prt,
+    F_id, F_counter, F_flag, F_subtype, F_type, F_length, resp_udp_prt, resp_tcp_prt,
     resp_ip_addr, resp_free_ram_mb, resp_free_ram_kb, resp_cpu_usage
 }
 
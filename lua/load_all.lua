@@ -1,3 +1,4 @@
 dofile("C:/Users/ricca/Desktop/disqube/lua/common_header.lua")
 -- dofile("C:/Users/ricca/Desktop/disqube/lua/discover_hello.lua")
-dofile("C:/Users/ricca/Desktop/disqube/lua/discover_response.lua")
\ No newline at end of file
+dofile("C:/Users/ricca/Desktop/disqube/lua/discover_response.lua")
+dofile("C:/Users/ricca/Desktop/disqube/lua/batch.lua")
\ No newline at end of file
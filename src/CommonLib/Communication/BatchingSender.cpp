@@ -0,0 +1,104 @@
+#include "BatchingSender.hpp"
+
+using namespace Lib::Network;
+
+void BatchingSender::flush(const Destination &dst, PendingBatch &pending)
+{
+    std::size_t nofMessages = pending.batch.getNofMessages();
+    if (nofMessages == 0) return;
+
+    if (nofMessages == 1)
+    {
+        // A single message does not need the batch overhead
+        ByteBufferView msg = pending.batch.getMessage(0);
+        _sender->sendMessage(dst.first, dst.second, msg.getData(), msg.getBufferSize());
+    }
+    else
+    {
+        pending.batch.setMessageId(_nextId++);
+        _sender->sendTo(dst.first, dst.second, pending.batch);
+    }
+
+    pending.batch.reset();
+}
+
+void BatchingSender::sendTo(const std::string &ip, const unsigned short port, Message &msg)
+{
+    msg.encode();
+    const unsigned char *data = msg.getData();
+    std::size_t nofBytes = msg.getBufferSize();
+
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    // Messages that cannot fit a batch on their own are sent as they are
+    if (BatchMessage::getEncodedSize(1, nofBytes) > _maxBatchSize)
+    {
+        _sender->sendMessage(ip, port, data, nofBytes);
+        return;
+    }
+
+    Destination dst(ip, port);
+    std::unique_ptr<PendingBatch> &pending = _pending[dst];
+    if (pending == nullptr) pending = std::make_unique<PendingBatch>(0, _maxBatchSize);
+
+    // If the message does not fit, the current batch leaves first
+    if (!pending->batch.add(data, nofBytes))
+    {
+        flush(dst, *pending);
+        pending->batch.add(data, nofBytes);
+    }
+
+    // The first message of a batch starts its timer
+    if (pending->batch.getNofMessages() == 1)
+    {
+        pending->deadline = Clock::now() + _maxDelay;
+        _wakeup.notify_one();
+    }
+}
+
+void BatchingSender::flush()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    for (auto &entry : _pending) flush(entry.first, *entry.second);
+}
+
+void BatchingSender::stop()
+{
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _stopped = true;
+        _wakeup.notify_one();
+    }
+
+    join();
+    flush();
+}
+
+void BatchingSender::run()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    while (!_stopped)
+    {
+        // Send the batches that waited enough, and find the next deadline
+        Clock::time_point now = Clock::now();
+        Clock::time_point next = Clock::time_point::max();
+
+        for (auto &entry : _pending)
+        {
+            PendingBatch &pending = *entry.second;
+            if (pending.batch.getNofMessages() == 0) continue;
+
+            if (pending.deadline <= now) flush(entry.first, pending);
+            else next = std::min(next, pending.deadline);
+        }
+
+        if (next == Clock::time_point::max()) _wakeup.wait(lock);
+        else _wakeup.wait_until(lock, next);
+    }
+}
+
+bool BatchingSender::isRunning() const
+{
+    return _started && !_stopped;
+}
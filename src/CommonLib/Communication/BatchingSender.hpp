@@ -0,0 +1,82 @@
+#ifndef _BATCHINGSENDER_HPP
+#define _BATCHINGSENDER_HPP
+
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <chrono>
+#include <condition_variable>
+#include <CommonLib/Concurrency/Thread.hpp>
+#include <CommonLib/Communication/Sender.hpp>
+#include <CommonLib/Communication/Message.hpp>
+
+#define BATCH_MAX_SIZE 1400     // Fits a single Ethernet frame and the receive buffer
+#define BATCH_MAX_DELAY_US 2000 // Maximum time a message waits before being sent
+
+namespace Lib::Network
+{
+    /**
+     * A wrapper of a Sender that accumulates the outgoing messages of each
+     * destination into a BatchMessage. A batch is sent when the next message
+     * would make it larger than the maximum size, or when its first message
+     * has been waiting for the maximum delay. The latter is checked by the
+     * thread of the batching sender, that must be started.
+     *
+     * All the sends go through the same lock, so the wrapped sender must not
+     * be used directly while the batching sender is running.
+     */
+    class BatchingSender : public Concurrency::Thread
+    {
+    private:
+        using Clock = std::chrono::steady_clock;
+        using Destination = std::pair<std::string, unsigned short>;
+
+        struct PendingBatch
+        {
+            PendingBatch(const uint16_t id, const std::size_t capacity) : batch(id, 0, capacity) {};
+
+            BatchMessage batch;           // The messages waiting to be sent
+            Clock::time_point deadline;   // When the batch must be sent at most
+        };
+
+        std::shared_ptr<Sender> _sender;     // The wrapped sender
+        std::size_t _maxBatchSize;           // Maximum number of bytes of a batch
+        std::chrono::microseconds _maxDelay; // Maximum waiting time of a message
+        uint16_t _nextId;                    // Id of the next batch
+        bool _stopped;
+
+        std::map<Destination, std::unique_ptr<PendingBatch>> _pending;
+        std::mutex _mutex;
+        std::condition_variable _wakeup;
+
+        void flush(const Destination &dst, PendingBatch &pending);
+
+    public:
+        BatchingSender(const std::shared_ptr<Sender> &sender, const std::size_t maxBatchSize,
+                       const long int maxDelay_us)
+            : Thread("BatchingSender"), _sender(sender), _maxBatchSize(maxBatchSize),
+              _maxDelay(maxDelay_us), _nextId(0), _stopped(false) {};
+
+        BatchingSender(const std::shared_ptr<Sender> &sender)
+            : BatchingSender(sender, BATCH_MAX_SIZE, BATCH_MAX_DELAY_US) {};
+
+        ~BatchingSender()
+        {
+            stop();
+        }
+
+        // Queues the message for the destination, it can be sent later
+        void sendTo(const std::string &ip, const unsigned short port, Message &msg);
+
+        void flush(); // Sends all the pending batches right now
+        void stop();  // Sends all the pending batches and stops the thread
+
+        void run() override;
+        bool isRunning() const override;
+    };
+
+    typedef std::shared_ptr<BatchingSender> BatchingSender_ptr;
+}
+
+#endif
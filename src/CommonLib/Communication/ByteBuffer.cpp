@@ -6,9 +6,11 @@ ByteBuffer::ByteBuffer(const std::size_t capacity)
 {
     _capacity = capacity;
     _position = 0;
+    _size = 0;
 
-    // Reserve the given number of bytes for the buffer
-    _buffer.reserve(_capacity);
+    // Start from the inline storage, the heap is used only if needed
+    _allocated = INLINE_CAPACITY;
+    _data = _inline;
 
     // Set Big Endian as the default byte order
     _order = ByteOrder::BigEndian;
@@ -21,6 +23,11 @@ ByteBuffer::ByteBuffer(const unsigned char *buffer, const std::size_t nofBytes)
     position(0);
 }
 
+ByteBuffer::ByteBuffer(const ByteBuffer &other) : ByteBuffer(other._capacity)
+{
+    *this = other;
+}
+
 ByteBuffer &ByteBuffer::operator=(const ByteBuffer &other)
 {
     if (this != &other)
@@ -28,10 +35,12 @@ ByteBuffer &ByteBuffer::operator=(const ByteBuffer &other)
         _capacity = other._capacity;
         _position = other._position;
         _order = other._order;
-                    
-        // Copy the vector content
-        _buffer.resize(other._buffer.size());
-        std::copy(other._buffer.begin(), other._buffer.end(), _buffer.begin());
+
+        // Only the content is copied, not the whole storage
+        _size = 0;
+        grow(other._size);
+        memcpy(_data, other._data, other._size);
+        _size = other._size;
     }
 
     return *this;
@@ -42,7 +51,7 @@ void ByteBuffer::setByteOrder(const ByteOrder &newOrder)
     _order = newOrder;
 }
 
-const ByteBuffer::ByteOrder & ByteBuffer::getByteOrder()
+const ByteBuffer::ByteOrder & ByteBuffer::getByteOrder() const
 {
     return _order;
 }
@@ -59,7 +68,7 @@ void ByteBuffer::position(std::size_t newPos)
 
 std::size_t ByteBuffer::getBufferSize() const
 {
-    return _buffer.size();
+    return _size;
 }
 
 std::size_t ByteBuffer::getBufferCapacity() const
@@ -79,69 +88,96 @@ std::size_t ByteBuffer::getRemainingSize() const
 
 bool ByteBuffer::isEmpty() const
 {
-    return _buffer.empty();
+    return _size == 0;
 }
 
 void ByteBuffer::clear()
 {
-    _buffer.clear();
+    // The storage is kept, so a cleared buffer can be refilled for free
+    _size = 0;
     position(0);
 }
 
-void ByteBuffer::spare()
+void ByteBuffer::reserve(const std::size_t nofBytes)
 {
-    put(static_cast<unsigned char>(0.0));
+    grow(std::min(nofBytes, _capacity));
 }
 
-void ByteBuffer::put(const unsigned char _data)
+void ByteBuffer::grow(const std::size_t nofBytes)
 {
-    ByteBuffer::checkForOutOfBound(_position, ByteBuffer::BYTE_SIZE, _capacity, "ByteBuffer::put");
-    _buffer.insert(_buffer.begin() + _position, _data);
-    position(_position + ByteBuffer::BYTE_SIZE);
+    if (nofBytes <= _allocated) return;
+
+    // Double the storage to amortize the copies, but never beyond the capacity
+    std::size_t newSize = std::max(nofBytes, std::min(2 * _allocated, _capacity));
+    std::unique_ptr<unsigned char[]> storage(new unsigned char[newSize]);
+    memcpy(storage.get(), _data, _size);
+
+    _heap = std::move(storage);
+    _data = _heap.get();
+    _allocated = newSize;
 }
 
-void ByteBuffer::put(const unsigned short _data)
+void ByteBuffer::spare()
 {
-    ByteBuffer::checkForOutOfBound(_position, ByteBuffer::SHORT_SIZE, _capacity, "ByteBuffer::put");
+    put(static_cast<unsigned char>(0.0));
+}
 
-    unsigned short x = _data;
+unsigned char *ByteBuffer::prepareWrite(const std::size_t _size, const char *_func)
+{
+    ByteBuffer::checkForOutOfBound(_position, _size, _capacity, _func);
 
-    // Check if the byte order is big or little endian
-    if (_order == ByteOrder::BigEndian) x = htobe16(x);
+    // Writing past the current end grows the content
+    if (_position + _size > this->_size)
+    {
+        grow(_position + _size);
 
-    unsigned char _datau = x >> 8;
-    unsigned char _datal = x & ~(_datau << 8);
+        // Bytes skipped by moving the cursor past the end are zeroed
+        if (_position > this->_size) memset(_data + this->_size, 0, _position - this->_size);
+        this->_size = _position + _size;
+    }
 
-    put(_datau);
-    put(_datal);
-    
+    unsigned char *dst = _data + _position;
+    position(_position + _size);
+    return dst;
 }
 
-void ByteBuffer::put(const unsigned int _data)
+const unsigned char *ByteBuffer::prepareRead(const std::size_t _size, const char *_func)
 {
-    ByteBuffer::checkForOutOfBound(_position, ByteBuffer::INT_SIZE, _capacity, "ByteBuffer::put");
+    ByteBuffer::errorIfEmpty(this, _func);
+    ByteBuffer::checkForOutOfBound(_position, _size, getBufferSize(), _func);
+
+    const unsigned char *src = _data + _position;
+    position(_position + _size);
+    return src;
+}
 
-    unsigned int x = _data;
+void ByteBuffer::put(const unsigned char _data)
+{
+    *prepareWrite(ByteBuffer::BYTE_SIZE, "ByteBuffer::put") = _data;
+}
 
-    // Check if the byte order is big or little endian
-    if (_order == ByteOrder::BigEndian) x = htobe32(x);
+void ByteBuffer::put(const unsigned short _data)
+{
+    unsigned char *dst = prepareWrite(ByteBuffer::SHORT_SIZE, "ByteBuffer::put");
+    ByteSwap::store(dst, static_cast<uint16_t>(_data), _order == ByteOrder::BigEndian);
+}
 
-    unsigned short _datau = x >> 16;
-    unsigned short _datal = x & ~(_datau << 16);
+void ByteBuffer::put(const unsigned int _data)
+{
+    unsigned char *dst = prepareWrite(ByteBuffer::INT_SIZE, "ByteBuffer::put");
+    ByteSwap::store(dst, static_cast<uint32_t>(_data), _order == ByteOrder::BigEndian);
+}
 
-    put(_datau);
-    put(_datal);
+void ByteBuffer::put(const uint64_t _data)
+{
+    unsigned char *dst = prepareWrite(ByteBuffer::LONG_SIZE, "ByteBuffer::put");
+    ByteSwap::store(dst, _data, _order == ByteOrder::BigEndian);
 }
 
 void ByteBuffer::put(const unsigned char* _data, const int _start, const std::size_t _size)
 {
     position(_start);
-    ByteBuffer::checkForOutOfBound(_start, _size, _capacity, "ByteBuffer::put");
-
-    for (std::size_t pos = 0; pos < _size; pos++)
-    {
-        put(_data[pos]);
-    }
+    memcpy(prepareWrite(_size, "ByteBuffer::put"), _data, _size);
 }
 
 void ByteBuffer::put(const unsigned char* _data, const std::size_t _size)
@@ -149,62 +185,51 @@ void ByteBuffer::put(const unsigned char* _data, const std::size_t _size)
     put(_data, _position, _size);
 }
 
-unsigned char ByteBuffer::get()
+void ByteBuffer::put(const uint16_t *_data, const std::size_t _count)
 {
-    ByteBuffer::checkForOutOfBound(_position, ByteBuffer::BYTE_SIZE, _capacity, "ByteBuffer::get");
-    ByteBuffer::errorIfEmpty(this, "ByteBuffer::get");
-
-    unsigned char ret = _buffer.at(_position);
-    position(_position + ByteBuffer::BYTE_SIZE);
-    return ret;
+    unsigned char *dst = prepareWrite(_count * ByteBuffer::SHORT_SIZE, "ByteBuffer::put");
+    ByteSwap::storeArray(dst, _data, _count, _order == ByteOrder::BigEndian);
 }
 
-unsigned short ByteBuffer::getShort()
+void ByteBuffer::put(const uint32_t *_data, const std::size_t _count)
 {
-    ByteBuffer::checkForOutOfBound(_position, ByteBuffer::SHORT_SIZE, _capacity, "ByteBuffer::getShort");
-    ByteBuffer::errorIfEmpty(this, "ByteBuffer::getShort");
+    unsigned char *dst = prepareWrite(_count * ByteBuffer::INT_SIZE, "ByteBuffer::put");
+    ByteSwap::storeArray(dst, _data, _count, _order == ByteOrder::BigEndian);
+}
 
-    unsigned char ret1 = get();
-    unsigned char ret2 = get();
-    unsigned short ret = (ret1 << 8) + ret2;
+void ByteBuffer::put(const uint64_t *_data, const std::size_t _count)
+{
+    unsigned char *dst = prepareWrite(_count * ByteBuffer::LONG_SIZE, "ByteBuffer::put");
+    ByteSwap::storeArray(dst, _data, _count, _order == ByteOrder::BigEndian);
+}
 
-    // Check the byte order
-    if (_order == ByteOrder::BigEndian)
-    {
-        ret = be16toh(ret);
-    }
+unsigned char ByteBuffer::get()
+{
+    return *prepareRead(ByteBuffer::BYTE_SIZE, "ByteBuffer::get");
+}
 
-    return ret;
+unsigned short ByteBuffer::getShort()
+{
+    const unsigned char *src = prepareRead(ByteBuffer::SHORT_SIZE, "ByteBuffer::getShort");
+    return ByteSwap::load16(src, _order == ByteOrder::BigEndian);
 }
 
 unsigned int ByteBuffer::getInt()
 {
-    ByteBuffer::checkForOutOfBound(_position, ByteBuffer::INT_SIZE, _capacity, "ByteBuffer::getInt");
-    ByteBuffer::errorIfEmpty(this, "ByteBuffer::getInt");
-
-    unsigned short ret1 = getShort();
-    unsigned short ret2 = getShort();
-    unsigned int ret = (ret1 << 16) + ret2;
-
-    // Check the byte order
-    if (_order == ByteOrder::BigEndian)
-    {
-        ret = be32toh(ret);
-    }
+    const unsigned char *src = prepareRead(ByteBuffer::INT_SIZE, "ByteBuffer::getInt");
+    return ByteSwap::load32(src, _order == ByteOrder::BigEndian);
+}
 
-    return ret;
+uint64_t ByteBuffer::getLong()
+{
+    const unsigned char *src = prepareRead(ByteBuffer::LONG_SIZE, "ByteBuffer::getLong");
+    return ByteSwap::load64(src, _order == ByteOrder::BigEndian);
 }
 
 void ByteBuffer::getBuffer(unsigned char* _data, const int _start, const std::size_t _size)
 {
     position(_start);
-    ByteBuffer::checkForOutOfBound(_position, _size, _capacity, "ByteBuffer::getBuffer");
-    ByteBuffer::errorIfEmpty(this, "ByteBuffer::getBuffer");
-
-    for (std::size_t pos = 0; pos < _size; pos++)
-    {
-        _data[pos] = get();
-    }
+    memcpy(_data, prepareRead(_size, "ByteBuffer::getBuffer"), _size);
 }
 
 void ByteBuffer::getBuffer(unsigned char* _data, const std::size_t _size)
@@ -212,20 +237,59 @@ void ByteBuffer::getBuffer(unsigned char* _data, const std::size_t _size)
     getBuffer(_data, _position, _size);
 }
 
-const ByteBuffer::buffer_t& ByteBuffer::getBuffer() const
+void ByteBuffer::getShorts(uint16_t *_data, const std::size_t _count)
+{
+    const unsigned char *src = prepareRead(_count * ByteBuffer::SHORT_SIZE, "ByteBuffer::getShorts");
+    ByteSwap::loadArray(_data, src, _count, _order == ByteOrder::BigEndian);
+}
+
+void ByteBuffer::getInts(uint32_t *_data, const std::size_t _count)
+{
+    const unsigned char *src = prepareRead(_count * ByteBuffer::INT_SIZE, "ByteBuffer::getInts");
+    ByteSwap::loadArray(_data, src, _count, _order == ByteOrder::BigEndian);
+}
+
+void ByteBuffer::getLongs(uint64_t *_data, const std::size_t _count)
+{
+    const unsigned char *src = prepareRead(_count * ByteBuffer::LONG_SIZE, "ByteBuffer::getLongs");
+    ByteSwap::loadArray(_data, src, _count, _order == ByteOrder::BigEndian);
+}
+
+std::vector<unsigned char> ByteBuffer::getBuffer() const
+{
+    return std::vector<unsigned char>(_data, _data + _size);
+}
+
+unsigned char *ByteBuffer::write(const std::size_t nofBytes)
+{
+    return prepareWrite(nofBytes, "ByteBuffer::write");
+}
+
+const unsigned char *ByteBuffer::getData() const
+{
+    return _data;
+}
+
+unsigned char *ByteBuffer::getData()
+{
+    return _data;
+}
+
+void ByteBuffer::truncate(const std::size_t nofBytes)
 {
-    return _buffer;
+    _size = std::min(_size, nofBytes);
+    _position = std::min(_position, _size);
 }
 
 void ByteBuffer::checkForOutOfBound(
-    const int _position, const std::size_t _size, const std::size_t _max, std::string _func
+    const int _position, const std::size_t _size, const std::size_t _max, const char *_func
 ) {
     if (_position + _size > _max)
     {
         char message[200];
         snprintf(
             message, sizeof(message), "[%s] Index Out Of Bound: %ld > %ld\n", 
-            _func.c_str(), _position + _size, _max
+            _func, _position + _size, _max
         );
 
         std::cerr << message << std::endl;
@@ -233,12 +297,12 @@ void ByteBuffer::checkForOutOfBound(
     }
 }
 
-void ByteBuffer::errorIfEmpty(ByteBuffer* _buff, std::string _func)
+void ByteBuffer::errorIfEmpty(ByteBuffer* _buff, const char *_func)
 {
     if (_buff->isEmpty())
     {
         char message[200];
-        snprintf(message, sizeof(message), "[%s] The Buffer is Empty.\n",_func.c_str());
+        snprintf(message, sizeof(message), "[%s] The Buffer is Empty.\n",_func);
         std::string msg = message;
         std::cerr << msg << std::endl;
         exit(EXIT_FAILURE);
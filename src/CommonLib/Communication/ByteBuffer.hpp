@@ -7,21 +7,33 @@
 #include <memory>
 #include <algorithm>
 #include <endian.h>
+#include <cstring>
+#include <CommonLib/Communication/ByteSwap.hpp>
 
 namespace Lib::Network
 {
     class ByteBuffer
     {
     private:
-        static void checkForOutOfBound(const int, const std::size_t, const std::size_t, std::string);
-        static void errorIfEmpty(ByteBuffer *_buff, std::string _func);
+        static void checkForOutOfBound(const int, const std::size_t, const std::size_t, const char *);
+        static void errorIfEmpty(ByteBuffer *_buff, const char *_func);
 
-        using buffer_t = std::vector<unsigned char>;
+        // Makes the storage able to hold at least nofBytes bytes
+        void grow(const std::size_t nofBytes);
+
+        friend class ByteBufferView;
+        friend class RingBuffer;
 
     public:
         const static std::size_t BYTE_SIZE = 1;
         const static std::size_t SHORT_SIZE = 2;
         const static std::size_t INT_SIZE = 4;
+        const static std::size_t LONG_SIZE = 8;
+
+        // Contents up to this size live inside the object itself, larger
+        // ones are moved to the heap, which then grows geometrically
+        // (up to the capacity) as the content grows.
+        const static std::size_t INLINE_CAPACITY = 128;
 
         enum class ByteOrder
         {
@@ -31,23 +43,14 @@ namespace Lib::Network
 
         ByteBuffer(const std::size_t capacity);
         ByteBuffer(const unsigned char *buffer, const std::size_t nofBytes);
-        ByteBuffer(const ByteBuffer &other)
-        {
-            _order = other._order;
-            _capacity = other._capacity;
-            _position = other._position;
-
-            // Copy the vector content
-            _buffer.resize(other._buffer.size());
-            std::copy(other._buffer.begin(), other._buffer.end(), _buffer.begin());
-        }
+        ByteBuffer(const ByteBuffer &other);
 
         ~ByteBuffer() = default;
 
         ByteBuffer &operator=(const ByteBuffer &other);
 
         void setByteOrder(const ByteOrder &newOrder);
-        const ByteOrder &getByteOrder();
+        const ByteOrder &getByteOrder() const;
 
         std::size_t position() const;
         void position(std::size_t newPos);
@@ -59,26 +62,59 @@ namespace Lib::Network
         bool isEmpty() const;
         void clear();
 
+        // Allocates in advance the storage for nofBytes (at most the capacity)
+        void reserve(const std::size_t nofBytes);
+
         void spare();
         void put(const unsigned char _data);
         void put(const unsigned short _data);
         void put(const unsigned int _data);
+        void put(const uint64_t _data);
         void put(const unsigned char *_data, const int _start, const std::size_t _size);
         void put(const unsigned char *_data, const std::size_t _size);
 
+        // Moves the cursor of nofBytes and returns where to write them
+        unsigned char *write(const std::size_t nofBytes);
+
+        // Bulk versions, _count is the number of elements (not bytes)
+        void put(const uint16_t *_data, const std::size_t _count);
+        void put(const uint32_t *_data, const std::size_t _count);
+        void put(const uint64_t *_data, const std::size_t _count);
+
         unsigned char get();
         unsigned short getShort();
         unsigned int getInt();
+        uint64_t getLong();
         void getBuffer(unsigned char *_data, const int _start, const std::size_t _size);
         void getBuffer(unsigned char *_data, const std::size_t _size);
 
-        const buffer_t &getBuffer() const;
+        // Bulk versions, _count is the number of elements (not bytes)
+        void getShorts(uint16_t *_data, const std::size_t _count);
+        void getInts(uint32_t *_data, const std::size_t _count);
+        void getLongs(uint64_t *_data, const std::size_t _count);
+
+        // Returns a copy of the content, use getData to avoid the copy
+        std::vector<unsigned char> getBuffer() const;
+        const unsigned char *getData() const;
+        unsigned char *getData();
+
+        // Drops the content past the first nofBytes bytes
+        void truncate(const std::size_t nofBytes);
 
     protected:
-        std::size_t _capacity; //!< The maximum capacity of the buffer
-        std::size_t _position; //!< The current position into the buffer
-        buffer_t _buffer;      //!< The buffer
-        ByteOrder _order;      //!< Either Big/Little-Edian
+        // Check the bounds, move the cursor of _size bytes and returns
+        // a pointer to the bytes that have to be written or read.
+        unsigned char *prepareWrite(const std::size_t _size, const char *_func);
+        const unsigned char *prepareRead(const std::size_t _size, const char *_func);
+
+        std::size_t _capacity;                  //!< The maximum capacity of the buffer
+        std::size_t _position;                  //!< The current position into the buffer
+        std::size_t _size;                      //!< The number of bytes in the buffer
+        std::size_t _allocated;                 //!< The number of bytes of the storage
+        unsigned char *_data;                   //!< Either the inline or the heap storage
+        std::unique_ptr<unsigned char[]> _heap; //!< The heap storage, if any
+        unsigned char _inline[INLINE_CAPACITY]; //!< The inline storage
+        ByteOrder _order;                       //!< Either Big/Little-Edian
     };
 
     typedef std::shared_ptr<ByteBuffer> ByteBuffer_ptr;
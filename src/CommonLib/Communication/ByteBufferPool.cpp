@@ -0,0 +1,140 @@
+#include "ByteBufferPool.hpp"
+
+using namespace Lib::Network;
+
+namespace
+{
+    std::atomic<std::uint64_t> nextPoolId{0};
+}
+
+ByteBufferPool::LocalCache::~LocalCache()
+{
+    // When a thread exits, its cached slots go back to the shared list.
+    // If the pool is already gone the slots have been freed with it.
+    std::shared_ptr<ByteBufferPool> owner = pool.lock();
+    if (owner == nullptr) return;
+
+    std::unique_lock<std::mutex> lock(owner->_mutex);
+    owner->_free.insert(owner->_free.end(), slots.begin(), slots.end());
+}
+
+ByteBufferPool::ByteBufferPool(const std::size_t nofBuffers, const std::size_t bufferSize)
+    : _bufferSize(bufferSize), _id(nextPoolId++), _hits(0), _misses(0), _inUse(0), _highWater(0)
+{
+    // Allocates the whole slab at once, all slots are initially free
+    _slab.reserve(nofBuffers);
+    _free.reserve(nofBuffers);
+
+    for (std::size_t idx = 0; idx < nofBuffers; idx++)
+    {
+        _slab.push_back(std::make_unique<Slot>(bufferSize));
+        _free.push_back(_slab.back().get());
+    }
+}
+
+ByteBufferPool::LocalCache &ByteBufferPool::getLocalCache()
+{
+    static thread_local std::unordered_map<std::uint64_t, LocalCache> caches;
+
+    auto it = caches.find(_id);
+    if (it != caches.end()) return it->second;
+
+    // Before adding a new cache, drop those of pools that do not exist anymore
+    for (auto cache = caches.begin(); cache != caches.end();)
+    {
+        if (cache->second.pool.expired()) cache = caches.erase(cache);
+        else cache++;
+    }
+
+    LocalCache &cache = caches[_id];
+    cache.pool = weak_from_this();
+    cache.slots.reserve(LOCAL_CACHE_SIZE);
+    return cache;
+}
+
+ByteBufferPool::Slot *ByteBufferPool::take()
+{
+    LocalCache &cache = getLocalCache();
+
+    // If the local cache is empty, refill half of it from the shared list
+    if (cache.slots.empty())
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        std::size_t nofSlots = std::min(_free.size(), LOCAL_CACHE_SIZE / 2);
+        cache.slots.insert(cache.slots.end(), _free.end() - nofSlots, _free.end());
+        _free.resize(_free.size() - nofSlots);
+    }
+
+    if (cache.slots.empty()) return nullptr;
+
+    Slot *slot = cache.slots.back();
+    cache.slots.pop_back();
+    return slot;
+}
+
+void ByteBufferPool::release(Slot *slot)
+{
+    _inUse--;
+
+    LocalCache &cache = getLocalCache();
+    if (cache.slots.size() < LOCAL_CACHE_SIZE)
+    {
+        cache.slots.push_back(slot);
+        return;
+    }
+
+    // The local cache is full, hence give half of it back to the shared list
+    std::unique_lock<std::mutex> lock(_mutex);
+    _free.insert(_free.end(), cache.slots.end() - LOCAL_CACHE_SIZE / 2, cache.slots.end());
+    cache.slots.resize(cache.slots.size() - LOCAL_CACHE_SIZE / 2);
+    _free.push_back(slot);
+}
+
+ByteBuffer_ptr ByteBufferPool::acquire()
+{
+    return acquire(_bufferSize);
+}
+
+ByteBuffer_ptr ByteBufferPool::acquire(const std::size_t nofBytes)
+{
+    Slot *slot = (nofBytes <= _bufferSize) ? take() : nullptr;
+
+    // If the pool is exhausted or the request is too large, fallback to the heap
+    if (slot == nullptr)
+    {
+        _misses++;
+        return std::make_shared<ByteBuffer>(std::max(nofBytes, _bufferSize));
+    }
+
+    _hits++;
+    std::size_t inUse = ++_inUse;
+    std::size_t highWater = _highWater.load();
+    while (inUse > highWater && !_highWater.compare_exchange_weak(highWater, inUse));
+
+    // Reset the buffer to the state of a newly created one
+    slot->buffer.clear();
+    slot->buffer.setByteOrder(ByteBuffer::ByteOrder::BigEndian);
+
+    return ByteBuffer_ptr(&slot->buffer, [](ByteBuffer*) {},
+                          SlotAllocator<ByteBuffer>(slot, shared_from_this()));
+}
+
+std::size_t ByteBufferPool::getBufferSize() const
+{
+    return _bufferSize;
+}
+
+std::size_t ByteBufferPool::getNofBuffers() const
+{
+    return _slab.size();
+}
+
+PoolStats ByteBufferPool::getStats() const
+{
+    struct PoolStats stats;
+    stats.hits = _hits.load();
+    stats.misses = _misses.load();
+    stats.inUse = _inUse.load();
+    stats.highWater = _highWater.load();
+    return stats;
+}
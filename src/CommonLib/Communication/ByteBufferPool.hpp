@@ -0,0 +1,137 @@
+#ifndef _BYTEBUFFERPOOL_HPP
+#define _BYTEBUFFERPOOL_HPP
+
+#include <iostream>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <unordered_map>
+#include <cstddef>
+#include <CommonLib/Communication/ByteBuffer.hpp>
+
+namespace Lib::Network
+{
+    /**
+     * Statistics of a ByteBufferPool. A hit is a buffer served from the
+     * pool, a miss is a buffer allocated on the heap because the pool was
+     * exhausted (or the requested size was larger than the pooled one).
+     */
+    struct PoolStats
+    {
+        std::size_t hits;      // Number of buffers served by the pool
+        std::size_t misses;    // Number of buffers allocated outside the pool
+        std::size_t inUse;     // Number of pooled buffers currently in use
+        std::size_t highWater; // Maximum number of pooled buffers in use at once
+    };
+
+    /**
+     * A slab of fixed-size ByteBuffers that are handed out as ByteBuffer_ptr.
+     * When the last reference to a buffer goes away, the buffer goes back
+     * to the pool instead of being freed. Also the shared pointer control
+     * block lives inside the slab, so acquiring and releasing a buffer never
+     * goes through the global allocator. Each thread keeps a small cache of
+     * free buffers, and only goes to the shared free list (under lock) when
+     * its cache is empty or full.
+     *
+     * The pool must be owned by a std::shared_ptr (see ByteBufferPool_ptr),
+     * since every outstanding buffer keeps the pool alive.
+     */
+    class ByteBufferPool : public std::enable_shared_from_this<ByteBufferPool>
+    {
+    public:
+        const static std::size_t LOCAL_CACHE_SIZE = 16;   // Max buffers cached per thread
+        const static std::size_t CONTROL_BLOCK_SIZE = 64; // Bytes for the shared_ptr control block
+
+    private:
+        struct Slot
+        {
+            Slot(const std::size_t size) : buffer(size) { buffer.reserve(size); };
+
+            ByteBuffer buffer; // The pooled buffer
+            alignas(std::max_align_t) unsigned char control[CONTROL_BLOCK_SIZE];
+        };
+
+        /**
+         * Allocator used for the control block of the shared pointers. It
+         * places the block into the slot, and gives the slot back to the
+         * pool when the block is deallocated, i.e., as the very last step
+         * of the destruction of the last ByteBuffer_ptr.
+         */
+        template <typename T>
+        struct SlotAllocator
+        {
+            using value_type = T;
+
+            Slot *slot;                           // The slot hosting the control block
+            std::shared_ptr<ByteBufferPool> pool; // Keeps the pool alive
+
+            SlotAllocator(Slot *s, const std::shared_ptr<ByteBufferPool> &p) : slot(s), pool(p) {};
+
+            template <typename U>
+            SlotAllocator(const SlotAllocator<U> &other) : slot(other.slot), pool(other.pool) {}
+
+            T *allocate(std::size_t)
+            {
+                static_assert(sizeof(T) <= CONTROL_BLOCK_SIZE, "Control block does not fit the slot");
+                static_assert(alignof(T) <= alignof(std::max_align_t), "Over-aligned control block");
+                return reinterpret_cast<T*>(slot->control);
+            }
+
+            void deallocate(T *, std::size_t)
+            {
+                pool->release(slot);
+            }
+
+            template <typename U>
+            bool operator==(const SlotAllocator<U> &other) const { return slot == other.slot; }
+
+            template <typename U>
+            bool operator!=(const SlotAllocator<U> &other) const { return slot != other.slot; }
+        };
+
+        struct LocalCache
+        {
+            std::weak_ptr<ByteBufferPool> pool; // The pool the cached slots belong to
+            std::vector<Slot*> slots;           // The cached free slots
+
+            ~LocalCache();
+        };
+
+        std::size_t _bufferSize;                  // Capacity of each pooled buffer
+        std::uint64_t _id;                        // Unique identifier of the pool
+        std::vector<std::unique_ptr<Slot>> _slab; // All the slots of the pool
+        std::vector<Slot*> _free;                 // Shared list of free slots
+        std::mutex _mutex;                        // Protects the shared free list
+
+        std::atomic<std::size_t> _hits;
+        std::atomic<std::size_t> _misses;
+        std::atomic<std::size_t> _inUse;
+        std::atomic<std::size_t> _highWater;
+
+        LocalCache &getLocalCache();
+        Slot *take();
+        void release(Slot *slot);
+
+    public:
+        ByteBufferPool(const std::size_t nofBuffers, const std::size_t bufferSize);
+        ByteBufferPool(const ByteBufferPool &other) = delete;
+        ~ByteBufferPool() = default;
+
+        ByteBufferPool &operator=(const ByteBufferPool &other) = delete;
+
+        // Returns an empty buffer with the pooled capacity
+        ByteBuffer_ptr acquire();
+
+        // Returns an empty buffer able to hold at least nofBytes
+        ByteBuffer_ptr acquire(const std::size_t nofBytes);
+
+        std::size_t getBufferSize() const;
+        std::size_t getNofBuffers() const;
+        struct PoolStats getStats() const;
+    };
+
+    typedef std::shared_ptr<ByteBufferPool> ByteBufferPool_ptr;
+}
+
+#endif
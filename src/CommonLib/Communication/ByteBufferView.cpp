@@ -0,0 +1,109 @@
+#include "ByteBufferView.hpp"
+
+using namespace Lib::Network;
+
+void ByteBufferView::setByteOrder(const ByteOrder &newOrder)
+{
+    _order = newOrder;
+}
+
+const ByteBufferView::ByteOrder &ByteBufferView::getByteOrder() const
+{
+    return _order;
+}
+
+std::size_t ByteBufferView::position() const
+{
+    return _position;
+}
+
+void ByteBufferView::position(std::size_t newPos)
+{
+    _position = newPos;
+}
+
+std::size_t ByteBufferView::getBufferSize() const
+{
+    return _size;
+}
+
+std::size_t ByteBufferView::getRemainingSize() const
+{
+    return _size - _position;
+}
+
+bool ByteBufferView::isEmpty() const
+{
+    return _size == 0;
+}
+
+const unsigned char *ByteBufferView::prepareRead(const std::size_t _size, const char *_func)
+{
+    ByteBuffer::checkForOutOfBound(_position, _size, this->_size, _func);
+
+    const unsigned char *src = _data + _position;
+    position(_position + _size);
+    return src;
+}
+
+unsigned char ByteBufferView::get()
+{
+    return *prepareRead(ByteBuffer::BYTE_SIZE, "ByteBufferView::get");
+}
+
+unsigned short ByteBufferView::getShort()
+{
+    const unsigned char *src = prepareRead(ByteBuffer::SHORT_SIZE, "ByteBufferView::getShort");
+    return ByteSwap::load16(src, _order == ByteOrder::BigEndian);
+}
+
+unsigned int ByteBufferView::getInt()
+{
+    const unsigned char *src = prepareRead(ByteBuffer::INT_SIZE, "ByteBufferView::getInt");
+    return ByteSwap::load32(src, _order == ByteOrder::BigEndian);
+}
+
+uint64_t ByteBufferView::getLong()
+{
+    const unsigned char *src = prepareRead(ByteBuffer::LONG_SIZE, "ByteBufferView::getLong");
+    return ByteSwap::load64(src, _order == ByteOrder::BigEndian);
+}
+
+void ByteBufferView::getBuffer(unsigned char *_data, const int _start, const std::size_t _size)
+{
+    position(_start);
+    memcpy(_data, prepareRead(_size, "ByteBufferView::getBuffer"), _size);
+}
+
+void ByteBufferView::getBuffer(unsigned char *_data, const std::size_t _size)
+{
+    getBuffer(_data, _position, _size);
+}
+
+void ByteBufferView::getShorts(uint16_t *_data, const std::size_t _count)
+{
+    const unsigned char *src = prepareRead(_count * ByteBuffer::SHORT_SIZE, "ByteBufferView::getShorts");
+    ByteSwap::loadArray(_data, src, _count, _order == ByteOrder::BigEndian);
+}
+
+void ByteBufferView::getInts(uint32_t *_data, const std::size_t _count)
+{
+    const unsigned char *src = prepareRead(_count * ByteBuffer::INT_SIZE, "ByteBufferView::getInts");
+    ByteSwap::loadArray(_data, src, _count, _order == ByteOrder::BigEndian);
+}
+
+void ByteBufferView::getLongs(uint64_t *_data, const std::size_t _count)
+{
+    const unsigned char *src = prepareRead(_count * ByteBuffer::LONG_SIZE, "ByteBufferView::getLongs");
+    ByteSwap::loadArray(_data, src, _count, _order == ByteOrder::BigEndian);
+}
+
+const unsigned char *ByteBufferView::read(const std::size_t nofBytes)
+{
+    return prepareRead(nofBytes, "ByteBufferView::read");
+}
+
+const unsigned char *ByteBufferView::getData() const
+{
+    return _data;
+}
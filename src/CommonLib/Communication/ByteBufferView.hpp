@@ -0,0 +1,68 @@
+#ifndef _BYTEBUFFERVIEW_HPP
+#define _BYTEBUFFERVIEW_HPP
+
+#include <iostream>
+#include <cstring>
+#include <CommonLib/Communication/ByteBuffer.hpp>
+
+namespace Lib::Network
+{
+    /**
+     * A read-only, non-owning view over a sequence of bytes. It offers the
+     * same reading API of the ByteBuffer (get, getShort, getInt, getBuffer)
+     * with its own cursor, but it never copies the underlying bytes. The
+     * memory pointed by the view must outlive the view itself.
+     */
+    class ByteBufferView
+    {
+    public:
+        using ByteOrder = ByteBuffer::ByteOrder;
+
+        ByteBufferView(const unsigned char *data, const std::size_t nofBytes)
+            : _data(data), _size(nofBytes), _position(0), _order(ByteOrder::BigEndian) {};
+
+        ByteBufferView(const ByteBuffer &buffer)
+            : _data(buffer.getData()), _size(buffer.getBufferSize()),
+              _position(0), _order(buffer.getByteOrder()) {};
+
+        ~ByteBufferView() = default;
+
+        void setByteOrder(const ByteOrder &newOrder);
+        const ByteOrder &getByteOrder() const;
+
+        std::size_t position() const;
+        void position(std::size_t newPos);
+
+        std::size_t getBufferSize() const;
+        std::size_t getRemainingSize() const;
+        bool isEmpty() const;
+
+        unsigned char get();
+        unsigned short getShort();
+        unsigned int getInt();
+        uint64_t getLong();
+        void getBuffer(unsigned char *_data, const int _start, const std::size_t _size);
+        void getBuffer(unsigned char *_data, const std::size_t _size);
+
+        // Bulk versions, _count is the number of elements (not bytes)
+        void getShorts(uint16_t *_data, const std::size_t _count);
+        void getInts(uint32_t *_data, const std::size_t _count);
+        void getLongs(uint64_t *_data, const std::size_t _count);
+
+        // Returns the pointer to the next nofBytes bytes and moves the
+        // cursor after them. The bounds are checked only once.
+        const unsigned char *read(const std::size_t nofBytes);
+
+        const unsigned char *getData() const;
+
+    private:
+        const unsigned char *prepareRead(const std::size_t _size, const char *_func);
+
+        const unsigned char *_data; //!< The viewed bytes (not owned)
+        std::size_t _size;          //!< The number of viewed bytes
+        std::size_t _position;      //!< The current position into the view
+        ByteOrder _order;           //!< Either Big/Little-Endian
+    };
+}
+
+#endif
@@ -0,0 +1,184 @@
+#include "ByteSwap.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define BYTESWAP_X86 1
+#endif
+
+using namespace Lib::Network;
+
+namespace
+{
+    /**
+     * Shuffle masks for a 16 bytes block of elements of a given width.
+     * Output byte j of the block is the input byte mask[j] of the block.
+     */
+    struct Permutation
+    {
+        bool identity;              // The wire layout is the memory layout
+        unsigned char toWire[16];   // Memory -> wire mask
+        unsigned char fromWire[16]; // Wire -> memory mask
+    };
+
+    enum class Kernel
+    {
+        Scalar,
+        Ssse3,
+        Avx2
+    };
+
+    template <typename T>
+    Permutation buildPermutation(bool bigEndian)
+    {
+        const std::size_t width = sizeof(T);
+
+        // Encode an element whose bytes in memory are 0, 1, ..., width - 1,
+        // then the encoded bytes tell where each memory byte goes on the wire.
+        unsigned char bytes[width];
+        for (std::size_t idx = 0; idx < width; idx++) bytes[idx] = idx;
+
+        T value;
+        memcpy(&value, bytes, width);
+
+        unsigned char wire[width];
+        ByteSwap::store(wire, value, bigEndian);
+
+        unsigned char inverse[width];
+        for (std::size_t idx = 0; idx < width; idx++) inverse[wire[idx]] = idx;
+
+        Permutation perm;
+        perm.identity = true;
+        for (std::size_t idx = 0; idx < 16; idx++)
+        {
+            std::size_t lane = (idx / width) * width;
+            perm.toWire[idx] = lane + wire[idx % width];
+            perm.fromWire[idx] = lane + inverse[idx % width];
+            perm.identity = perm.identity && (perm.toWire[idx] == idx);
+        }
+
+        return perm;
+    }
+
+    template <typename T>
+    const Permutation &getPermutation(bool bigEndian)
+    {
+        static const Permutation be = buildPermutation<T>(true);
+        static const Permutation le = buildPermutation<T>(false);
+        return bigEndian ? be : le;
+    }
+
+    Kernel selectKernel()
+    {
+#ifdef BYTESWAP_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) return Kernel::Avx2;
+        if (__builtin_cpu_supports("ssse3")) return Kernel::Ssse3;
+#endif
+        return Kernel::Scalar;
+    }
+
+    void shuffleScalar(unsigned char *dst, const unsigned char *src,
+                       const std::size_t nofBytes, const unsigned char *mask)
+    {
+        // Masks never cross the element boundaries, hence also a partial
+        // block (made of whole elements) can be shuffled with the same mask.
+        for (std::size_t idx = 0; idx < nofBytes; idx++)
+        {
+            dst[idx] = src[(idx & ~static_cast<std::size_t>(15)) + mask[idx & 15]];
+        }
+    }
+
+#ifdef BYTESWAP_X86
+    __attribute__((target("ssse3")))
+    void shuffleSsse3(unsigned char *dst, const unsigned char *src,
+                      const std::size_t nofBytes, const unsigned char *mask)
+    {
+        const __m128i m = _mm_loadu_si128((const __m128i*)mask);
+        std::size_t idx = 0;
+
+        for (; idx + 16 <= nofBytes; idx += 16)
+        {
+            __m128i block = _mm_loadu_si128((const __m128i*)(src + idx));
+            _mm_storeu_si128((__m128i*)(dst + idx), _mm_shuffle_epi8(block, m));
+        }
+
+        shuffleScalar(dst + idx, src + idx, nofBytes - idx, mask);
+    }
+
+    __attribute__((target("avx2")))
+    void shuffleAvx2(unsigned char *dst, const unsigned char *src,
+                     const std::size_t nofBytes, const unsigned char *mask)
+    {
+        // The AVX2 shuffle works on the two 128 bits lanes independently,
+        // so the same 16 bytes mask is replicated on both of them.
+        const __m256i m = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)mask));
+        std::size_t idx = 0;
+
+        for (; idx + 32 <= nofBytes; idx += 32)
+        {
+            __m256i block = _mm256_loadu_si256((const __m256i*)(src + idx));
+            _mm256_storeu_si256((__m256i*)(dst + idx), _mm256_shuffle_epi8(block, m));
+        }
+
+        shuffleSsse3(dst + idx, src + idx, nofBytes - idx, mask);
+    }
+#endif
+
+    void shuffle(unsigned char *dst, const unsigned char *src, const std::size_t nofBytes,
+                 const Permutation &perm, bool toWire)
+    {
+        if (perm.identity)
+        {
+            memcpy(dst, src, nofBytes);
+            return;
+        }
+
+        static const Kernel kernel = selectKernel();
+        const unsigned char *mask = toWire ? perm.toWire : perm.fromWire;
+
+        switch (kernel)
+        {
+#ifdef BYTESWAP_X86
+        case Kernel::Avx2:
+            shuffleAvx2(dst, src, nofBytes, mask);
+            break;
+        case Kernel::Ssse3:
+            shuffleSsse3(dst, src, nofBytes, mask);
+            break;
+#endif
+        default:
+            shuffleScalar(dst, src, nofBytes, mask);
+            break;
+        }
+    }
+}
+
+void ByteSwap::storeArray(unsigned char *dst, const uint16_t *src, const std::size_t count, bool bigEndian)
+{
+    shuffle(dst, (const unsigned char*)src, count * sizeof(uint16_t), getPermutation<uint16_t>(bigEndian), true);
+}
+
+void ByteSwap::storeArray(unsigned char *dst, const uint32_t *src, const std::size_t count, bool bigEndian)
+{
+    shuffle(dst, (const unsigned char*)src, count * sizeof(uint32_t), getPermutation<uint32_t>(bigEndian), true);
+}
+
+void ByteSwap::storeArray(unsigned char *dst, const uint64_t *src, const std::size_t count, bool bigEndian)
+{
+    shuffle(dst, (const unsigned char*)src, count * sizeof(uint64_t), getPermutation<uint64_t>(bigEndian), true);
+}
+
+void ByteSwap::loadArray(uint16_t *dst, const unsigned char *src, const std::size_t count, bool bigEndian)
+{
+    shuffle((unsigned char*)dst, src, count * sizeof(uint16_t), getPermutation<uint16_t>(bigEndian), false);
+}
+
+void ByteSwap::loadArray(uint32_t *dst, const unsigned char *src, const std::size_t count, bool bigEndian)
+{
+    shuffle((unsigned char*)dst, src, count * sizeof(uint32_t), getPermutation<uint32_t>(bigEndian), false);
+}
+
+void ByteSwap::loadArray(uint64_t *dst, const unsigned char *src, const std::size_t count, bool bigEndian)
+{
+    shuffle((unsigned char*)dst, src, count * sizeof(uint64_t), getPermutation<uint64_t>(bigEndian), false);
+}
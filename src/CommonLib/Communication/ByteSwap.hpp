@@ -0,0 +1,71 @@
+#ifndef _BYTESWAP_HPP
+#define _BYTESWAP_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <endian.h>
+
+namespace Lib::Network::ByteSwap
+{
+    /**
+     * Scalar encoders and decoders of the values written into a ByteBuffer.
+     * The short is the base unit: wider values are split into their upper
+     * and lower halves, each one encoded with the narrower function. This
+     * is exactly the layout that ByteBuffer has always put on the wire, so
+     * the encoding of every message stays the same.
+     */
+    inline void store(unsigned char *dst, uint16_t value, bool bigEndian)
+    {
+        if (bigEndian) value = htobe16(value);
+        dst[0] = value >> 8;
+        dst[1] = value & 0xFF;
+    }
+
+    inline void store(unsigned char *dst, uint32_t value, bool bigEndian)
+    {
+        if (bigEndian) value = htobe32(value);
+        store(dst, static_cast<uint16_t>(value >> 16), bigEndian);
+        store(dst + 2, static_cast<uint16_t>(value & 0xFFFF), bigEndian);
+    }
+
+    inline void store(unsigned char *dst, uint64_t value, bool bigEndian)
+    {
+        if (bigEndian) value = htobe64(value);
+        store(dst, static_cast<uint32_t>(value >> 32), bigEndian);
+        store(dst + 4, static_cast<uint32_t>(value & 0xFFFFFFFF), bigEndian);
+    }
+
+    inline uint16_t load16(const unsigned char *src, bool bigEndian)
+    {
+        uint16_t value = (src[0] << 8) + src[1];
+        return bigEndian ? be16toh(value) : value;
+    }
+
+    inline uint32_t load32(const unsigned char *src, bool bigEndian)
+    {
+        uint32_t value = (static_cast<uint32_t>(load16(src, bigEndian)) << 16) + load16(src + 2, bigEndian);
+        return bigEndian ? be32toh(value) : value;
+    }
+
+    inline uint64_t load64(const unsigned char *src, bool bigEndian)
+    {
+        uint64_t value = (static_cast<uint64_t>(load32(src, bigEndian)) << 32) + load32(src + 4, bigEndian);
+        return bigEndian ? be64toh(value) : value;
+    }
+
+    /**
+     * Bulk versions of the encoders above. For each width and byte order
+     * the wire layout is a fixed permutation of the bytes of every element,
+     * that is applied with SSSE3/AVX2 byte shuffles when the CPU supports
+     * them (checked once at runtime), and with a scalar loop otherwise.
+     */
+    void storeArray(unsigned char *dst, const uint16_t *src, const std::size_t count, bool bigEndian);
+    void storeArray(unsigned char *dst, const uint32_t *src, const std::size_t count, bool bigEndian);
+    void storeArray(unsigned char *dst, const uint64_t *src, const std::size_t count, bool bigEndian);
+
+    void loadArray(uint16_t *dst, const unsigned char *src, const std::size_t count, bool bigEndian);
+    void loadArray(uint32_t *dst, const unsigned char *src, const std::size_t count, bool bigEndian);
+    void loadArray(uint64_t *dst, const unsigned char *src, const std::size_t count, bool bigEndian);
+}
+
+#endif
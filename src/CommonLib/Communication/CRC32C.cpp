@@ -0,0 +1,110 @@
+#include "CRC32C.hpp"
+
+#if defined(__x86_64__)
+#include <nmmintrin.h>
+#endif
+
+using namespace Lib::Network;
+
+namespace
+{
+    const uint32_t POLYNOMIAL = 0x82F63B78; // Reversed Castagnoli polynomial
+
+    // table[k][b] is the CRC of byte b followed by k zero bytes
+    struct SlicingTables
+    {
+        uint32_t table[8][256];
+
+        SlicingTables()
+        {
+            for (uint32_t byte = 0; byte < 256; byte++)
+            {
+                uint32_t crc = byte;
+                for (int bit = 0; bit < 8; bit++) crc = (crc >> 1) ^ (POLYNOMIAL & (0 - (crc & 1)));
+                table[0][byte] = crc;
+            }
+
+            for (uint32_t byte = 0; byte < 256; byte++)
+                for (int k = 1; k < 8; k++)
+                    table[k][byte] = (table[k - 1][byte] >> 8) ^ table[0][table[k - 1][byte] & 0xFF];
+        }
+    };
+
+    const SlicingTables TABLES;
+
+    uint32_t updateSoftware(uint32_t crc, const unsigned char *data, std::size_t nofBytes)
+    {
+        const uint32_t (*t)[256] = TABLES.table;
+
+        for (; nofBytes >= 8; nofBytes -= 8, data += 8)
+        {
+            uint32_t low, high;
+            memcpy(&low, data, 4);
+            memcpy(&high, data + 4, 4);
+            low ^= crc;
+
+            crc = t[7][low & 0xFF] ^ t[6][(low >> 8) & 0xFF] ^ t[5][(low >> 16) & 0xFF] ^ t[4][low >> 24] ^
+                  t[3][high & 0xFF] ^ t[2][(high >> 8) & 0xFF] ^ t[1][(high >> 16) & 0xFF] ^ t[0][high >> 24];
+        }
+
+        for (; nofBytes > 0; nofBytes--) crc = (crc >> 8) ^ t[0][(crc ^ *data++) & 0xFF];
+        return crc;
+    }
+
+#if defined(__x86_64__)
+    __attribute__((target("sse4.2")))
+    uint32_t updateHardware(uint32_t crc, const unsigned char *data, std::size_t nofBytes)
+    {
+        uint64_t crc64 = crc;
+        for (; nofBytes >= 8; nofBytes -= 8, data += 8)
+        {
+            uint64_t word;
+            memcpy(&word, data, 8);
+            crc64 = _mm_crc32_u64(crc64, word);
+        }
+
+        crc = static_cast<uint32_t>(crc64);
+        for (; nofBytes > 0; nofBytes--) crc = _mm_crc32_u8(crc, *data++);
+        return crc;
+    }
+
+    bool hasSse42()
+    {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("sse4.2");
+    }
+#else
+    uint32_t updateHardware(uint32_t crc, const unsigned char *data, std::size_t nofBytes)
+    {
+        return updateSoftware(crc, data, nofBytes);
+    }
+
+    bool hasSse42()
+    {
+        return false;
+    }
+#endif
+
+    const bool HARDWARE = hasSse42();
+}
+
+uint32_t CRC32C::compute(const unsigned char *data, const std::size_t nofBytes)
+{
+    return extend(0, data, nofBytes);
+}
+
+uint32_t CRC32C::extend(const uint32_t crc, const unsigned char *data, const std::size_t nofBytes)
+{
+    if (HARDWARE) return ~updateHardware(~crc, data, nofBytes);
+    return ~updateSoftware(~crc, data, nofBytes);
+}
+
+uint32_t CRC32C::extendSoftware(const uint32_t crc, const unsigned char *data, const std::size_t nofBytes)
+{
+    return ~updateSoftware(~crc, data, nofBytes);
+}
+
+bool CRC32C::isHardwareAccelerated()
+{
+    return HARDWARE;
+}
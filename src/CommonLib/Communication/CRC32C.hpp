@@ -0,0 +1,32 @@
+#ifndef _CRC32C_HPP
+#define _CRC32C_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+namespace Lib::Network
+{
+    /**
+     * The CRC32C (Castagnoli) checksum. On CPUs with SSE4.2 it uses the crc32
+     * instruction, otherwise a slicing-by-8 table implementation. The choice
+     * is made once, at runtime, so the same binary runs on any x86-64 CPU.
+     */
+    class CRC32C
+    {
+    public:
+        // The checksum of nofBytes of data
+        static uint32_t compute(const unsigned char *data, const std::size_t nofBytes);
+
+        // Continues the checksum crc (as returned by compute) with more bytes
+        static uint32_t extend(const uint32_t crc, const unsigned char *data, const std::size_t nofBytes);
+
+        // The table implementation, also used when SSE4.2 is not available
+        static uint32_t extendSoftware(const uint32_t crc, const unsigned char *data, const std::size_t nofBytes);
+
+        // True if the checksum is computed with the crc32 instruction
+        static bool isHardwareAccelerated();
+    };
+}
+
+#endif
@@ -0,0 +1,161 @@
+#include "Compression.hpp"
+
+using namespace Lib::Network;
+
+namespace
+{
+    uint32_t read32(const unsigned char *src)
+    {
+        uint32_t value;
+        memcpy(&value, src, sizeof(value));
+        return value;
+    }
+
+    uint32_t hash(const uint32_t sequence)
+    {
+        return (sequence * 2654435761u) >> (32 - LZCompressor::HASH_LOG);
+    }
+
+    // Writes the part of a length that does not fit its nibble
+    unsigned char *writeLength(unsigned char *op, std::size_t length)
+    {
+        for (; length >= 255; length -= 255) *op++ = 255;
+        *op++ = static_cast<unsigned char>(length);
+        return op;
+    }
+
+    // Reads the part of a length that does not fit its nibble
+    bool readLength(const unsigned char *&ip, const unsigned char *end, std::size_t &length)
+    {
+        unsigned char byte;
+        do
+        {
+            if (ip >= end) return false;
+            byte = *ip++;
+            length += byte;
+        } while (byte == 255);
+
+        return true;
+    }
+
+    std::size_t extraLengthBytes(const std::size_t length)
+    {
+        return length >= 15 ? (length - 15) / 255 + 1 : 0;
+    }
+}
+
+std::size_t LZCompressor::getMaxCompressedSize(const std::size_t nofBytes)
+{
+    return nofBytes + nofBytes / 255 + 16;
+}
+
+std::size_t LZCompressor::compress(const unsigned char *src, const std::size_t nofBytes,
+                                   unsigned char *dst, const std::size_t capacity)
+{
+    uint32_t table[1 << HASH_LOG];
+    memset(table, 0, sizeof(table));
+
+    unsigned char *op = dst;
+    unsigned char *const opEnd = dst + capacity;
+    std::size_t anchor = 0; // First byte not yet emitted
+    std::size_t ip = 1;     // Position 0 can only be a literal
+
+    // A match must leave room for the last literals after it
+    std::size_t limit = nofBytes > MIN_MATCH + LAST_LITERALS ? nofBytes - MIN_MATCH - LAST_LITERALS : 0;
+    std::size_t attempts = 0;
+
+    while (ip < limit)
+    {
+        uint32_t sequence = read32(src + ip);
+        uint32_t &slot = table[hash(sequence)];
+        std::size_t ref = slot;
+        slot = static_cast<uint32_t>(ip);
+
+        if (ip - ref > MAX_OFFSET || read32(src + ref) != sequence)
+        {
+            // The longer no match is found, the faster the input is skipped
+            ip += 1 + (attempts++ >> 6);
+            continue;
+        }
+
+        attempts = 0;
+        std::size_t matchLength = MIN_MATCH;
+        while (ip + matchLength < nofBytes - LAST_LITERALS && src[ref + matchLength] == src[ip + matchLength])
+            matchLength++;
+
+        std::size_t literals = ip - anchor;
+        std::size_t needed = 1 + extraLengthBytes(literals) + literals + 2 + extraLengthBytes(matchLength - MIN_MATCH);
+        if (needed > static_cast<std::size_t>(opEnd - op)) return 0;
+
+        unsigned char *token = op++;
+        *token = static_cast<unsigned char>(std::min<std::size_t>(literals, 15) << 4);
+        if (literals >= 15) op = writeLength(op, literals - 15);
+        memcpy(op, src + anchor, literals);
+        op += literals;
+
+        std::size_t offset = ip - ref;
+        *op++ = offset & 0xFF;
+        *op++ = offset >> 8;
+
+        *token |= static_cast<unsigned char>(std::min<std::size_t>(matchLength - MIN_MATCH, 15));
+        if (matchLength - MIN_MATCH >= 15) op = writeLength(op, matchLength - MIN_MATCH - 15);
+
+        ip += matchLength;
+        anchor = ip;
+    }
+
+    // The last sequence has only literals
+    std::size_t literals = nofBytes - anchor;
+    if (1 + extraLengthBytes(literals) + literals > static_cast<std::size_t>(opEnd - op)) return 0;
+
+    *op++ = static_cast<unsigned char>(std::min<std::size_t>(literals, 15) << 4);
+    if (literals >= 15) op = writeLength(op, literals - 15);
+    memcpy(op, src + anchor, literals);
+    op += literals;
+
+    return op - dst;
+}
+
+bool LZCompressor::decompress(const unsigned char *src, const std::size_t size,
+                              unsigned char *dst, const std::size_t nofBytes)
+{
+    const unsigned char *ip = src;
+    const unsigned char *const ipEnd = src + size;
+    unsigned char *op = dst;
+    unsigned char *const opEnd = dst + nofBytes;
+
+    while (ip < ipEnd)
+    {
+        unsigned char token = *ip++;
+
+        std::size_t literals = token >> 4;
+        if (literals == 15 && !readLength(ip, ipEnd, literals)) return false;
+        if (literals > static_cast<std::size_t>(ipEnd - ip)) return false;
+        if (literals > static_cast<std::size_t>(opEnd - op)) return false;
+
+        memcpy(op, ip, literals);
+        ip += literals;
+        op += literals;
+
+        // The last sequence ends right after its literals
+        if (ip == ipEnd) break;
+
+        if (ipEnd - ip < 2) return false;
+        std::size_t offset = ip[0] | (ip[1] << 8);
+        ip += 2;
+        if (offset == 0 || offset > static_cast<std::size_t>(op - dst)) return false;
+
+        std::size_t matchLength = token & 0x0F;
+        if (matchLength == 15 && !readLength(ip, ipEnd, matchLength)) return false;
+        matchLength += MIN_MATCH;
+        if (matchLength > static_cast<std::size_t>(opEnd - op)) return false;
+
+        // The match can overlap the bytes it is producing (e.g., runs)
+        const unsigned char *match = op - offset;
+        if (offset >= matchLength) memcpy(op, match, matchLength);
+        else for (std::size_t idx = 0; idx < matchLength; idx++) op[idx] = match[idx];
+        op += matchLength;
+    }
+
+    return op == opEnd;
+}
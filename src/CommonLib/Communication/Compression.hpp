@@ -0,0 +1,41 @@
+#ifndef _COMPRESSION_HPP
+#define _COMPRESSION_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <cstddef>
+#include <algorithm>
+
+namespace Lib::Network
+{
+    /**
+     * A fast LZ77 block compressor, with the same sequence format of LZ4:
+     * each sequence is a token (literal length and match length nibbles),
+     * the literals, a 2-byte offset and the extra bytes of the lengths. It
+     * trades compression ratio for speed, and the decompressor checks every
+     * bound, so that a corrupted block is rejected instead of overflowing.
+     */
+    class LZCompressor
+    {
+    public:
+        const static std::size_t MIN_MATCH = 4;       // Shortest match that is encoded
+        const static std::size_t MAX_OFFSET = 65535;  // Farthest match that can be referred
+        const static std::size_t LAST_LITERALS = 5;   // Bytes at the end always sent as literals
+        const static std::size_t HASH_LOG = 12;       // Log2 of the size of the match table
+
+        // The size of the output in the worst case, i.e. incompressible input
+        static std::size_t getMaxCompressedSize(const std::size_t nofBytes);
+
+        // Compresses nofBytes of src into dst. Returns the compressed size, or
+        // 0 if it would be larger than capacity (e.g. the input does not shrink).
+        static std::size_t compress(const unsigned char *src, const std::size_t nofBytes,
+                                    unsigned char *dst, const std::size_t capacity);
+
+        // Decompresses the block into dst, that must be exactly nofBytes long.
+        // Returns false if the block is corrupted or has a different size.
+        static bool decompress(const unsigned char *src, const std::size_t size,
+                               unsigned char *dst, const std::size_t nofBytes);
+    };
+}
+
+#endif
@@ -14,12 +14,74 @@ void CommunicationInterface::sendTo(const std::string &ip, unsigned short port,
     bool result = _sender->sendTo(ip, port, msg);
 }
 
+void CommunicationInterface::sendTo(const std::string &ip, unsigned short port, const std::shared_ptr<Message> &msg)
+{
+    _sender->sendTo(ip, port, msg);
+}
+
+void CommunicationInterface::enableCompression(const std::size_t nofBytes)
+{
+    _sender->setCompressionThreshold(nofBytes);
+}
+
+void CommunicationInterface::enableChecksum(const bool enabled)
+{
+    _sender->setChecksumEnabled(enabled);
+}
+
+bool CommunicationInterface::isChecksumEnabled() const
+{
+    return _sender->isChecksumEnabled();
+}
+
+void CommunicationInterface::enableZeroCopy(const std::size_t nofBytes)
+{
+    _sender->setZeroCopyThreshold(nofBytes);
+}
+
+void CommunicationInterface::enableBatching(const std::size_t maxBatchSize, const long int maxDelay_us)
+{
+    if (_batcher != nullptr) return;
+
+    _batcher = std::make_shared<BatchingSender>(_sender, maxBatchSize, maxDelay_us);
+    _batcher->start();
+}
+
+void CommunicationInterface::sendBatchedTo(const std::string &ip, unsigned short port, Message &msg)
+{
+    if (_batcher == nullptr)
+    {
+        sendTo(ip, port, msg);
+        return;
+    }
+
+    _batcher->sendTo(ip, port, msg);
+}
+
+void CommunicationInterface::stopBatching()
+{
+    if (_batcher == nullptr) return;
+
+    _batcher->stop();
+    _batcher = nullptr;
+}
+
 ReceivedData CommunicationInterface::getReceivedElement()
 {
     // Pop an element from the receiver queue (no priority involved)
     return _queue->pop();
 }
 
+bool CommunicationInterface::tryGetReceivedElement(ReceivedData &data)
+{
+    return _queue->tryPop(data);
+}
+
+void CommunicationInterface::setEventLoop(const Concurrency::EventLoop_ptr &loop)
+{
+    _queue->setEventLoop(loop);
+}
+
 void CommunicationInterface::start()
 {
     _listener->start();
@@ -45,39 +107,239 @@ void CommunicationInterface::performDiagnosticCheck()
     this->zeroDiagnosticCheck();
 
     // Fill up the Listener fields
-    this->_check.listener_exitOnError = this->_listener->hasStoppedWithErrors();
-    this->_check.listener_isRunning = this->_listener->isRunning();
-    this->_check.listener_sockError = this->_listener->getSocketError();
+    this->checkListener(*this->_listener);
 
     // Fill the Sender fields
     this->_check.sender_sockError = this->_sender->getSocket().getSocketInfo()->error;
 }
 
+void CommunicationInterface::checkListener(Listener &listener)
+{
+    bool failed = listener.hasStoppedWithErrors();
+    int error = listener.getSocketError();
+
+    // The error reported is the one of the first listener stopped on error
+    if (!this->_check.listener_exitOnError && (failed || this->_check.listener_sockError == 0))
+        this->_check.listener_sockError = error;
+
+    this->_check.listener_exitOnError = this->_check.listener_exitOnError || failed;
+    this->_check.listener_isRunning = this->_check.listener_isRunning && listener.isRunning();
+}
+
 DiagnosticCheckResult *CommunicationInterface::getDiagnosticResult()
 {
     return &this->_check;
 }
 
 UdpCommunicationInterface::UdpCommunicationInterface(
-    const std::string &ip, unsigned short sport, unsigned short lport, const std::size_t capacity
-) : CommunicationInterface(capacity)
+    const std::string &ip, unsigned short sport, unsigned short lport, const std::size_t capacity,
+    const std::size_t batchSize, const bool ioUring, const std::size_t nofShards
+) : CommunicationInterface(capacity), _ioUring(false), _batchSize(batchSize), _nextShard(0)
 {
-    _sender = std::make_shared<UdpSender>(ip, sport);
-    _listener = std::make_shared<UdpListener>(ip, lport, _queue); // The receiver queue is the same
+    std::shared_ptr<UdpSender> sender = std::make_shared<UdpSender>(ip, sport);
+    sender->setBatchSize(batchSize);
+    _sender = sender;
+
+    // A single listener does not need to share its port
+    bool reusePort = nofShards > 1;
+    for (std::size_t shard = 0; shard < std::max<std::size_t>(nofShards, 1); shard++)
+    {
+        Concurrency::Queue_ptr<ReceivedData> queue = _queue;
+        if (shard > 0) queue = std::make_shared<Concurrency::Queue<ReceivedData>>(capacity);
+
+        _shardQueues.push_back(queue);
+        _shards.push_back(makeListener(ip, lport, queue, batchSize, ioUring, reusePort));
+
+        // With port 0 the other shards join the one chosen for the first
+        lport = _shards.front()->getSocket().getPortNumber();
+    }
+
+    _listener = _shards.front();
+}
+
+std::shared_ptr<Listener> UdpCommunicationInterface::makeListener(
+    const std::string &ip, unsigned short lport, const Concurrency::Queue_ptr<ReceivedData> &queue,
+    const std::size_t batchSize, const bool ioUring, const bool reusePort
+) {
+    if (ioUring && IoUring::isSupported())
+    {
+        try
+        {
+            std::shared_ptr<Listener> listener = std::make_shared<UringUdpListener>(ip, lport, queue, reusePort);
+            _ioUring = true;
+            return listener;
+        }
+        catch (const std::runtime_error &error)
+        {
+            std::cerr << error.what() << ", falling back to poll" << std::endl;
+        }
+    }
+
+    return std::make_shared<UdpListener>(ip, lport, queue, batchSize, reusePort);
+}
+
+bool UdpCommunicationInterface::enableLocalTransport()
+{
+    if (_local != nullptr) return true;
+
+    const Socket &socket = _listener->getSocket();
+    try
+    {
+        // Local datagrams go into the queue of the first shard
+        _local = std::make_shared<LocalListener>(socket.getIpAddress(), socket.getPortNumber(), _queue, _batchSize);
+        std::static_pointer_cast<UdpSender>(_sender)->setLocalTransport(true);
+        return true;
+    }
+    catch (const std::runtime_error &error)
+    {
+        std::cerr << error.what() << ", local peers go through IP" << std::endl;
+        _local = nullptr;
+        return false;
+    }
+}
+
+bool UdpCommunicationInterface::isUsingLocalTransport() const
+{
+    return _local != nullptr;
+}
+
+bool UdpCommunicationInterface::enableDiscoveryListener(const unsigned short port, const std::string &group)
+{
+    if (_discovery != nullptr) return true;
+
+    // Broadcast and multicast datagrams only reach sockets bound to the wildcard
+    std::string ip = _listener->getSocket().getIpAddress();
+    try
+    {
+        std::shared_ptr<UdpListener> listener = std::make_shared<UdpListener>(
+            "0.0.0.0", port, _queue, _batchSize, true);
+
+        if (!group.empty() && !listener->getSocket().joinMulticastGroup(group, ip))
+        {
+            std::cerr << "[UdpCommunicationInterface] Failed to join the multicast group ";
+            std::cerr << group << ": " << std::strerror(errno) << std::endl;
+            return false;
+        }
+
+        _discovery = listener;
+        return true;
+    }
+    catch (const std::runtime_error &error)
+    {
+        std::cerr << error.what() << ", discovery hellos are not received" << std::endl;
+        return false;
+    }
+}
+
+bool UdpCommunicationInterface::isUsingDiscoveryListener() const
+{
+    return _discovery != nullptr;
+}
+
+bool UdpCommunicationInterface::enableDiscoverySender()
+{
+    return std::static_pointer_cast<UdpSender>(_sender)->getSocket().enableBroadcast();
+}
+
+std::size_t UdpCommunicationInterface::sendBatch(const struct Datagram *datagrams, const std::size_t count)
+{
+    return std::static_pointer_cast<UdpSender>(_sender)->sendBatch(datagrams, count);
+}
+
+bool UdpCommunicationInterface::isUsingIoUring() const
+{
+    return _ioUring;
+}
+
+std::size_t UdpCommunicationInterface::getNofShards() const
+{
+    return _shards.size();
+}
+
+void UdpCommunicationInterface::start()
+{
+    for (auto &shard : _shards) shard->start();
+    if (_local != nullptr) _local->start();
+    if (_discovery != nullptr) _discovery->start();
+}
+
+ReceivedData UdpCommunicationInterface::getReceivedElement()
+{
+    if (_shards.size() == 1) return _queue->pop();
+
+    // The shards are drained in turn, starting from the one after the
+    // last drained, so that a busy shard does not starve the others.
+    ReceivedData data;
+    for (std::size_t round = 0; round * UDP_SHARD_WAIT_MS < 250; round++)
+    {
+        for (std::size_t idx = 0; idx < _shardQueues.size(); idx++)
+        {
+            std::size_t shard = (_nextShard + idx) % _shardQueues.size();
+            if (!_shardQueues[shard]->tryPop(data)) continue;
+
+            _nextShard = (shard + 1) % _shardQueues.size();
+            return data;
+        }
+
+        // All empty, the next shard is waited for a while
+        std::size_t shard = _nextShard;
+        _nextShard = (shard + 1) % _shardQueues.size();
+        if (_shardQueues[shard]->tryPop(data, UDP_SHARD_WAIT_MS)) return data;
+    }
+
+    throw std::runtime_error("Event: timeout");
+}
+
+bool UdpCommunicationInterface::tryGetReceivedElement(ReceivedData &data)
+{
+    // Starting from the shard after the last drained, as getReceivedElement does
+    for (std::size_t idx = 0; idx < _shardQueues.size(); idx++)
+    {
+        std::size_t shard = (_nextShard + idx) % _shardQueues.size();
+        if (!_shardQueues[shard]->tryPop(data)) continue;
+
+        _nextShard = (shard + 1) % _shardQueues.size();
+        return true;
+    }
+
+    return false;
+}
+
+void UdpCommunicationInterface::setEventLoop(const Concurrency::EventLoop_ptr &loop)
+{
+    for (auto &queue : _shardQueues) queue->setEventLoop(loop);
+}
+
+void UdpCommunicationInterface::performDiagnosticCheck()
+{
+    CommunicationInterface::performDiagnosticCheck();
+
+    // The first shard is the _listener already checked. Any other
+    // listener stopped loses its share of the datagrams.
+    for (std::size_t shard = 1; shard < _shards.size(); shard++) this->checkListener(*_shards[shard]);
+    if (_local != nullptr) this->checkListener(*_local);
+    if (_discovery != nullptr) this->checkListener(*_discovery);
 }
 
 void UdpCommunicationInterface::close()
 {
-    // Stop the listener
-    this->_listener->stop();
+    // Pending batches must leave before the sender is closed
+    this->stopBatching();
+
+    // Stop the listeners
+    for (auto &shard : _shards) shard->stop();
+    if (_local != nullptr) _local->stop();
+    if (_discovery != nullptr) _discovery->stop();
 
     // First close the sender socket
     if (!this->_sender->isSocketClosed()) this->_sender->closeSocket();
 
-    // Then, close the receiver socket. Listeners, being
+    // Then, close the receiver sockets. Listeners, being
     // thread first needs to be stopped and then to be joined.
     // All listener threads are joinable, no check is needed
-    this->_listener->join();
+    for (auto &shard : _shards) shard->join();
+    if (_local != nullptr) _local->join();
+    if (_discovery != nullptr) _discovery->join();
 }
 
 void CommunicationInterface::zeroDiagnosticCheck()
@@ -104,6 +366,9 @@ TcpCommunicationInterface::TcpCommunicationInterface(
 
 void TcpCommunicationInterface::close()
 {
+    // Pending batches must leave before the sender is closed
+    this->stopBatching();
+
     // First close the sender socket
     if (!this->_sender->isSocketClosed()) this->_sender->closeSocket();
 
@@ -120,3 +385,29 @@ void TcpCommunicationInterface::disconnect()
 {
     std::static_pointer_cast<TcpSender>(_sender)->disconnect();
 }
+
+SharedMemoryCommunicationInterface::SharedMemoryCommunicationInterface(
+    const std::string &ip, unsigned short port, const std::size_t capacity, const std::size_t ringSize
+) : CommunicationInterface(capacity)
+{
+    _channels = std::make_shared<SharedChannels>(ip, port, ringSize);
+    _sender = std::make_shared<SharedMemorySender>(_channels);
+    _listener = std::make_shared<SharedMemoryListener>(_channels, _queue);
+}
+
+void SharedMemoryCommunicationInterface::close()
+{
+    // Pending batches must leave before the sender is closed
+    this->stopBatching();
+
+    // No more rings are set up once the socket is closed
+    if (!this->_sender->isSocketClosed()) this->_sender->closeSocket();
+
+    this->_listener->stop();
+    this->_listener->join();
+}
+
+std::size_t SharedMemoryCommunicationInterface::getNofChannels() const
+{
+    return _channels->getNofChannels();
+}
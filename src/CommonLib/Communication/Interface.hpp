@@ -5,6 +5,7 @@
 #include <CommonLib/Communication/Message.hpp>
 #include <CommonLib/Communication/Listener.hpp>
 #include <CommonLib/Communication/Sender.hpp>
+#include <CommonLib/Communication/BatchingSender.hpp>
 
 #undef UDP_LISTENER_RUNNING
 #undef TCP_LISTENER_RUNNING
@@ -15,6 +16,9 @@
 #define UDP_SENDER_ERROR 30
 #define TCP_SENDER_ERROR 40
 
+#define UDP_LISTENER_SHARDS 1 // Default number of UDP listeners sharing the port
+#define UDP_SHARD_WAIT_MS 10  // How long each shard queue is waited for, in turn
+
 namespace Lib::Network
 {
     /**
@@ -34,12 +38,15 @@ namespace Lib::Network
     protected:
         std::shared_ptr<Sender> _sender;     // A pointer to a sender obeject
         std::shared_ptr<Listener> _listener; // A pointer to a listener object
+        BatchingSender_ptr _batcher;         // Batches the messages, if enabled
         struct DiagnosticCheckResult _check; // Diagnostic check result structure
 
         // A pointer to the shared queue between sender and receiver
         Concurrency::Queue_ptr<ReceivedData> _queue;
 
         void zeroDiagnosticCheck();
+        void checkListener(Listener &listener); // Adds the state of the listener to the check
+        void stopBatching(); // Sends the pending batches and stops batching
 
     public:
         CommunicationInterface(const std::size_t capacity)
@@ -56,11 +63,43 @@ namespace Lib::Network
         // Sends a single message to the destination address and port
         void sendTo(const std::string &ip, unsigned short port, Message &msg);
 
+        // Sends a message shared with the sender, so that it can go with zero-copy
+        void sendTo(const std::string &ip, unsigned short port, const std::shared_ptr<Message> &msg);
+
+        // Packs the messages to the same destination into batches, that are sent
+        // when maxBatchSize bytes or maxDelay_us microseconds have been reached.
+        // Once enabled, all the messages must be sent through sendBatchedTo.
+        void enableBatching(const std::size_t maxBatchSize, const long int maxDelay_us);
+
+        // Compresses the body of the messages larger than nofBytes, when it
+        // makes them smaller. A threshold of 0 disables the compression.
+        void enableCompression(const std::size_t nofBytes);
+
+        // Appends a CRC32C to each sent message, so that the receiver can
+        // drop the corrupted ones. Received checksums are always verified.
+        void enableChecksum(const bool enabled);
+        bool isChecksumEnabled() const;
+
+        // Sends the shared messages larger than nofBytes with MSG_ZEROCOPY, the
+        // sender keeping them until the kernel releases them. A threshold of 0
+        // disables it.
+        void enableZeroCopy(const std::size_t nofBytes);
+
+        // Sends the message into a batch, or as it is if batching is disabled
+        void sendBatchedTo(const std::string &ip, unsigned short port, Message &msg);
+
         // Get a single message from the receiving queue
-        struct ReceivedData getReceivedElement();
+        virtual struct ReceivedData getReceivedElement();
+
+        // Takes a message without waiting, returns false if there is none
+        virtual bool tryGetReceivedElement(struct ReceivedData &data);
+
+        // Notifies the loop of each received message, so that the messages
+        // can be taken with tryGetReceivedElement once the loop wakes up
+        virtual void setEventLoop(const Concurrency::EventLoop_ptr &loop);
 
         // Start the communication interface, which means starting the listener
-        void start();
+        virtual void start();
 
         // Stop the sender socket
         void senderStop();
@@ -72,16 +111,43 @@ namespace Lib::Network
         unsigned short getListenerPort() const;
 
         // Performs diagnostic check on the socket of listener and sender
-        void performDiagnosticCheck();
+        virtual void performDiagnosticCheck();
 
         struct DiagnosticCheckResult *getDiagnosticResult();
     };
 
     class UdpCommunicationInterface : public CommunicationInterface
     {
+    private:
+        bool _ioUring;                        // If the listener receives through io_uring
+        std::size_t _batchSize;               // Maximum number of datagrams received with a single syscall
+        std::shared_ptr<Listener> _local;     // Receives from the peers on the same host, if enabled
+        std::shared_ptr<Listener> _discovery; // Receives the broadcast or multicast hellos, if enabled
+
+        // With more shards, each listener has its own socket and queue,
+        // the first of them being _listener and _queue.
+        std::vector<std::shared_ptr<Listener>> _shards;
+        std::vector<Concurrency::Queue_ptr<ReceivedData>> _shardQueues;
+        std::size_t _nextShard; // The shard queue drained first by the next get
+
+        std::shared_ptr<Listener> makeListener(const std::string &ip, unsigned short lport,
+                                               const Concurrency::Queue_ptr<ReceivedData> &queue,
+                                               const std::size_t batchSize, const bool ioUring,
+                                               const bool reusePort);
+
     public:
+        /**
+         * With ioUring the datagrams are received through io_uring, or with
+         * the poll and recvmmsg listener if the kernel does not support it.
+         * With more than one shard, nofShards listeners bind the listening
+         * port with SO_REUSEPORT, each on its own thread and with its own
+         * queue of the given capacity. Their queues are drained in turn.
+         */
         UdpCommunicationInterface(const std::string &ip, unsigned short sport,
-                                  unsigned short lport, const std::size_t capacity);
+                                  unsigned short lport, const std::size_t capacity,
+                                  const std::size_t batchSize = UDP_BATCH_SIZE,
+                                  const bool ioUring = false,
+                                  const std::size_t nofShards = UDP_LISTENER_SHARDS);
 
         ~UdpCommunicationInterface() override
         {
@@ -90,6 +156,34 @@ namespace Lib::Network
         }
 
         void close() override;
+        void start() override;
+        struct ReceivedData getReceivedElement() override;
+        bool tryGetReceivedElement(struct ReceivedData &data) override;
+        void setEventLoop(const Concurrency::EventLoop_ptr &loop) override; // Of all the shards
+        void performDiagnosticCheck() override;                             // Of all the listeners
+
+        // Exchanges the datagrams with the peers on the same host through
+        // AF_UNIX sockets, see LocalSocket. It must be called before start.
+        // Returns false if the local sockets cannot be bound.
+        bool enableLocalTransport();
+        bool isUsingLocalTransport() const;
+
+        // Receives also the datagrams sent to the broadcast address, or to
+        // the multicast group if not empty, on the given port. The port is
+        // shared with the other qubes on the same host, each getting its own
+        // copy. It must be called before start. Returns false on error.
+        bool enableDiscoveryListener(const unsigned short port, const std::string &group = "");
+        bool isUsingDiscoveryListener() const;
+
+        // Allows sending to the broadcast address and the multicast groups
+        bool enableDiscoverySender();
+
+        // Sends the already encoded datagrams with as few system calls as
+        // possible, see UdpSender::sendBatch. Returns how many have been sent.
+        std::size_t sendBatch(const struct Datagram *datagrams, const std::size_t count);
+
+        bool isUsingIoUring() const;
+        std::size_t getNofShards() const;
     };
 
     class TcpCommunicationInterface : public CommunicationInterface
@@ -114,8 +208,35 @@ namespace Lib::Network
         void disconnect();
     };
 
+    /**
+     * Exchanges the messages with the peers on the same host through shared
+     * memory rings, see SharedChannels. Peers are addressed by the address
+     * and port of their own SharedMemoryCommunicationInterface, and the first
+     * message to a peer sets up the rings with it.
+     */
+    class SharedMemoryCommunicationInterface : public CommunicationInterface
+    {
+    private:
+        SharedChannels_ptr _channels; // The rings shared with the peers
+
+    public:
+        SharedMemoryCommunicationInterface(const std::string &ip, unsigned short port,
+                                           const std::size_t capacity,
+                                           const std::size_t ringSize = SHM_RING_SIZE);
+
+        ~SharedMemoryCommunicationInterface() override
+        {
+            if (!isClosed())
+                this->close(); // Close all sockets on exit
+        }
+
+        void close() override;
+        std::size_t getNofChannels() const;
+    };
+
     typedef std::shared_ptr<TcpCommunicationInterface> TcpCommunicationInterface_ptr;
     typedef std::shared_ptr<UdpCommunicationInterface> UdpCommunicationInterface_ptr;
+    typedef std::shared_ptr<SharedMemoryCommunicationInterface> SharedMemoryCommunicationInterface_ptr;
 }
 
 #endif
\ No newline at end of file
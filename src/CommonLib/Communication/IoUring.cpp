@@ -0,0 +1,204 @@
+#include "IoUring.hpp"
+
+using namespace Lib::Network;
+
+namespace
+{
+    int ioUringSetup(unsigned entries, struct io_uring_params *params)
+    {
+        return (int)syscall(__NR_io_uring_setup, entries, params);
+    }
+
+    int ioUringEnter(int fd, unsigned toSubmit, unsigned minComplete, unsigned flags, void *arg, std::size_t argsz)
+    {
+        return (int)syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, arg, argsz);
+    }
+
+    int ioUringRegister(int fd, unsigned opcode, void *arg, unsigned nofArgs)
+    {
+        return (int)syscall(__NR_io_uring_register, fd, opcode, arg, nofArgs);
+    }
+}
+
+IoUring::IoUring(const unsigned entries)
+    : _sqRing(MAP_FAILED), _cqRing(MAP_FAILED), _sqes((struct io_uring_sqe*)MAP_FAILED), _sqLocalTail(0),
+      _bufRing((struct io_uring_buf_ring*)MAP_FAILED), _bufRingSize(0), _bufEntries(0), _bufBase(nullptr),
+      _bufSize(0), _bufGroup(0)
+{
+    memset(&_params, 0, sizeof(_params));
+    if ((_fd = ioUringSetup(entries, &_params)) < 0)
+    {
+        std::cerr << std::strerror(errno) << std::endl;
+        throw std::runtime_error("[IoUring] Failed io_uring setup");
+    }
+
+    // With a single mmap both the rings are in the same region
+    _sqRingSize = _params.sq_off.array + _params.sq_entries * sizeof(unsigned);
+    _cqRingSize = _params.cq_off.cqes + _params.cq_entries * sizeof(struct io_uring_cqe);
+    bool singleMmap = _params.features & IORING_FEAT_SINGLE_MMAP;
+    if (singleMmap) _sqRingSize = _cqRingSize = std::max(_sqRingSize, _cqRingSize);
+
+    _sqRing = mmap(nullptr, _sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _fd, IORING_OFF_SQ_RING);
+    _cqRing = singleMmap ? _sqRing : mmap(nullptr, _cqRingSize, PROT_READ | PROT_WRITE,
+                                          MAP_SHARED | MAP_POPULATE, _fd, IORING_OFF_CQ_RING);
+    _sqes = (struct io_uring_sqe*)mmap(nullptr, _params.sq_entries * sizeof(struct io_uring_sqe),
+                                       PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _fd, IORING_OFF_SQES);
+
+    if (_sqRing == MAP_FAILED || _cqRing == MAP_FAILED || _sqes == MAP_FAILED)
+    {
+        std::cerr << std::strerror(errno) << std::endl;
+        unmap();
+        close(_fd);
+        throw std::runtime_error("[IoUring] Failed mapping the queues");
+    }
+
+    unsigned char *sq = (unsigned char*)_sqRing;
+    unsigned char *cq = (unsigned char*)_cqRing;
+    _sqHead = (unsigned*)(sq + _params.sq_off.head);
+    _sqTail = (unsigned*)(sq + _params.sq_off.tail);
+    _sqMask = (unsigned*)(sq + _params.sq_off.ring_mask);
+    _sqArray = (unsigned*)(sq + _params.sq_off.array);
+    _cqHead = (unsigned*)(cq + _params.cq_off.head);
+    _cqTail = (unsigned*)(cq + _params.cq_off.tail);
+    _cqMask = (unsigned*)(cq + _params.cq_off.ring_mask);
+    _cqes = (struct io_uring_cqe*)(cq + _params.cq_off.cqes);
+    _sqLocalTail = *_sqTail;
+}
+
+IoUring::~IoUring()
+{
+    // Closing the ring also cancels the pending requests
+    close(_fd);
+    unmap();
+}
+
+void IoUring::unmap()
+{
+    if (_bufRing != MAP_FAILED) munmap(_bufRing, _bufRingSize);
+    if (_sqes != MAP_FAILED) munmap(_sqes, _params.sq_entries * sizeof(struct io_uring_sqe));
+    if (_cqRing != MAP_FAILED && _cqRing != _sqRing) munmap(_cqRing, _cqRingSize);
+    if (_sqRing != MAP_FAILED) munmap(_sqRing, _sqRingSize);
+}
+
+struct io_uring_sqe *IoUring::getSqe()
+{
+    unsigned head = __atomic_load_n(_sqHead, __ATOMIC_ACQUIRE);
+    if (_sqLocalTail - head >= _params.sq_entries) return nullptr;
+
+    unsigned idx = _sqLocalTail & *_sqMask;
+    struct io_uring_sqe *sqe = &_sqes[idx];
+    memset(sqe, 0, sizeof(struct io_uring_sqe));
+    _sqArray[idx] = idx;
+    _sqLocalTail++;
+    return sqe;
+}
+
+bool IoUring::submitAndWait(const unsigned waitNr, const long timeout_ms)
+{
+    unsigned toSubmit = _sqLocalTail - *_sqTail;
+    __atomic_store_n(_sqTail, _sqLocalTail, __ATOMIC_RELEASE);
+
+    struct __kernel_timespec ts;
+    ts.tv_sec = timeout_ms / 1000;
+    ts.tv_nsec = (timeout_ms % 1000) * 1000000;
+
+    struct io_uring_getevents_arg arg;
+    memset(&arg, 0, sizeof(arg));
+    arg.sigmask_sz = _NSIG / 8;
+    arg.ts = (std::uint64_t)&ts;
+
+    unsigned flags = IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG;
+    if (ioUringEnter(_fd, toSubmit, waitNr, flags, &arg, sizeof(arg)) < 0)
+    {
+        // Elapsed timeouts and signals are not errors
+        return errno == ETIME || errno == EINTR || errno == EBUSY;
+    }
+
+    return true;
+}
+
+bool IoUring::popCqe(struct io_uring_cqe &cqe)
+{
+    unsigned head = *_cqHead;
+    if (head == __atomic_load_n(_cqTail, __ATOMIC_ACQUIRE)) return false;
+
+    cqe = _cqes[head & *_cqMask];
+    __atomic_store_n(_cqHead, head + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+void IoUring::registerBuffers(unsigned char *base, const unsigned nofBuffers, const std::size_t bufSize,
+                              const unsigned short group)
+{
+    // The ring lives in its own pages, shared with the kernel
+    _bufRingSize = nofBuffers * sizeof(struct io_uring_buf);
+    _bufRing = (struct io_uring_buf_ring*)mmap(nullptr, _bufRingSize, PROT_READ | PROT_WRITE,
+                                               MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (_bufRing == MAP_FAILED)
+    {
+        std::cerr << std::strerror(errno) << std::endl;
+        throw std::runtime_error("[IoUring] Failed allocating the buffer ring");
+    }
+
+    struct io_uring_buf_reg reg;
+    memset(&reg, 0, sizeof(reg));
+    reg.ring_addr = (std::uint64_t)_bufRing;
+    reg.ring_entries = nofBuffers;
+    reg.bgid = group;
+
+    if (ioUringRegister(_fd, IORING_REGISTER_PBUF_RING, &reg, 1) < 0)
+    {
+        std::cerr << std::strerror(errno) << std::endl;
+        throw std::runtime_error("[IoUring] Failed registering the provided buffers");
+    }
+
+    _bufEntries = nofBuffers;
+    _bufBase = base;
+    _bufSize = bufSize;
+    _bufGroup = group;
+    _bufRing->tail = 0;
+
+    for (unsigned bid = 0; bid < nofBuffers; bid++) recycleBuffer(bid);
+}
+
+void IoUring::recycleBuffer(const unsigned short bufferId)
+{
+    unsigned short tail = _bufRing->tail;
+    // Not through the bufs member, whose flexible array has a different
+    // offset in C++ (the empty struct of __DECLARE_FLEX_ARRAY takes a byte)
+    struct io_uring_buf *buf = reinterpret_cast<struct io_uring_buf*>(_bufRing) + (tail & (_bufEntries - 1));
+    buf->addr = (std::uint64_t)getBuffer(bufferId);
+    buf->len = (std::uint32_t)_bufSize;
+    buf->bid = bufferId;
+
+    __atomic_store_n(&_bufRing->tail, (unsigned short)(tail + 1), __ATOMIC_RELEASE);
+}
+
+unsigned char *IoUring::getBuffer(const unsigned short bufferId) const
+{
+    return _bufBase + bufferId * _bufSize;
+}
+
+bool IoUring::isSupported()
+{
+    try
+    {
+        IoUring ring(4);
+        if (!(ring._params.features & IORING_FEAT_EXT_ARG)) return false;
+
+        // Multishot recvmsg came together with the zero-copy send, hence
+        // probing the latter tells if the former is available too.
+        std::vector<unsigned char> memory(sizeof(struct io_uring_probe) + IORING_OP_LAST * sizeof(struct io_uring_probe_op));
+        struct io_uring_probe *probe = (struct io_uring_probe*)memory.data();
+        if (ioUringRegister(ring._fd, IORING_REGISTER_PROBE, probe, IORING_OP_LAST) < 0) return false;
+        if (probe->last_op < IORING_OP_SEND_ZC) return false;
+        if (!(probe->ops[IORING_OP_SEND_ZC].flags & IO_URING_OP_SUPPORTED)) return false;
+        if (!(probe->ops[IORING_OP_RECVMSG].flags & IO_URING_OP_SUPPORTED)) return false;
+
+        return true;
+    }
+    catch (const std::runtime_error &)
+    {
+        return false;
+    }
+}
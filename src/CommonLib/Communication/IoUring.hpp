@@ -0,0 +1,94 @@
+#ifndef _IOURING_HPP
+#define _IOURING_HPP
+
+#include <iostream>
+#include <vector>
+#include <cstring>
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <csignal>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+#include <linux/time_types.h>
+
+#define IOURING_ENTRIES 64 // Number of entries of the submission queue
+
+namespace Lib::Network
+{
+    /**
+     * A minimal io_uring instance, driven by the raw system calls so that
+     * no external library is needed. It maps the submission and completion
+     * queues, and it can register a ring of provided buffers, from which
+     * the kernel picks the buffer of each completed receive.
+     *
+     * It is meant to be used by a single thread.
+     */
+    class IoUring
+    {
+    private:
+        int _fd;                            // The io_uring file descriptor
+        struct io_uring_params _params;     // The parameters returned by the setup
+        void *_sqRing;                      // The mapped submission queue ring
+        void *_cqRing;                      // The mapped completion queue ring
+        std::size_t _sqRingSize;            // Size of the mapped submission ring
+        std::size_t _cqRingSize;            // Size of the mapped completion ring
+        struct io_uring_sqe *_sqes;         // The submission queue entries
+        unsigned *_sqHead, *_sqTail;        // Head (kernel) and tail (ours) of the submissions
+        unsigned *_sqMask, *_sqArray;       // Mask and index array of the submissions
+        unsigned *_cqHead, *_cqTail;        // Head (ours) and tail (kernel) of the completions
+        unsigned *_cqMask;                  // Mask of the completions
+        struct io_uring_cqe *_cqes;         // The completion queue entries
+        unsigned _sqLocalTail;              // Tail including the entries not yet submitted
+
+        struct io_uring_buf_ring *_bufRing; // The ring of provided buffers, if any
+        std::size_t _bufRingSize;           // Size of the mapped buffer ring
+        unsigned _bufEntries;               // Number of provided buffers
+        unsigned char *_bufBase;            // First byte of the provided buffers
+        std::size_t _bufSize;               // Size of each provided buffer
+        unsigned short _bufGroup;           // The group id of the provided buffers
+
+        void unmap();
+
+    public:
+        /**
+         * @throw std::runtime_error if io_uring is not available
+         */
+        IoUring(const unsigned entries = IOURING_ENTRIES);
+        IoUring(const IoUring &other) = delete;
+        ~IoUring();
+
+        IoUring &operator=(const IoUring &other) = delete;
+
+        // Returns a cleared submission entry, nullptr if the queue is full
+        struct io_uring_sqe *getSqe();
+
+        // Submits the pending entries and waits up to timeout_ms for at
+        // least waitNr completions. Returns false on errors.
+        bool submitAndWait(const unsigned waitNr, const long timeout_ms);
+
+        // Takes the next completion, returns false if there is none
+        bool popCqe(struct io_uring_cqe &cqe);
+
+        /**
+         * Registers nofBuffers (a power of two) buffers of bufSize bytes,
+         * taken from the given memory, as the provided buffers of group.
+         *
+         * @throw std::runtime_error if the kernel does not support them
+         */
+        void registerBuffers(unsigned char *base, const unsigned nofBuffers,
+                             const std::size_t bufSize, const unsigned short group);
+
+        // Gives a provided buffer back to the kernel, once consumed
+        void recycleBuffer(const unsigned short bufferId);
+        unsigned char *getBuffer(const unsigned short bufferId) const;
+
+        // True if the kernel supports all the operations used by the
+        // UringUdpReceiver (provided buffers, multishot recvmsg)
+        static bool isSupported();
+    };
+}
+
+#endif
@@ -22,103 +22,225 @@ Lib::Concurrency::Queue_ptr<struct ReceivedData> Listener::getQueue()
     return _queue;
 }
 
+ByteBufferPool_ptr Listener::getBufferPool()
+{
+    return _pool;
+}
+
+namespace
+{
+    // The loop of the listeners that poll a datagram socket
+    void receiveDatagrams(Listener &listener, UdpSocket &socket, UdpReceiver &recv)
+    {
+        // Loop until the stop signal becomes true
+        while (listener.isRunning())
+        {
+            // Update the socket info and check if there are incoming messages
+            socket.updateSocketInfo();
+            struct Socket::SocketInfo* si = socket.getSocketInfo();
+
+            // Check for errors
+            if (!si->active && si->socket_error)
+            {
+                listener.stop();
+                break;
+            }
+
+            // Check for timeout or no messages arrived
+            if (si->timeout_ela || !si->ready_to_read) continue;
+
+            // Receive all the incoming messages from the socket,
+            // the receiver drains it batch by batch before returning
+            recv.receive();
+
+            // Before going on we need to check if during the poll
+            // an external call to stop the received have been made
+            if (!listener.isRunning()) break;
+
+            // After received we need to check whether the receiver
+            // has received a stop message
+            if (recv.hasStopped())
+            {
+                listener.stop();
+                continue;
+            }
+        }
+    }
+}
+
 void UdpListener::run()
 {
-    // Loop until the stop signal becomes true
+    receiveDatagrams(*this, _socket, _recv);
+}
+
+const UdpSocket &UdpListener::getSocket()
+{
+    return _socket;
+}
+
+bool UdpListener::hasStoppedWithErrors()
+{
+    struct Socket::SocketInfo* si = this->_socket.getSocketInfo();
+    return si->socket_error && (si->error != 0);
+}
+
+int UdpListener::getSocketError()
+{
+    return this->_socket.getSocketInfo()->error;
+}
+
+void LocalListener::run()
+{
+    receiveDatagrams(*this, _socket, _recv);
+}
+
+const LocalSocket &LocalListener::getSocket()
+{
+    return _socket;
+}
+
+bool LocalListener::hasStoppedWithErrors()
+{
+    struct Socket::SocketInfo* si = this->_socket.getSocketInfo();
+    return si->socket_error && (si->error != 0);
+}
+
+int LocalListener::getSocketError()
+{
+    return this->_socket.getSocketInfo()->error;
+}
+
+void SharedMemoryListener::run()
+{
+    // The receiver waits for the messages, and returns often
+    // enough to notice the stop signal.
     while (!this->_sigstop)
     {
-        // Update the socket info and check if there are incoming messages
-        this->_socket.updateSocketInfo();
-        struct Socket::SocketInfo* si = this->_socket.getSocketInfo();
-
-        // Check for errors
-        if (!si->active && si->socket_error)
+        _recv.receive();
+        if (_recv.hasStopped())
         {
+            struct Socket::SocketInfo* si = _channels->getSocket().getSocketInfo();
+            si->socket_error = true;
+            si->error = errno;
             this->stop();
-            break;
         }
+    }
+}
 
-        // Check for timeout or no messages arrived
-        if (si->timeout_ela || !si->ready_to_read) continue;
+const LocalSocket &SharedMemoryListener::getSocket()
+{
+    return _channels->getSocket();
+}
 
-        // Receive any incoming messages from the Udp Socket
-        // This actions is blocking for the poll timeout (1 sec)
-        _recv.receive();
+bool SharedMemoryListener::hasStoppedWithErrors()
+{
+    struct Socket::SocketInfo* si = _channels->getSocket().getSocketInfo();
+    return si->socket_error && (si->error != 0);
+}
 
-        // Before going on we need to check if during the poll
-        // an external call to stop the received have been made
-        if (!this->isRunning()) break;
+int SharedMemoryListener::getSocketError()
+{
+    return _channels->getSocket().getSocketInfo()->error;
+}
+
+void UringUdpListener::run()
+{
+    // The receiver waits for the datagrams, and returns often
+    // enough to notice the stop signal.
+    while (!this->_sigstop)
+    {
+        _recv.receive();
 
-        // After received we need to check whether the receiver
-        // has received a stop message
         if (_recv.hasStopped())
         {
+            struct Socket::SocketInfo* si = this->_socket.getSocketInfo();
+            si->socket_error = true;
+            si->error = _recv.getError();
             this->stop();
-            continue;
         }
     }
 }
 
-const UdpSocket &UdpListener::getSocket()
+const UdpSocket &UringUdpListener::getSocket()
 {
     return _socket;
 }
 
-bool UdpListener::hasStoppedWithErrors()
+bool UringUdpListener::hasStoppedWithErrors()
 {
     struct Socket::SocketInfo* si = this->_socket.getSocketInfo();
     return si->socket_error && (si->error != 0);
 }
 
-int UdpListener::getSocketError()
+int UringUdpListener::getSocketError()
 {
     return this->_socket.getSocketInfo()->error;
 }
 
-int TcpListener::handleReceivers()
+void TcpListener::acceptIncoming()
 {
-    int voidpos = _recvs.capacity() - 1;
+    int fd = this->_socket.getSocketFileDescriptor();
 
-    // First step of each cycle is to detect which receiver has ends
-    // its lifetime. If this happens than a new connection can be
-    // established by a new client
-    for (int idx = 0; idx < _recvs.capacity(); idx++)
+    // With edge-triggered notifications all the pending connections
+    // must be accepted, until there are no more.
+    while (true)
     {
-        auto receiver = _recvs.at(idx);
+        struct sockaddr_in client;
+        socklen_t clientlen = sizeof(client);
+        memset(&client, 0, sizeof(client));
 
-        // If there is no receiver continue
-        if (receiver == nullptr)
+        int clientfd = accept4(fd, (struct sockaddr*)&client, &clientlen, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (clientfd < 0)
         {
-            // We would like to have the first possible void position
-            voidpos = std::min(voidpos, idx);
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) return;
+
+            std::cerr << "[TcpListener::acceptIncoming] Error when accepting: ";
+            std::cerr << std::strerror(errno) << std::endl;
+            return;
+        }
+
+        // Over the limit, the connection is refused right away
+        if (_recvs.size() >= _maxNofClients)
+        {
+            std::cerr << "[TcpListener::acceptIncoming] Refused connection of ";
+            std::cerr << Socket::addressNumberToString(client.sin_addr.s_addr, true);
+            std::cerr << ": too many clients" << std::endl;
+            close(clientfd);
             continue;
         }
-        
-        // Otherwise, we need to check that the receiver is still running
-        if (receiver->hasStopped())
+
+#ifdef DEBUG_MODE
+        std::cout << "Accepted Connection of: " << Socket::addressNumberToString(client.sin_addr.s_addr, true);
+        std::cout << " on port " << ntohs(client.sin_port) << std::endl;
+#endif
+
+        struct epoll_event event;
+        event.events = EPOLLIN | EPOLLRDHUP | EPOLLET;
+        event.data.fd = clientfd;
+        if (epoll_ctl(_epollfd, EPOLL_CTL_ADD, clientfd, &event) < 0)
         {
-            // Join the thread and remove it from the list
-            receiver->join();
-            _recvs[idx] = nullptr;
-            _clientIdx--;
+            std::cerr << "[TcpListener::acceptIncoming] Error when watching the client: ";
+            std::cerr << std::strerror(errno) << std::endl;
+            close(clientfd);
+            continue;
         }
-    }
 
-    return voidpos;
-}
+        _recvs[clientfd] = std::make_unique<TcpReceiver>(this->_queue, this->_pool, clientfd, client);
+        _nofClients = _recvs.size();
 
-int TcpListener::acceptIncoming(struct sockaddr_in& client, socklen_t clientlen)
-{
-    int fd = this->_socket.getSocketFileDescriptor();
-    int client_socket;
-    if ((client_socket = accept(fd, (struct sockaddr*)&client, &clientlen)) < 0)
-    {
-        std::cerr << "[TcpListener::acceptIncoming] Error when accepting: ";
-        std::cerr << std::strerror(errno) << "->" << client_socket << std::endl;
-        return -1;
+        // Bytes may have arrived before the socket was watched
+        _recvs[clientfd]->receive();
+        if (_recvs[clientfd]->hasStopped()) closeConnection(clientfd);
     }
+}
 
-    return client_socket;
+void TcpListener::closeConnection(int clientfd)
+{
+    epoll_ctl(_epollfd, EPOLL_CTL_DEL, clientfd, nullptr);
+    close(clientfd);
+    _recvs.erase(clientfd);
+    _nofClients = _recvs.size();
 }
 
 void TcpListener::run()
@@ -131,89 +253,76 @@ void TcpListener::run()
 #endif
 
     // Put the TCP listener in listening mode from incoming connections
-    if (listen(fd, _recvs.capacity()) < 0)
+    if (listen(fd, SOMAXCONN) < 0)
     {
         std::cerr << "[TcpListener::listenFrom] Failed listening: ";
         std::cerr << std::strerror(errno) << std::endl;
         throw std::runtime_error("[TcpListener::listenFrom] Failed listening");
     }
 
-    struct Socket::SocketInfo* si;
-    struct sockaddr_in client;
-    int client_socket;
-    socklen_t clientlen;
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
 
-    // Loop until the listener is stopped. Differently from the Udp Listener
-    // the TCP listener accepts client connections and creates, for each new 
-    // connections, a receiver thread.
-    while (!this->_sigstop)
-    {
-        // Handle all the receivers
-        int voidpos = handleReceivers();
+    struct epoll_event event;
+    event.events = EPOLLIN | EPOLLET;
+    event.data.fd = fd;
 
-        // If there are no possible available connections sleep and continue
-        if (_clientIdx > _recvs.capacity() - 1)
-        {
-            std::this_thread::sleep_for(std::chrono::milliseconds(1000));
-            continue;
-        }
+    _epollfd = epoll_create1(EPOLL_CLOEXEC);
+    if (_epollfd < 0 || epoll_ctl(_epollfd, EPOLL_CTL_ADD, fd, &event) < 0)
+    {
+        std::cerr << "[TcpListener::run] Failed creating the reactor: ";
+        std::cerr << std::strerror(errno) << std::endl;
+        throw std::runtime_error("[TcpListener::run] Failed creating the reactor");
+    }
 
-        this->_socket.updateSocketInfo();
-        si = this->_socket.getSocketInfo();
+    struct epoll_event events[TCP_EPOLL_EVENTS];
 
-        // Check for any errors
-        if (!si->active && si->socket_error)
+    // Loop until the listener is stopped. A single thread accepts the
+    // clients and receives from all of them, whenever they are ready.
+    while (!this->_sigstop)
+    {
+        int nofEvents = epoll_wait(_epollfd, events, TCP_EPOLL_EVENTS, TCP_EPOLL_TIMEOUT_MS);
+        if (nofEvents < 0)
         {
+            if (errno == EINTR) continue;
+
+            struct Socket::SocketInfo* si = this->_socket.getSocketInfo();
+            si->socket_error = true;
+            si->error = errno;
             this->stop();
             break;
         }
 
-        if (si->timeout_ela || !si->ready_to_read) continue;
-
-        // Before going on we need to check if during the poll
-        // an external call to stop the received have been made
-        if (!this->isRunning()) break;
-
-        // Otherwise, wait for a connection
-        memset(&client, 0, sizeof(client));
-        clientlen = sizeof(client);
-
-#ifdef DEBUG_MODE
-        std::cout << "Start Accepting" << std::endl;
-#endif
-
-        // Accept incoming connections and save the source informations
-        if ((client_socket = acceptIncoming(client, clientlen)) < 0)
+        for (int idx = 0; idx < nofEvents; idx++)
         {
-            si->ready_to_read = false;
-            continue;
+            int eventfd = events[idx].data.fd;
+            if (eventfd == fd)
+            {
+                acceptIncoming();
+                continue;
+            }
+
+            auto receiver = _recvs.find(eventfd);
+            if (receiver == _recvs.end()) continue;
+
+            // Reading first, so that the bytes sent before a close are not lost
+            receiver->second->receive();
+            if (receiver->second->hasStopped() || (events[idx].events & (EPOLLERR | EPOLLHUP)))
+            {
+                closeConnection(eventfd);
+            }
         }
-
-#ifdef DEBUG_MODE
-        std::cout << "Accepted Connection of: " << Socket::addressNumberToString(client.sin_addr.s_addr, true);
-        std::cout << " on port " << ntohs(client.sin_port) << std::endl;
-#endif
-
-        _recvs[voidpos] = std::make_shared<TcpReceiver>(
-            this->_queue, _socket, "TcpReceiver", client_socket, &client);
-
-        // Start the receiver
-        _recvs.at(voidpos)->start();
-        _clientIdx++;
-
-        si->ready_to_read = false;
     }
 
-    // Once this thread has stopped we need to join all 
-    // the remaining receivers.
-    for (auto &recv: _recvs)
+    // Once this thread has stopped all the connections are closed
+    for (auto &receiver : _recvs)
     {
-        if (!(recv == nullptr))
-        {
-            recv->stop();
-            recv->join();
-        }
+        close(receiver.first);
     }
+
+    _recvs.clear();
+    _nofClients = 0;
+    close(_epollfd);
+    _epollfd = -1;
 }
 
 void TcpListener::setTimeout(long int sec, long int usec)
@@ -226,6 +335,11 @@ void TcpListener::setTimeout(long int sec)
     _socket.setTimeout(sec);
 }
 
+std::size_t TcpListener::getNofClients() const
+{
+    return _nofClients.load();
+}
+
 const TcpSocket &TcpListener::getSocket()
 {
     return _socket;
@@ -4,27 +4,39 @@
 #include <iostream>
 #include <optional>
 #include <algorithm>
+#include <memory>
+#include <unordered_map>
+#include <atomic>
+#include <sys/epoll.h>
 #include <CommonLib/Communication/Socket.hpp>
 #include <CommonLib/Communication/Message.hpp>
 #include <CommonLib/Communication/Receiver.hpp>
 #include <CommonLib/Concurrency/Thread.hpp>
 #include <CommonLib/Concurrency/Queue.hpp>
 
+#define TCP_EPOLL_EVENTS 64      // Maximum number of events handled by each wait
+#define TCP_EPOLL_TIMEOUT_MS 100 // How often the reactor checks for the stop signal
+
 namespace Lib::Network
 {
     class Listener : public Concurrency::Thread
     {
     protected:
         Concurrency::Queue_ptr<struct ReceivedData> _queue; // The queue of received and converted messages
+        ByteBufferPool_ptr _pool;                           // The pool of the receive buffers
         bool _sigstop;                                      // Flag indicating when the listener must be stopped
 
     public:
         Listener(const Concurrency::Queue_ptr<struct ReceivedData>& queue, const std::string &name)
-            : Concurrency::Thread(name), _queue(queue), _sigstop(false) {};
+            : Concurrency::Thread(name), _queue(queue), _sigstop(false)
+        {
+            _pool = std::make_shared<ByteBufferPool>(RECVPOOLSIZE, RECVBUFFSIZE);
+        };
 
         Listener(const std::size_t capacity, const std::string &name) : Thread(name)
         {
             _queue = std::make_shared<Concurrency::Queue<struct ReceivedData>>(capacity);
+            _pool = std::make_shared<ByteBufferPool>(RECVPOOLSIZE, RECVBUFFSIZE);
             _sigstop = false;
         };
 
@@ -32,6 +44,7 @@ namespace Lib::Network
         bool isRunning() const;
         struct ReceivedData getElement();
         Concurrency::Queue_ptr<struct ReceivedData> getQueue();
+        ByteBufferPool_ptr getBufferPool();
 
         virtual const Socket &getSocket() = 0;
         virtual bool hasStoppedWithErrors() = 0;
@@ -49,18 +62,23 @@ namespace Lib::Network
          * @param ip The Ip address needed to bind the socket
          * @param port The port number, also needed by the socket
          * @param q A shared pointer to a Queue
+         * @param batchSize Maximum number of datagrams received with a single syscall
+         * @param reusePort If other listeners can bind the same port, see Socket
          */
-        UdpListener(const std::string &ip, unsigned short port, const Concurrency::Queue_ptr<struct ReceivedData>& q)
-            : Listener(q, "UdpListener"), _socket(ip, port), _recv(q, _socket) {};
+        UdpListener(const std::string &ip, unsigned short port, const Concurrency::Queue_ptr<struct ReceivedData>& q,
+                    const std::size_t batchSize = UDP_BATCH_SIZE, const bool reusePort = false)
+            : Listener(q, "UdpListener"), _socket(ip, port, reusePort), _recv(q, this->_pool, _socket, batchSize) {};
 
-        UdpListener(const std::string &ip, unsigned short port, const std::size_t c)
-            : Listener(c, "UdpListener"), _socket(ip, port), _recv(this->_queue, _socket) {};
+        UdpListener(const std::string &ip, unsigned short port, const std::size_t c,
+                    const std::size_t batchSize = UDP_BATCH_SIZE)
+            : Listener(c, "UdpListener"), _socket(ip, port), _recv(this->_queue, this->_pool, _socket, batchSize) {};
 
-        UdpListener(const UdpSocket &s, const Concurrency::Queue_ptr<struct ReceivedData>& q)
-            : Listener(q, "UdpListener"), _socket(s), _recv(q, _socket) {};
+        UdpListener(const UdpSocket &s, const Concurrency::Queue_ptr<struct ReceivedData>& q,
+                    const std::size_t batchSize = UDP_BATCH_SIZE)
+            : Listener(q, "UdpListener"), _socket(s), _recv(q, this->_pool, _socket, batchSize) {};
 
-        UdpListener(const UdpSocket &s, const std::size_t c)
-            : Listener(c, "UdpListener"), _socket(s), _recv(this->_queue, _socket) {};
+        UdpListener(const UdpSocket &s, const std::size_t c, const std::size_t batchSize = UDP_BATCH_SIZE)
+            : Listener(c, "UdpListener"), _socket(s), _recv(this->_queue, this->_pool, _socket, batchSize) {};
 
         ~UdpListener()
         {
@@ -75,29 +93,121 @@ namespace Lib::Network
         int getSocketError() override; 
     };
 
+    /**
+     * Receives the datagrams sent by the peers on the same host to the
+     * LocalSocket standing for the given address, see LocalSocket.
+     */
+    class LocalListener : public Listener
+    {
+    private:
+        LocalSocket _socket; // The local socket
+        UdpReceiver _recv;   // The object receiving the messages
+
+    public:
+        LocalListener(const std::string &ip, unsigned short port, const Concurrency::Queue_ptr<struct ReceivedData>& q,
+                      const std::size_t batchSize = UDP_BATCH_SIZE)
+            : Listener(q, "LocalListener"), _socket(ip, port), _recv(q, this->_pool, _socket, batchSize) {};
+
+        ~LocalListener()
+        {
+            _socket.closeSocket();
+        }
+
+        using Listener::isRunning;
+
+        void run() override;
+        const LocalSocket &getSocket() override;
+        bool hasStoppedWithErrors() override;
+        int getSocketError() override;
+    };
+
+    /**
+     * Receives the messages written by the peers on the same host into the
+     * shared memory rings, see SharedChannels.
+     */
+    class SharedMemoryListener : public Listener
+    {
+    private:
+        SharedChannels_ptr _channels; // The rings shared with the peers
+        SharedMemoryReceiver _recv;   // The object receiving the messages
+
+    public:
+        SharedMemoryListener(const SharedChannels_ptr &channels, const Concurrency::Queue_ptr<struct ReceivedData>& q)
+            : Listener(q, "SharedMemoryListener"), _channels(channels), _recv(q, this->_pool, channels) {};
+
+        using Listener::isRunning;
+
+        void run() override;
+        const LocalSocket &getSocket() override;
+        bool hasStoppedWithErrors() override;
+        int getSocketError() override;
+    };
+
+    /**
+     * A UdpListener whose receiver is driven by io_uring, see UringUdpReceiver.
+     * Constructing it fails when the kernel does not support io_uring, in
+     * which case the UdpListener is the fallback.
+     */
+    class UringUdpListener : public Listener
+    {
+    private:
+        UdpSocket _socket;      // The Udp Socket
+        UringUdpReceiver _recv; // The object receiving the messages
+
+    public:
+        UringUdpListener(const std::string &ip, unsigned short port, const Concurrency::Queue_ptr<struct ReceivedData>& q,
+                         const bool reusePort = false)
+            : Listener(q, "UringUdpListener"), _socket(ip, port, reusePort), _recv(q, this->_pool, _socket) {};
+
+        UringUdpListener(const std::string &ip, unsigned short port, const std::size_t c)
+            : Listener(c, "UringUdpListener"), _socket(ip, port), _recv(this->_queue, this->_pool, _socket) {};
+
+        ~UringUdpListener()
+        {
+            _socket.closeSocket();
+        }
+
+        using Listener::isRunning;
+
+        void run() override;
+        const UdpSocket &getSocket() override;
+        bool hasStoppedWithErrors() override;
+        int getSocketError() override;
+    };
+
+    /**
+     * Accepts the TCP connections and receives from all of them on its own
+     * thread, with an edge-triggered epoll reactor. Each connection is a
+     * TcpReceiver, that reassembles the messages of the stream and pushes
+     * them into the shared queue.
+     */
     class TcpListener : public Listener
     {
     private:
-        TcpSocket _socket;                                // The Tcp Socket
-        std::vector<std::shared_ptr<TcpReceiver>> _recvs; // The vector of all receivers
-        std::size_t _clientIdx;                           // The current number of clients connected to the server
+        TcpSocket _socket;                    // The Tcp Socket
+        std::size_t _maxNofClients;           // Maximum number of clients connected at once
+        int _epollfd;                         // The epoll instance of the reactor
+        std::atomic<std::size_t> _nofClients; // Number of connected clients, read by other threads
+
+        // The connected clients, by socket file descriptor
+        std::unordered_map<int, std::unique_ptr<TcpReceiver>> _recvs;
 
-        int handleReceivers();
-        int acceptIncoming(struct sockaddr_in &client, socklen_t clientlen);
+        void acceptIncoming();
+        void closeConnection(int clientfd);
 
     public:
         TcpListener(const std::string &ip, unsigned short port, const Concurrency::Queue_ptr<struct ReceivedData>& queue, 
             const std::size_t nconn) : Listener(queue, "TcpListener"), _socket(ip, port), 
-                _recvs(nconn, nullptr), _clientIdx(0) {};
+                _maxNofClients(nconn), _epollfd(-1), _nofClients(0) {};
 
         TcpListener(const std::string &ip, unsigned short port, const std::size_t capacity, const std::size_t nconn)
-            : Listener(capacity, "TcpListener"), _socket(ip, port), _recvs(nconn, nullptr), _clientIdx(0) {};
+            : Listener(capacity, "TcpListener"), _socket(ip, port), _maxNofClients(nconn), _epollfd(-1), _nofClients(0) {};
 
         TcpListener(const TcpSocket &s, const Concurrency::Queue_ptr<struct ReceivedData>& queue, const std::size_t nconn)
-            : Listener(queue, "TcpListener"), _socket(s), _recvs(nconn, nullptr), _clientIdx(0) {};
+            : Listener(queue, "TcpListener"), _socket(s), _maxNofClients(nconn), _epollfd(-1), _nofClients(0) {};
 
         TcpListener(const TcpSocket &s, const std::size_t capacity, const std::size_t nconn)
-            : Listener(capacity, "TcpListener"), _socket(s), _recvs(nconn, nullptr), _clientIdx(0) {};
+            : Listener(capacity, "TcpListener"), _socket(s), _maxNofClients(nconn), _epollfd(-1), _nofClients(0) {};
 
         ~TcpListener()
         {
@@ -109,6 +219,7 @@ namespace Lib::Network
         void run() override;
         void setTimeout(long int sec, long int usec);
         void setTimeout(long int sec);
+        std::size_t getNofClients() const;
         const TcpSocket &getSocket() override;
         bool hasStoppedWithErrors() override;
         int getSocketError() override;
@@ -1,27 +1,45 @@
 #include "Message.hpp"
+#include "MessageView.hpp"
 
 using namespace Lib::Network;
 
-void Message::encode_(Message& msg)
+unsigned char *Message::encodeHeader(const std::size_t bodySize)
 {
-    msg.clear();
-    msg.put(msg.getMessageCounter());
-    msg.put(msg.getMessageId());
-    msg.put(static_cast<unsigned char>(msg.getMessageType()));
-    msg.put(static_cast<unsigned char>(msg.getMessageSubType()));
-    msg.put(msg.getMessageProtoFlags());
-    msg.spare();
+    Schema::Header::Record header;
+    header.set<Schema::Counter>(_counter);
+    header.set<Schema::Id>(_id);
+    header.set<Schema::Type>(static_cast<uint8_t>(_type));
+    header.set<Schema::SubType>(static_cast<uint8_t>(_subType));
+    header.set<Schema::Flags>(_flag);
+    header.set<Schema::Length>(static_cast<uint32_t>(NUM_HEAD_BYTES + bodySize));
+
+    clear();
+    unsigned char *dst = prepareWrite(NUM_HEAD_BYTES + bodySize, "Message::encode");
+    Schema::Header::encode(dst, header, _order == ByteOrder::BigEndian);
+    return dst + NUM_HEAD_BYTES;
+}
+
+const unsigned char *Message::decodeHeader(ByteBufferView &view, const std::size_t bodySize)
+{
+    view.position(0);
+    const unsigned char *src = view.read(NUM_HEAD_BYTES + bodySize);
+
+    Schema::Header::Record header;
+    Schema::Header::decode(src, header, view.getByteOrder() == ByteOrder::BigEndian);
+    setMessageCounter(header.get<Schema::Counter>());
+    setMessageId(header.get<Schema::Id>());
+    setMessageType(static_cast<MessageType>(header.get<Schema::Type>()));
+    setMessageSubType(static_cast<MessageSubType>(header.get<Schema::SubType>()));
+    setMessageProtocol(protocolFromFlags(header.get<Schema::Flags>()));
+    return src + NUM_HEAD_BYTES;
 }
 
-void Message::decode_(Message &msg)
+void Message::decode()
 {
-    msg.position(0);
-    msg.setMessageCounter(msg.getShort());
-    msg.setMessageId(msg.getShort());
-    msg.setMessageType(static_cast<MessageType>(msg.get()));
-    msg.setMessageSubType(static_cast<MessageSubType>(msg.get()));
-    msg.setMessageProtocol(static_cast<MessageProto>(msg.get() >> 6));
-    msg.position(msg.position() + 1);
+    // Decoding the message from its own content is just decoding
+    // from a view over the internal buffer, no copies are involved.
+    ByteBufferView view(*this);
+    decode(view);
 }
 
 const unsigned short Message::getMessageCounter() const
@@ -85,11 +103,117 @@ void Message::setMessageProtocol(const MessageProto &proto)
     _flag = (static_cast<uint8_t>(_proto) + 1) << 6; // Set the protocol flags
 }
 
+Message::MessageProto Message::protocolFromFlags(const uint8_t flags)
+{
+    // The protocol is stored as (proto + 1) in the two highest bits
+    return (flags >> 6) == static_cast<uint8_t>(MessageProto::UDP) + 1 ? MessageProto::UDP : MessageProto::TCP;
+}
+
+std::size_t Message::compress(const unsigned char *msg, const std::size_t nofBytes,
+                              unsigned char *dst, const std::size_t capacity)
+{
+    std::size_t prefix = NUM_HEAD_BYTES + Schema::Compressed::SIZE;
+    std::size_t limit = std::min(capacity, nofBytes - 1);
+    if (nofBytes <= NUM_HEAD_BYTES || limit <= prefix) return 0;
+
+    std::size_t bodySize = nofBytes - NUM_HEAD_BYTES;
+    std::size_t size = LZCompressor::compress(msg + NUM_HEAD_BYTES, bodySize, dst + prefix, limit - prefix);
+    if (size == 0) return 0;
+
+    // Same header, but flagged and with the new length
+    Schema::Header::Record header;
+    Schema::Header::decode(msg, header, true);
+    header.set<Schema::Flags>(header.get<Schema::Flags>() | COMPRESSED_FLAG);
+    header.set<Schema::Length>(static_cast<uint32_t>(prefix + size));
+    Schema::Header::encode(dst, header, true);
+
+    Schema::Compressed::Record compressed;
+    compressed.set<Schema::BodyLength>(static_cast<uint32_t>(bodySize));
+    Schema::Compressed::encode(dst + NUM_HEAD_BYTES, compressed, true);
+    return prefix + size;
+}
+
+std::size_t Message::getDecompressedSize(const unsigned char *msg, const std::size_t nofBytes,
+                                         const std::size_t maxSize)
+{
+    if (nofBytes < NUM_HEAD_BYTES + Schema::Compressed::SIZE) return 0;
+
+    Schema::Compressed::Record compressed;
+    Schema::Compressed::decode(msg + NUM_HEAD_BYTES, compressed, true);
+    std::size_t bodySize = compressed.get<Schema::BodyLength>();
+    return bodySize + NUM_HEAD_BYTES <= maxSize ? bodySize + NUM_HEAD_BYTES : 0;
+}
+
+bool Message::decompress(const unsigned char *msg, const std::size_t nofBytes, ByteBuffer &dst)
+{
+    std::size_t prefix = NUM_HEAD_BYTES + Schema::Compressed::SIZE;
+    std::size_t size = getDecompressedSize(msg, nofBytes);
+    if (size == 0 || size > dst.getBufferCapacity()) return false;
+    std::size_t bodySize = size - NUM_HEAD_BYTES;
+
+    Schema::Header::Record header;
+    Schema::Header::decode(msg, header, true);
+    header.set<Schema::Flags>(header.get<Schema::Flags>() & ~COMPRESSED_FLAG);
+    header.set<Schema::Length>(static_cast<uint32_t>(NUM_HEAD_BYTES + bodySize));
+
+    dst.clear();
+    dst.reserve(size);
+    unsigned char *out = dst.write(size);
+    Schema::Header::encode(out, header, true);
+    return LZCompressor::decompress(msg + prefix, nofBytes - prefix, out + NUM_HEAD_BYTES, bodySize);
+}
+
+std::size_t Message::appendChecksum(unsigned char *msg, const std::size_t nofBytes)
+{
+    prepareChecksum(msg, nofBytes, msg, msg + nofBytes);
+    return nofBytes + CHECKSUM_SIZE;
+}
+
+void Message::prepareChecksum(const unsigned char *msg, const std::size_t nofBytes,
+                              unsigned char *header, unsigned char *trailer)
+{
+    Schema::Header::Record headerRecord;
+    Schema::Header::decode(msg, headerRecord, true);
+    headerRecord.set<Schema::Flags>(headerRecord.get<Schema::Flags>() | CHECKSUM_FLAG);
+    headerRecord.set<Schema::Length>(static_cast<uint32_t>(nofBytes + CHECKSUM_SIZE));
+    Schema::Header::encode(header, headerRecord, true);
+
+    // The checksum covers also the header, hence it is computed after the update
+    uint32_t crc = CRC32C::compute(header, NUM_HEAD_BYTES);
+    crc = CRC32C::extend(crc, msg + NUM_HEAD_BYTES, nofBytes - NUM_HEAD_BYTES);
+
+    Schema::Trailer::Record trailerRecord;
+    trailerRecord.set<Schema::Checksum>(crc);
+    Schema::Trailer::encode(trailer, trailerRecord, true);
+}
+
+std::size_t Message::removeChecksum(unsigned char *msg, const std::size_t nofBytes)
+{
+    if (nofBytes < NUM_HEAD_BYTES + CHECKSUM_SIZE) return 0;
+
+    std::size_t size = nofBytes - CHECKSUM_SIZE;
+    Schema::Trailer::Record trailer;
+    Schema::Trailer::decode(msg + size, trailer, true);
+    if (trailer.get<Schema::Checksum>() != CRC32C::compute(msg, size)) return 0;
+
+    Schema::Header::Record header;
+    Schema::Header::decode(msg, header, true);
+    header.set<Schema::Flags>(header.get<Schema::Flags>() & ~CHECKSUM_FLAG);
+    header.set<Schema::Length>(static_cast<uint32_t>(size));
+    Schema::Header::encode(msg, header, true);
+    return size;
+}
+
 const Message::MessageSubType Message::fetchMessageSubType(const ByteBuffer_ptr& buffer)
 {
-    uint8_t msgSubtype[1];
-    buffer->getBuffer(msgSubtype, Message::MSG_SUBTYPE_OFFSET, Message::BYTE_SIZE);
-    return static_cast<Message::MessageSubType>(*(msgSubtype));
+    return fetchMessageSubType(ByteBufferView(*buffer));
+}
+
+const Message::MessageSubType Message::fetchMessageSubType(const ByteBufferView& view)
+{
+    ByteBufferView header(view);
+    header.position(Message::MSG_SUBTYPE_OFFSET);
+    return static_cast<Message::MessageSubType>(header.get());
 }
 
 const std::string &SimpleMessage::getMessage() const
@@ -99,159 +223,186 @@ const std::string &SimpleMessage::getMessage() const
 
 void SimpleMessage::encode()
 {
-    Message::encode_(*this);
-    put((unsigned char*)this->_msg.c_str(), this->_msg.size());
+    memcpy(encodeHeader(this->_msg.size()), this->_msg.c_str(), this->_msg.size());
 }
 
-void SimpleMessage::decode()
+void SimpleMessage::decode(ByteBufferView &view)
 {
-    Message::decode_(*this);
-
-    // Decode the message
-    std::size_t buffSize = getRemainingSize();
-    
-    // Initialize the output vector of bytes
-    char msg[buffSize + 1];
-    memset(msg, 0, buffSize + 1);
+    decodeHeader(view, 0);
 
-    getBuffer((unsigned char*)msg, buffSize);
+    // Decode the message directly from the viewed bytes
+    std::size_t buffSize = view.getRemainingSize();
+    const char *msg = (const char*)(view.getData() + view.position());
 
-    _msg = msg;
+    // The string ends either at the first null byte or at the end of the buffer
+    _msg.assign(msg, strnlen(msg, buffSize));
+    view.position(view.position() + buffSize);
 }
 
 void DiscoverHelloMessage::setUdpPort(const unsigned short udpPort)
 {
-    _udpPort = udpPort;
+    set<Schema::UdpPort>(udpPort);
 }
 
 void DiscoverHelloMessage::setTcpPort(const unsigned short tcpPort)
 {
-    _tcpPort = tcpPort;
+    set<Schema::TcpPort>(tcpPort);
 }
 
 void DiscoverHelloMessage::setIpAddress(const unsigned int ipAddr)
 {
-    _ipaddr = ipAddr;
+    set<Schema::IpAddress>(ipAddr);
 }
 
 unsigned short DiscoverHelloMessage::getUdpPort() const
 {
-    return _udpPort;
+    return get<Schema::UdpPort>();
 }
 
 unsigned short DiscoverHelloMessage::getTcpPort() const
 {
-    return _tcpPort;
+    return get<Schema::TcpPort>();
 }
 
 unsigned int DiscoverHelloMessage::getIpAddress() const
 {
-    return _ipaddr;
-}
-
-void DiscoverHelloMessage::encode()
-{
-    Message::encode_(*this);
-    put(_udpPort);
-    put(_tcpPort);
-    put(_ipaddr);
-}
-
-void DiscoverHelloMessage::decode()
-{
-    Message::decode_(*this);
-    setUdpPort(getShort());
-    setTcpPort(getShort());
-    setIpAddress(getInt());
+    return get<Schema::IpAddress>();
 }
 
 void DiscoverResponseMessage::setUdpPort(const unsigned short udpPort)
 {
-    _udpPort = udpPort;
+    set<Schema::UdpPort>(udpPort);
 }
 
 void DiscoverResponseMessage::setTcpPort(const unsigned short tcpPort)
 {
-    _tcpPort = tcpPort;
+    set<Schema::TcpPort>(tcpPort);
 }
 
-void Lib::Network::DiscoverResponseMessage::setIpAddress(const unsigned int ipAddr)
+void DiscoverResponseMessage::setIpAddress(const unsigned int ipAddr)
 {
-    _ipaddr = ipAddr;
+    set<Schema::IpAddress>(ipAddr);
 }
 
 void DiscoverResponseMessage::setAvailableMemory_mb(const uint32_t memory_mb)
 {
-   _freeRamMb = memory_mb; 
+    set<Schema::FreeRamMb>(memory_mb);
 }
 
 void DiscoverResponseMessage::setAvailableMemory_kb(const uint32_t memory_kb)
 {
-    _freeRamKb = memory_kb;
+    set<Schema::FreeRamKb>(memory_kb);
 }
 
 void DiscoverResponseMessage::setCpuUsage(const uint8_t cpu_usage)
 {
-    _cpuUsage = cpu_usage;
+    set<Schema::CpuUsage>(cpu_usage);
 }
 
 unsigned short DiscoverResponseMessage::getUdpPort() const
 {
-    return _udpPort;
+    return get<Schema::UdpPort>();
 }
 
-unsigned int Lib::Network::DiscoverResponseMessage::getIpAddress() const
+unsigned short DiscoverResponseMessage::getTcpPort() const
 {
-    return _ipaddr;
+    return get<Schema::TcpPort>();
 }
 
-unsigned short DiscoverResponseMessage::getTcpPort() const
+unsigned int DiscoverResponseMessage::getIpAddress() const
 {
-    return _tcpPort;
+    return get<Schema::IpAddress>();
 }
 
 uint32_t DiscoverResponseMessage::getAvailableMemory_kb() const
 {
-    return _freeRamKb;
+    return get<Schema::FreeRamKb>();
 }
 
 uint32_t DiscoverResponseMessage::getAvailableMemory_mb() const
 {
-    return _freeRamMb;
+    return get<Schema::FreeRamMb>();
 }
 
 unsigned long long DiscoverResponseMessage::getAvailableMemory() const
 {
-    return _freeRamMb * 1000 + _freeRamKb;
+    return getAvailableMemory_mb() * 1000 + getAvailableMemory_kb();
 }
 
 uint8_t DiscoverResponseMessage::getCpuUsage() const
 {
-    return _cpuUsage;
+    return get<Schema::CpuUsage>();
 }
 
-void DiscoverResponseMessage::encode()
+std::size_t BatchMessage::getEncodedSize(const std::size_t nofMessages, const std::size_t nofBytes)
 {
-    Message::encode_(*this);
-    put(_udpPort);
-    put(_tcpPort);
-    put(_ipaddr);
-    put(_freeRamMb);
-    put(_freeRamKb);
-    put(_cpuUsage);
-    spare();
-    spare();
-    spare();
+    return WIRE_SIZE + nofMessages * Schema::EndOffset::SIZE + nofBytes;
 }
 
-void DiscoverResponseMessage::decode()
+std::size_t BatchMessage::getEncodedSize() const
 {
-    Message::decode_(*this);
-    setUdpPort(getShort());
-    setTcpPort(getShort());
-    setIpAddress(getInt());
-    setAvailableMemory_mb(getInt());
-    setAvailableMemory_kb(getInt());
-    setCpuUsage(get());
-    position(position() + 3);
-}
\ No newline at end of file
+    return getEncodedSize(_offsets.size(), _payload.size());
+}
+
+bool BatchMessage::add(const unsigned char *data, const std::size_t nofBytes)
+{
+    // Offsets are 16 bits wide, so also the messages must fit them
+    std::size_t newSize = getEncodedSize(_offsets.size() + 1, _payload.size() + nofBytes);
+    if (newSize > _capacity || _payload.size() + nofBytes > UINT16_MAX) return false;
+
+    _payload.insert(_payload.end(), data, data + nofBytes);
+    _offsets.push_back(static_cast<uint16_t>(_payload.size()));
+    return true;
+}
+
+bool BatchMessage::add(Message &msg)
+{
+    msg.encode();
+    return add(msg.getData(), msg.getBufferSize());
+}
+
+std::size_t BatchMessage::getNofMessages() const
+{
+    return _offsets.size();
+}
+
+ByteBufferView BatchMessage::getMessage(const std::size_t idx) const
+{
+    std::size_t start = (idx == 0) ? 0 : _offsets[idx - 1];
+    std::size_t end = std::max<std::size_t>(start, _offsets[idx]);
+    return ByteBufferView(_payload.data() + start, end - start);
+}
+
+void BatchMessage::reset()
+{
+    _offsets.clear();
+    _payload.clear();
+}
+
+void BatchMessage::encode()
+{
+    std::size_t tableSize = _offsets.size() * Schema::EndOffset::SIZE;
+    unsigned char *dst = encodeHeader(Schema::Batch::SIZE + tableSize + _payload.size());
+    bool bigEndian = _order == ByteOrder::BigEndian;
+
+    Schema::Count::store(dst, static_cast<uint16_t>(_offsets.size()), bigEndian);
+    ByteSwap::storeArray(dst + Schema::Batch::SIZE, _offsets.data(), _offsets.size(), bigEndian);
+    memcpy(dst + Schema::Batch::SIZE + tableSize, _payload.data(), _payload.size());
+}
+
+void BatchMessage::decode(ByteBufferView &view)
+{
+    // The offset table is checked as a whole before reading any message
+    reset();
+    if (!BatchMessageView(view).isValid()) return;
+
+    const unsigned char *src = decodeHeader(view, Schema::Batch::SIZE);
+    bool bigEndian = view.getByteOrder() == ByteOrder::BigEndian;
+
+    _offsets.resize(Schema::Count::load(src, bigEndian));
+    view.getShorts(_offsets.data(), _offsets.size());
+
+    std::size_t nofBytes = _offsets.empty() ? 0 : _offsets.back();
+    const unsigned char *payload = view.read(nofBytes);
+    _payload.assign(payload, payload + nofBytes);
+}
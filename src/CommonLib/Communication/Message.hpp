@@ -3,12 +3,55 @@
 
 #include <iostream>
 #include <cstring>
+#include <vector>
 #include <arpa/inet.h>
 #include <CommonLib/Communication/ByteBuffer.hpp>
+#include <CommonLib/Communication/ByteBufferView.hpp>
+#include <CommonLib/Communication/MessageSchema.hpp>
+#include <CommonLib/Communication/Compression.hpp>
+#include <CommonLib/Communication/CRC32C.hpp>
 
 namespace Lib::Network
 {
     const unsigned short MAX_MESSAGE_CAPACITY = 65535;
+    const std::size_t MAX_FRAME_SIZE = 16 * 1024 * 1024; // Largest message on a TCP stream
+
+    namespace Schema
+    {
+        // Fields of the header common to all the messages
+        struct Counter : Field<uint16_t> {};
+        struct Id : Field<uint16_t> {};
+        struct Type : Field<uint8_t> {};
+        struct SubType : Field<uint8_t> {};
+        struct Flags : Field<uint8_t> {};
+        struct Length : Field<uint32_t> {}; // Number of bytes of the whole message
+
+        // Fields of the discover messages
+        struct UdpPort : Field<uint16_t> {};
+        struct TcpPort : Field<uint16_t> {};
+        struct IpAddress : Field<uint32_t> {};
+        struct FreeRamMb : Field<uint32_t> {};
+        struct FreeRamKb : Field<uint32_t> {};
+        struct CpuUsage : Field<uint8_t> {};
+
+        // Fields of the batch message
+        struct Count : Field<uint16_t> {};
+        struct EndOffset : Field<uint16_t> {};
+
+        // Fields of a compressed message
+        struct BodyLength : Field<uint32_t> {}; // Number of bytes of the uncompressed body
+
+        // Fields of the integrity trailer
+        struct Checksum : Field<uint32_t> {}; // CRC32C of all the preceding bytes
+
+        using Header = Layout<Counter, Id, Type, SubType, Flags, Padding<1>, Length>;
+        using Empty = Layout<>;
+        using DiscoverHello = Layout<UdpPort, TcpPort, IpAddress>;
+        using DiscoverResponse = Layout<UdpPort, TcpPort, IpAddress, FreeRamMb, FreeRamKb, CpuUsage, Padding<3>>;
+        using Batch = Layout<Count>; // Followed by Count EndOffset and the messages
+        using Compressed = Layout<BodyLength>; // Followed by the compressed body
+        using Trailer = Layout<Checksum>;      // After the body of a checked message
+    }
 
     class Message : public ByteBuffer
     {
@@ -21,22 +64,37 @@ namespace Lib::Network
 
         enum class MessageType
         {
-            SIMPLE,  // Used only for simple string message
-            DISCOVER // Used for the discover protocol
+            SIMPLE,   // Used only for simple string message
+            DISCOVER, // Used for the discover protocol
+            BATCH,    // A container of other messages
+            CONTROL   // Used to manage the connections
         };
 
         enum class MessageSubType
         {
             SIMPLE = 0,
             DISCOVER_HELLO = 1,   // A message usually sent from the master to workers
-            DISCOVER_RESPONSE = 2 // A response message for the HELLO
+            DISCOVER_RESPONSE = 2, // A response message for the HELLO
+            BATCH = 3,             // Many messages sent together
+            DISCONNECT = 4         // The sender is closing the connection
         };
 
-        const static unsigned int MSG_COUNTER_OFFSET = 0;
-        const static unsigned int MSG_ID_OFFSET = 2;
-        const static unsigned int MSG_TYPE_OFFSET = 4;
-        const static unsigned int MSG_SUBTYPE_OFFSET = 5;
-        const static unsigned int MSG_PROTO_FLAG_OFFSET = 6;
+        const static unsigned int MSG_COUNTER_OFFSET = Schema::Header::OFFSET<Schema::Counter>;
+        const static unsigned int MSG_ID_OFFSET = Schema::Header::OFFSET<Schema::Id>;
+        const static unsigned int MSG_TYPE_OFFSET = Schema::Header::OFFSET<Schema::Type>;
+        const static unsigned int MSG_SUBTYPE_OFFSET = Schema::Header::OFFSET<Schema::SubType>;
+        const static unsigned int MSG_PROTO_FLAG_OFFSET = Schema::Header::OFFSET<Schema::Flags>;
+        const static unsigned int MSG_LENGTH_OFFSET = Schema::Header::OFFSET<Schema::Length>;
+
+        // Number of bytes of the header common to all the messages
+        const static std::size_t NUM_HEAD_BYTES = Schema::Header::SIZE;
+
+        // Bit of the flags byte set when the body is compressed
+        const static uint8_t COMPRESSED_FLAG = 0x01;
+
+        // Bit of the flags byte set when the message ends with a CRC32C
+        const static uint8_t CHECKSUM_FLAG = 0x02;
+        const static std::size_t CHECKSUM_SIZE = Schema::Trailer::SIZE;
 
     protected:
         MessageType _type;
@@ -46,28 +104,35 @@ namespace Lib::Network
         unsigned short _id;
         uint8_t _flag;
 
-        const static std::size_t NUM_HEAD_BYTES = 8;
+        // Writes the header followed by room for bodySize bytes, and
+        // returns the pointer to the (not yet written) body.
+        unsigned char *encodeHeader(const std::size_t bodySize);
+
+        // Checks once that the view holds the header and bodySize more
+        // bytes, decodes the header and returns the pointer to the body.
+        const unsigned char *decodeHeader(ByteBufferView &view, const std::size_t bodySize);
 
-        static void encode_(Message &msg);
-        static void decode_(Message &msg);
+        // Only used by the subclasses when decoding from a view. The storage
+        // is sized for re-encoding but nothing is copied from the view.
+        Message(const std::size_t nofBytes) : ByteBuffer(nofBytes), _flag(0) {};
 
     public:
         Message(const MessageType &type, const MessageSubType &subType,
                 uint16_t id, uint16_t counter, const std::size_t nofBytes)
             : ByteBuffer(nofBytes), _type(type), _subType(subType),
-              _counter(counter), _id(id) {}
+              _counter(counter), _id(id), _flag(0) {}
 
         Message(const MessageType &type, const MessageSubType &subType, uint16_t id,
                 uint16_t counter) : Message(type, subType, id, counter, MAX_MESSAGE_CAPACITY) {}
 
         Message(const unsigned char *buffer, const std::size_t nofBytes)
-            : ByteBuffer(nofBytes)
+            : ByteBuffer(nofBytes), _flag(0)
         {
             put(buffer, nofBytes);
             position(0);
         }
 
-        Message(const ByteBuffer &buffer) : ByteBuffer(buffer) {};
+        Message(const ByteBuffer &buffer) : ByteBuffer(buffer), _flag(0) {};
 
         ~Message() = default;
 
@@ -86,17 +151,115 @@ namespace Lib::Network
         void setMessageProtocol(const MessageProto &proto);
 
         virtual void encode() = 0;
-        virtual void decode() = 0;
+        virtual void decode(ByteBufferView &view) = 0;
+        void decode();
+
+        // The protocol encoded into the flags byte of the header
+        static MessageProto protocolFromFlags(const uint8_t flags);
+
+        // Writes into dst the encoded message with a compressed body. Returns
+        // the size of the compressed message, or 0 if it would not be smaller.
+        static std::size_t compress(const unsigned char *msg, const std::size_t nofBytes,
+                                    unsigned char *dst, const std::size_t capacity);
+
+        // Writes into dst the encoded message with the original body, that
+        // can be decoded as usual. Returns false if the message is corrupted.
+        static bool decompress(const unsigned char *msg, const std::size_t nofBytes, ByteBuffer &dst);
+
+        // The size of a compressed message once decompressed, 0 if it is
+        // corrupted or it would be larger than maxSize
+        static std::size_t getDecompressedSize(const unsigned char *msg, const std::size_t nofBytes,
+                                               const std::size_t maxSize = MAX_FRAME_SIZE);
+
+        // Appends the checksum trailer to the encoded message, and flags it in
+        // the header. There must be room for CHECKSUM_SIZE more bytes after msg.
+        // Returns the size of the message with the trailer.
+        static std::size_t appendChecksum(unsigned char *msg, const std::size_t nofBytes);
+
+        // Like appendChecksum, but the updated header and the trailer are written
+        // apart, so that the body can be sent from where it is. The header must
+        // have room for NUM_HEAD_BYTES bytes and the trailer for CHECKSUM_SIZE.
+        static void prepareChecksum(const unsigned char *msg, const std::size_t nofBytes,
+                                    unsigned char *header, unsigned char *trailer);
+
+        // Verifies the checksum trailer and removes it from the message, that
+        // goes back as it was before appendChecksum. Returns the size of the
+        // message without the trailer, or 0 if the checksum does not match.
+        static std::size_t removeChecksum(unsigned char *msg, const std::size_t nofBytes);
 
         static const MessageSubType fetchMessageSubType(const ByteBuffer_ptr& buffer);
+        static const MessageSubType fetchMessageSubType(const ByteBufferView& view);
     };
 
     // The data received from a socket will be put into a structure
     // divided into the ByteBuffer and the client information
     struct ReceivedData
     {
-        ByteBuffer_ptr data;     // The ByteBuffer with the received bytes
-        struct sockaddr_in *src; // Informations of the sender
+        ByteBuffer_ptr data;         // The ByteBuffer with the received bytes
+        struct sockaddr_in src = {}; // Informations of the sender, a copy as the message outlives the receive
+
+        // When the message went through each stage, in nanoseconds since
+        // the epoch, or 0 if unknown (e.g., no kernel timestamp for TCP).
+        std::uint64_t kernel_ns = 0;     // Received by the kernel
+        std::uint64_t receiver_ns = 0;   // Pushed by the receiver into the listener queue
+        std::uint64_t dispatcher_ns = 0; // Pushed by the dispatcher into the message queue
+        std::uint64_t handler_ns = 0;    // Taken by the handler
+    };
+
+    /**
+     * A message whose body is described by a Schema::Layout. The encoder,
+     * the decoder and the wire size all come from the layout, so a new
+     * message only has to declare its fields and its layout.
+     */
+    template <typename Body>
+    class SchemaMessage : public Message
+    {
+    protected:
+        typename Body::Record _body; // The values of the body fields
+
+    public:
+        static constexpr std::size_t WIRE_SIZE = NUM_HEAD_BYTES + Body::SIZE;
+
+        SchemaMessage(const MessageType &type, const MessageSubType &subType,
+                      const uint16_t id, const uint16_t counter)
+            : Message(type, subType, id, counter, WIRE_SIZE) {};
+
+        SchemaMessage(const ByteBuffer &buffer) : Message(buffer)
+        {
+            decode();
+        }
+
+        SchemaMessage(ByteBufferView view) : Message(WIRE_SIZE)
+        {
+            decode(view);
+        }
+
+        template <typename F>
+        const typename F::type &get() const { return _body.template get<F>(); }
+
+        template <typename F>
+        void set(const typename F::type &value) { _body.template set<F>(value); }
+
+        void encode()
+        {
+            Body::encode(encodeHeader(Body::SIZE), _body, _order == ByteOrder::BigEndian);
+        }
+
+        void decode(ByteBufferView &view)
+        {
+            const unsigned char *src = decodeHeader(view, Body::SIZE);
+            Body::decode(src, _body, view.getByteOrder() == ByteOrder::BigEndian);
+        }
+
+        using Message::decode;
+    };
+
+    // A body-less message telling the receiver that the connection is over
+    class DisconnectMessage : public SchemaMessage<Schema::Empty>
+    {
+    public:
+        DisconnectMessage(const uint16_t id, const uint16_t counter)
+            : SchemaMessage(MessageType::CONTROL, MessageSubType::DISCONNECT, id, counter) {};
     };
 
     class SimpleMessage : public Message
@@ -105,10 +268,13 @@ namespace Lib::Network
         std::string _msg;
 
     public:
+        // Fixed part of the message, the string follows the header
+        static constexpr std::size_t WIRE_SIZE = NUM_HEAD_BYTES;
+
         SimpleMessage(const uint16_t id, const uint16_t counter, std::string &msg)
             : Message(
                   Message::MessageType::SIMPLE, Message::MessageSubType::SIMPLE, id, counter,
-                  NUM_HEAD_BYTES + msg.size()),
+                  WIRE_SIZE + msg.size()),
               _msg(msg) {};
 
         SimpleMessage(const unsigned char *buff, const std::size_t nofBytes)
@@ -122,31 +288,28 @@ namespace Lib::Network
             decode();
         }
 
+        SimpleMessage(ByteBufferView view) : Message(view.getBufferSize())
+        {
+            decode(view);
+        }
+
         ~SimpleMessage() = default;
 
         const std::string &getMessage() const;
         void encode();
-        void decode();
+        void decode(ByteBufferView &view); // An invalid offset table leaves the batch empty
+
+        using Message::decode;
     };
 
-    class DiscoverHelloMessage : public Message
+    class DiscoverHelloMessage : public SchemaMessage<Schema::DiscoverHello>
     {
-    private:
-        unsigned short _udpPort;
-        unsigned short _tcpPort;
-        unsigned int _ipaddr;
-
-        static const std::size_t MSG_NUM_BYTES = 8;
-
     public:
         DiscoverHelloMessage(const uint16_t id, const uint16_t counter)
-            : Message(MessageType::DISCOVER, MessageSubType::DISCOVER_HELLO,
-                      id, counter, NUM_HEAD_BYTES + MSG_NUM_BYTES) {};
+            : SchemaMessage(MessageType::DISCOVER, MessageSubType::DISCOVER_HELLO, id, counter) {};
 
-        DiscoverHelloMessage(const ByteBuffer &buffer) : Message(buffer)
-        {
-            decode();
-        }
+        DiscoverHelloMessage(const ByteBuffer &buffer) : SchemaMessage(buffer) {};
+        DiscoverHelloMessage(ByteBufferView view) : SchemaMessage(view) {};
 
         void setUdpPort(const unsigned short udpPort);
         void setTcpPort(const unsigned short tcpPort);
@@ -155,32 +318,16 @@ namespace Lib::Network
         unsigned short getUdpPort() const;
         unsigned short getTcpPort() const;
         unsigned int getIpAddress() const;
-
-        void encode();
-        void decode();
     };
 
-    class DiscoverResponseMessage : public Message
+    class DiscoverResponseMessage : public SchemaMessage<Schema::DiscoverResponse>
     {
-    private:
-        unsigned short _udpPort;
-        unsigned short _tcpPort;
-        unsigned int _ipaddr;
-        unsigned int _freeRamMb;
-        unsigned int _freeRamKb;
-        uint8_t _cpuUsage;
-
-        static const std::size_t MSG_NUM_BYTES = 20;
-
     public:
         DiscoverResponseMessage(const uint16_t id, const uint16_t counter)
-            : Message(MessageType::DISCOVER, MessageSubType::DISCOVER_RESPONSE,
-                      id, counter, NUM_HEAD_BYTES + MSG_NUM_BYTES) {};
+            : SchemaMessage(MessageType::DISCOVER, MessageSubType::DISCOVER_RESPONSE, id, counter) {};
 
-        DiscoverResponseMessage(const ByteBuffer &buffer) : Message(buffer)
-        {
-            decode();
-        }
+        DiscoverResponseMessage(const ByteBuffer &buffer) : SchemaMessage(buffer) {};
+        DiscoverResponseMessage(ByteBufferView view) : SchemaMessage(view) {};
 
         void setUdpPort(const unsigned short udpPort);
         void setTcpPort(const unsigned short tcpPort);
@@ -196,9 +343,56 @@ namespace Lib::Network
         uint32_t getAvailableMemory_mb() const;
         unsigned long long getAvailableMemory() const;
         uint8_t getCpuUsage() const;
+    };
+
+    /**
+     * A container of already encoded messages, used to send many of them
+     * with a single datagram or segment. The body is the number of messages,
+     * followed by a table with the end offset of each message (relative to
+     * the start of the first one), followed by the messages themselves.
+     */
+    class BatchMessage : public Message
+    {
+    private:
+        std::vector<uint16_t> _offsets;      // The end offset of each message
+        std::vector<unsigned char> _payload; // All the messages one after the other
+
+    public:
+        // Fixed part of the message, the table and the messages follow it
+        static constexpr std::size_t WIRE_SIZE = NUM_HEAD_BYTES + Schema::Batch::SIZE;
+
+        BatchMessage(const uint16_t id, const uint16_t counter, const std::size_t capacity)
+            : Message(MessageType::BATCH, MessageSubType::BATCH, id, counter, capacity) {};
+
+        BatchMessage(const uint16_t id, const uint16_t counter)
+            : BatchMessage(id, counter, MAX_MESSAGE_CAPACITY) {};
+
+        BatchMessage(const ByteBuffer &buffer) : Message(buffer)
+        {
+            decode();
+        }
+
+        BatchMessage(ByteBufferView view) : Message(view.getBufferSize())
+        {
+            decode(view);
+        }
+
+        // The number of bytes of a batch with the given content
+        static std::size_t getEncodedSize(const std::size_t nofMessages, const std::size_t nofBytes);
+        std::size_t getEncodedSize() const;
+
+        // Appends an encoded message, returns false if it does not fit the capacity
+        bool add(const unsigned char *data, const std::size_t nofBytes);
+        bool add(Message &msg);
+
+        std::size_t getNofMessages() const;
+        ByteBufferView getMessage(const std::size_t idx) const;
+        void reset(); // Removes all the messages
 
         void encode();
-        void decode();
+        void decode(ByteBufferView &view);
+
+        using Message::decode;
     };
 }
 
@@ -0,0 +1,115 @@
+#ifndef _MESSAGESCHEMA_HPP
+#define _MESSAGESCHEMA_HPP
+
+#include <cstring>
+#include <cstdint>
+#include <type_traits>
+#include <CommonLib/Communication/ByteSwap.hpp>
+
+namespace Lib::Network::Schema
+{
+    /**
+     * A field of a wire format. Fields are declared as tag types deriving
+     * from Field, that carry the type of the value and its encoding:
+     *
+     *     struct UdpPort : Field<uint16_t> {};
+     *
+     * Values are encoded with the same byte layout of the ByteBuffer.
+     */
+    template <typename T>
+    struct Field
+    {
+        static_assert(std::is_integral<T>::value, "Fields must be integral types");
+        static_assert(sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8,
+                      "Fields must be 1, 2, 4 or 8 bytes wide");
+
+        using type = T;
+        static constexpr std::size_t SIZE = sizeof(T);
+
+        static void store(unsigned char *dst, const T value, bool bigEndian)
+        {
+            if constexpr (SIZE == 1) *dst = static_cast<unsigned char>(value);
+            else if constexpr (SIZE == 2) ByteSwap::store(dst, static_cast<uint16_t>(value), bigEndian);
+            else if constexpr (SIZE == 4) ByteSwap::store(dst, static_cast<uint32_t>(value), bigEndian);
+            else ByteSwap::store(dst, static_cast<uint64_t>(value), bigEndian);
+        }
+
+        static T load(const unsigned char *src, bool bigEndian)
+        {
+            if constexpr (SIZE == 1) return static_cast<T>(*src);
+            else if constexpr (SIZE == 2) return static_cast<T>(ByteSwap::load16(src, bigEndian));
+            else if constexpr (SIZE == 4) return static_cast<T>(ByteSwap::load32(src, bigEndian));
+            else return static_cast<T>(ByteSwap::load64(src, bigEndian));
+        }
+    };
+
+    // N bytes that are written as zeros and ignored when decoding
+    template <std::size_t N>
+    struct Padding
+    {
+        struct type {};
+        static constexpr std::size_t SIZE = N;
+
+        static void store(unsigned char *dst, const type &, bool) { memset(dst, 0, N); }
+        static type load(const unsigned char *, bool) { return {}; }
+    };
+
+    // The storage for the value of a single field of a Record
+    template <typename F>
+    struct Slot
+    {
+        typename F::type value{};
+    };
+
+    /**
+     * A wire format, made of the given fields in the order they appear on
+     * the wire. Offsets and total size are compile-time constants, hence
+     * encode and decode are straight-line code that does not check bounds:
+     * the caller is responsible for checking once that SIZE bytes are there.
+     * Each field (and each Padding size) can appear only once in a Layout.
+     */
+    template <typename... Fields>
+    struct Layout
+    {
+        static constexpr std::size_t SIZE = (Fields::SIZE + ... + 0);
+
+        template <typename F>
+        static constexpr std::size_t offset()
+        {
+            static_assert((std::is_same<F, Fields>::value || ...), "The field is not part of the layout");
+
+            std::size_t off = 0;
+            bool found = false;
+            ((found = found || std::is_same<F, Fields>::value, off += found ? 0 : Fields::SIZE), ...);
+            return off;
+        }
+
+        template <typename F>
+        static constexpr std::size_t OFFSET = offset<F>();
+
+        // The values of all the fields of the layout
+        struct Record : Slot<Fields>...
+        {
+            template <typename F>
+            const typename F::type &get() const { return static_cast<const Slot<F>&>(*this).value; }
+
+            template <typename F>
+            void set(const typename F::type &value) { static_cast<Slot<F>&>(*this).value = value; }
+        };
+
+        // The parameters are unused by the empty layout
+        static void encode([[maybe_unused]] unsigned char *dst, const Record &record,
+                           [[maybe_unused]] bool bigEndian)
+        {
+            (Fields::store(dst + OFFSET<Fields>, record.template get<Fields>(), bigEndian), ...);
+        }
+
+        static void decode([[maybe_unused]] const unsigned char *src, Record &record,
+                           [[maybe_unused]] bool bigEndian)
+        {
+            (record.template set<Fields>(Fields::load(src + OFFSET<Fields>, bigEndian)), ...);
+        }
+    };
+}
+
+#endif
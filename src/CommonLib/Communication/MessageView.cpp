@@ -0,0 +1,96 @@
+#include "MessageView.hpp"
+
+using namespace Lib::Network;
+
+bool MessageHeaderView::isValid() const
+{
+    return _size >= Message::NUM_HEAD_BYTES;
+}
+
+unsigned short MessageHeaderView::getMessageCounter() const
+{
+    return load<Schema::Counter>(Message::MSG_COUNTER_OFFSET);
+}
+
+unsigned short MessageHeaderView::getMessageId() const
+{
+    return load<Schema::Id>(Message::MSG_ID_OFFSET);
+}
+
+Message::MessageType MessageHeaderView::getMessageType() const
+{
+    return static_cast<Message::MessageType>(load<Schema::Type>(Message::MSG_TYPE_OFFSET));
+}
+
+Message::MessageSubType MessageHeaderView::getMessageSubType() const
+{
+    return static_cast<Message::MessageSubType>(load<Schema::SubType>(Message::MSG_SUBTYPE_OFFSET));
+}
+
+Message::MessageProto MessageHeaderView::getMessageProtocol() const
+{
+    return Message::protocolFromFlags(getMessageProtoFlags());
+}
+
+uint8_t MessageHeaderView::getMessageProtoFlags() const
+{
+    return load<Schema::Flags>(Message::MSG_PROTO_FLAG_OFFSET);
+}
+
+uint32_t MessageHeaderView::getMessageLength() const
+{
+    return load<Schema::Length>(Message::MSG_LENGTH_OFFSET);
+}
+
+bool MessageHeaderView::isCompressed() const
+{
+    return (getMessageProtoFlags() & Message::COMPRESSED_FLAG) != 0;
+}
+
+bool MessageHeaderView::hasChecksum() const
+{
+    return (getMessageProtoFlags() & Message::CHECKSUM_FLAG) != 0;
+}
+
+std::size_t BatchMessageView::getEndOffset(const std::size_t idx) const
+{
+    return load<Schema::EndOffset>(BatchMessage::WIRE_SIZE + idx * Schema::EndOffset::SIZE);
+}
+
+bool BatchMessageView::isValid() const
+{
+    if (_size < BatchMessage::WIRE_SIZE || getMessageSubType() != Message::MessageSubType::BATCH)
+    {
+        return false;
+    }
+
+    std::size_t nofMessages = getNofMessages();
+    if (BatchMessage::getEncodedSize(nofMessages, 0) > _size) return false;
+
+    // Offsets must be increasing, and the last one must end the message
+    std::size_t previous = 0;
+    for (std::size_t idx = 0; idx < nofMessages; idx++)
+    {
+        std::size_t current = getEndOffset(idx);
+        if (current < previous) return false;
+        previous = current;
+    }
+
+    return BatchMessage::getEncodedSize(nofMessages, previous) == _size;
+}
+
+std::size_t BatchMessageView::getNofMessages() const
+{
+    return load<Schema::Count>(Message::NUM_HEAD_BYTES);
+}
+
+ByteBufferView BatchMessageView::getMessage(const std::size_t idx) const
+{
+    std::size_t start = (idx == 0) ? 0 : getEndOffset(idx - 1);
+    std::size_t end = getEndOffset(idx);
+
+    const unsigned char *payload = _data + BatchMessage::getEncodedSize(getNofMessages(), 0);
+    ByteBufferView view(payload + start, end - start);
+    view.setByteOrder(_bigEndian ? ByteBuffer::ByteOrder::BigEndian : ByteBuffer::ByteOrder::LittleEndian);
+    return view;
+}
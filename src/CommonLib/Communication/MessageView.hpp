@@ -0,0 +1,100 @@
+#ifndef _MESSAGEVIEW_HPP
+#define _MESSAGEVIEW_HPP
+
+#include <CommonLib/Communication/Message.hpp>
+
+namespace Lib::Network
+{
+    /**
+     * A flyweight over the header of an encoded message. Each field is
+     * loaded lazily from its fixed offset, hence routing and filtering by
+     * type, id, counter or protocol never construct a Message. The view
+     * does not own the bytes, that must outlive the view.
+     *
+     * Accessors do not check the bounds: isValid must be checked once
+     * before reading any field.
+     */
+    class MessageHeaderView
+    {
+    protected:
+        const unsigned char *_data; // The encoded message (not owned)
+        std::size_t _size;          // The number of bytes of the message
+        bool _bigEndian;            // The byte order of the message
+
+        template <typename F>
+        typename F::type load(const std::size_t offset) const
+        {
+            return F::load(_data + offset, _bigEndian);
+        }
+
+    public:
+        MessageHeaderView(const unsigned char *data, const std::size_t nofBytes)
+            : _data(data), _size(nofBytes), _bigEndian(true) {};
+
+        MessageHeaderView(const ByteBufferView &view)
+            : _data(view.getData()), _size(view.getBufferSize()),
+              _bigEndian(view.getByteOrder() == ByteBuffer::ByteOrder::BigEndian) {};
+
+        MessageHeaderView(const ByteBuffer &buffer)
+            : _data(buffer.getData()), _size(buffer.getBufferSize()),
+              _bigEndian(buffer.getByteOrder() == ByteBuffer::ByteOrder::BigEndian) {};
+
+        bool isValid() const;
+
+        unsigned short getMessageCounter() const;
+        unsigned short getMessageId() const;
+        Message::MessageType getMessageType() const;
+        Message::MessageSubType getMessageSubType() const;
+        Message::MessageProto getMessageProtocol() const;
+        uint8_t getMessageProtoFlags() const;
+        uint32_t getMessageLength() const;
+        bool isCompressed() const;
+        bool hasChecksum() const;
+    };
+
+    /**
+     * A flyweight over a whole message described by a Schema::Layout, that
+     * reads the header and any body field in place. Like for the header
+     * view, isValid must be checked once before reading.
+     */
+    template <typename Body>
+    class SchemaMessageView : public MessageHeaderView
+    {
+    public:
+        static constexpr std::size_t WIRE_SIZE = Message::NUM_HEAD_BYTES + Body::SIZE;
+
+        using MessageHeaderView::MessageHeaderView;
+
+        bool isValid() const { return _size >= WIRE_SIZE; }
+
+        template <typename F>
+        typename F::type get() const
+        {
+            return load<F>(Message::NUM_HEAD_BYTES + Body::template OFFSET<F>);
+        }
+    };
+
+    typedef SchemaMessageView<Schema::DiscoverHello> DiscoverHelloView;
+    typedef SchemaMessageView<Schema::DiscoverResponse> DiscoverResponseView;
+
+    /**
+     * A flyweight over a BatchMessage, giving a view over each contained
+     * message without copying it. isValid checks the whole offset table,
+     * so that after it the messages can be read without further checks.
+     */
+    class BatchMessageView : public MessageHeaderView
+    {
+    private:
+        std::size_t getEndOffset(const std::size_t idx) const;
+
+    public:
+        using MessageHeaderView::MessageHeaderView;
+
+        bool isValid() const;
+
+        std::size_t getNofMessages() const;
+        ByteBufferView getMessage(const std::size_t idx) const;
+    };
+}
+
+#endif
@@ -0,0 +1,68 @@
+#include "NeighbourCache.hpp"
+
+using namespace Lib::Network;
+
+std::vector<unsigned int> NeighbourCache::readTable(const std::string &path, const std::string &device)
+{
+    std::vector<unsigned int> neighbours;
+    std::ifstream table(path);
+    if (!table.is_open()) return neighbours;
+
+    // The first line holds the names of the columns
+    std::string line;
+    std::getline(table, line);
+
+    while (std::getline(table, line))
+    {
+        std::istringstream fields(line);
+        std::string ip, hwType, flags, hwAddr, mask, dev;
+        if (!(fields >> ip >> hwType >> flags >> hwAddr >> mask >> dev)) continue;
+        if (!device.empty() && dev != device) continue;
+
+        // Incomplete entries are addresses that did not answer
+        if (!(std::strtoul(flags.c_str(), nullptr, 16) & ATF_COM)) continue;
+
+        struct in_addr addr;
+        if (inet_pton(AF_INET, ip.c_str(), &addr) != 1) continue;
+        neighbours.push_back(ntohl(addr.s_addr));
+    }
+
+    return neighbours;
+}
+
+void NeighbourCache::refresh()
+{
+    std::vector<unsigned int> neighbours = readTable(_path, _device);
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    _neighbours.swap(neighbours);
+}
+
+void NeighbourCache::run()
+{
+    while (this->isRunning())
+    {
+        this->refresh();
+
+        for (int waited = 0; waited < NEIGHBOUR_REFRESH_MS && this->isRunning(); waited += NEIGHBOUR_STOP_CHECK_MS)
+            std::this_thread::sleep_for(std::chrono::milliseconds(NEIGHBOUR_STOP_CHECK_MS));
+    }
+}
+
+bool NeighbourCache::isRunning() const
+{
+    return !this->_sigstop;
+}
+
+void NeighbourCache::stop()
+{
+    this->_sigstop = true;
+    if (this->isJoinable())
+        this->join();
+}
+
+std::vector<unsigned int> NeighbourCache::getNeighbours() const
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    return _neighbours;
+}
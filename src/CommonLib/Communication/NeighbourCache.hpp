@@ -0,0 +1,58 @@
+#ifndef _NEIGHBOURCACHE_HPP
+#define _NEIGHBOURCACHE_HPP
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <cstdlib>
+#include <vector>
+#include <mutex>
+#include <chrono>
+#include <thread>
+#include <memory>
+#include <arpa/inet.h>
+#include <net/if_arp.h>
+#include <CommonLib/Concurrency/Thread.hpp>
+
+#define NEIGHBOUR_TABLE_PATH "/proc/net/arp" // The ARP table of the kernel
+#define NEIGHBOUR_REFRESH_MS 5000            // How often the cache reads the table again
+#define NEIGHBOUR_STOP_CHECK_MS 100          // How often the refreshing thread checks for stop
+
+namespace Lib::Network
+{
+    /**
+     * The IPv4 neighbours of this host known to be alive, i.e., those with
+     * a complete entry in the ARP table of the kernel. The table is read
+     * again in background every NEIGHBOUR_REFRESH_MS once started.
+     */
+    class NeighbourCache : public Concurrency::Thread
+    {
+    private:
+        std::string _path;   // The table to read
+        std::string _device; // Only the neighbours on this device, all if empty
+
+        mutable std::mutex _mutex;             // Guards the neighbours
+        std::vector<unsigned int> _neighbours; // Host byte order addresses
+        bool _sigstop = false;
+
+    public:
+        NeighbourCache(const std::string &device = "", const std::string &path = NEIGHBOUR_TABLE_PATH)
+            : Thread("Neighbour Cache"), _path(path), _device(device) {};
+
+        // The complete entries of the table, in host byte order. Empty if
+        // the table cannot be read.
+        static std::vector<unsigned int> readTable(const std::string &path, const std::string &device);
+
+        void refresh(); // Reads the table again
+        void run() override;
+        bool isRunning() const override;
+        void stop();
+
+        std::vector<unsigned int> getNeighbours() const;
+    };
+
+    typedef std::shared_ptr<NeighbourCache> NeighbourCache_ptr;
+}
+
+#endif
@@ -0,0 +1,199 @@
+#include "OutboundQueue.hpp"
+
+using namespace Lib::Network;
+
+namespace
+{
+    // Errors that only mean the socket buffer is full for now
+    bool wouldBlock(int error)
+    {
+        return error == EAGAIN || error == EWOULDBLOCK || error == ENOBUFS;
+    }
+}
+
+OutboundQueue::OutboundQueue(const std::size_t capacity)
+    : Thread("OutboundQueue"), _entries(std::max<std::size_t>(capacity, 1)), _head(0), _size(0),
+      _fd(-1), _closed(false)
+{
+    memset(&_stats, 0, sizeof(struct OutboundStats));
+}
+
+bool OutboundQueue::push(int fd, const struct iovec *iov, const std::size_t iovcnt, const sockaddr_in *dst)
+{
+    if (_size == _entries.size())
+    {
+        _stats.dropped++;
+        errno = ENOBUFS;
+        return false;
+    }
+
+    // The vector of the slot is reused, it only grows for larger datagrams
+    Entry &entry = _entries[(_head + _size) % _entries.size()];
+    entry.data.clear();
+    for (std::size_t idx = 0; idx < iovcnt; idx++)
+    {
+        const unsigned char *base = (const unsigned char*)iov[idx].iov_base;
+        entry.data.insert(entry.data.end(), base, base + iov[idx].iov_len);
+    }
+
+    entry.dst = *dst;
+    entry.enqueued = std::chrono::steady_clock::now();
+
+    _size++;
+    _stats.queued++;
+
+    // The thread drains the queue as soon as the socket is writable
+    _fd = fd;
+    if (!_started && !_closed) start();
+    _pending.notify_one();
+    return true;
+}
+
+void OutboundQueue::drainLocked(int fd)
+{
+    while (_size > 0)
+    {
+        Entry &entry = _entries[_head];
+        ssize_t result = sendto(fd, entry.data.data(), entry.data.size(), MSG_DONTWAIT,
+                                (struct sockaddr *)&entry.dst, sizeof(entry.dst));
+
+        if (result < 0)
+        {
+            if (errno == EINTR) continue;
+            if (wouldBlock(errno)) return;
+
+            // The datagram cannot be sent at all, the next ones still can
+            std::cerr << "[OutboundQueue] Queued datagram dropped: " << std::strerror(errno) << std::endl;
+            _stats.dropped++;
+        }
+        else
+        {
+            auto delay = std::chrono::steady_clock::now() - entry.enqueued;
+            std::uint64_t delay_us = std::chrono::duration_cast<std::chrono::microseconds>(delay).count();
+            _stats.totalDelay_us += delay_us;
+            _stats.maxDelay_us = std::max(_stats.maxDelay_us, delay_us);
+            _stats.sent++;
+        }
+
+        _head = (_head + 1) % _entries.size();
+        _size--;
+    }
+}
+
+bool OutboundQueue::send(int fd, const unsigned char *buff, const std::size_t n, const sockaddr_in *dst)
+{
+    struct iovec iov;
+    iov.iov_base = const_cast<unsigned char*>(buff);
+    iov.iov_len = n;
+    return sendv(fd, &iov, 1, dst) != Result::DROPPED;
+}
+
+OutboundQueue::Result OutboundQueue::sendv(int fd, const struct iovec *iov, const std::size_t iovcnt,
+                                           const sockaddr_in *dst, const int flags)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    // Older datagrams go first, the new one waits behind them
+    drainLocked(fd);
+    if (_size > 0) return push(fd, iov, iovcnt, dst) ? Result::QUEUED : Result::DROPPED;
+
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(struct msghdr));
+    msg.msg_name = const_cast<struct sockaddr_in*>(dst);
+    msg.msg_namelen = sizeof(struct sockaddr_in);
+    msg.msg_iov = const_cast<struct iovec*>(iov);
+    msg.msg_iovlen = iovcnt;
+
+    ssize_t result;
+    while ((result = sendmsg(fd, &msg, flags | MSG_DONTWAIT)) < 0 && errno == EINTR);
+
+    if (result >= 0)
+    {
+        _stats.sent++;
+        return Result::SENT;
+    }
+
+    if (wouldBlock(errno)) return push(fd, iov, iovcnt, dst) ? Result::QUEUED : Result::DROPPED;
+
+    _stats.dropped++;
+    return Result::DROPPED;
+}
+
+bool OutboundQueue::drain(int fd)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    drainLocked(fd);
+    return _size == 0;
+}
+
+void OutboundQueue::close()
+{
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _closed = true;
+        _pending.notify_one();
+    }
+
+    join();
+}
+
+void OutboundQueue::run()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    while (!_closed)
+    {
+        if (_size == 0)
+        {
+            _pending.wait(lock);
+            continue;
+        }
+
+        // The senders are not held while waiting for the socket
+        struct pollfd pfd;
+        pfd.fd = _fd;
+        pfd.events = POLLOUT;
+
+        lock.unlock();
+        int ready = poll(&pfd, 1, UDP_OUTBOUND_POLL_MS);
+        lock.lock();
+
+        if (_closed) break;
+
+        // A writable socket can still refuse (ENOBUFS), then it is not polled again right away
+        std::size_t size = _size;
+        drainLocked(_fd);
+        if (ready > 0 && _size == size) _pending.wait_for(lock, std::chrono::milliseconds(UDP_OUTBOUND_POLL_MS));
+    }
+}
+
+bool OutboundQueue::isRunning() const
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    return _started && !_closed;
+}
+
+bool OutboundQueue::isEmpty() const
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    return _size == 0;
+}
+
+std::size_t OutboundQueue::getNofPending() const
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    return _size;
+}
+
+std::size_t OutboundQueue::getCapacity() const
+{
+    return _entries.size();
+}
+
+OutboundStats OutboundQueue::getStats() const
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    struct OutboundStats stats = _stats;
+    stats.pending = _size;
+    return stats;
+}
@@ -0,0 +1,117 @@
+#ifndef _OUTBOUNDQUEUE_HPP
+#define _OUTBOUNDQUEUE_HPP
+
+#include <iostream>
+#include <vector>
+#include <mutex>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <cerrno>
+#include <algorithm>
+#include <cstdint>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <arpa/inet.h>
+#include <poll.h>
+#include <CommonLib/Concurrency/Thread.hpp>
+
+#define UDP_OUTBOUND_QUEUE_SIZE 256 // Datagrams waiting for the socket to become writable
+#define UDP_OUTBOUND_FLUSH_MS 100   // How long a closing sender waits for the pending datagrams
+#define UDP_OUTBOUND_POLL_MS 50     // Longest wait of the draining thread for the socket
+
+namespace Lib::Network
+{
+    /**
+     * Statistics of an OutboundQueue. The delay is the time a queued
+     * datagram has waited before leaving, direct sends do not count.
+     */
+    struct OutboundStats
+    {
+        std::size_t sent;            // Number of datagrams given to the kernel
+        std::size_t queued;          // Number of datagrams that had to wait
+        std::size_t dropped;         // Number of datagrams lost, queue full or send error
+        std::size_t pending;         // Number of datagrams still waiting
+        std::uint64_t totalDelay_us; // Sum of the waiting times of the queued datagrams
+        std::uint64_t maxDelay_us;   // Longest waiting time
+    };
+
+    /**
+     * The non-blocking send path of a UDP socket. A datagram is given to
+     * the kernel right away, and only when the socket would block it is
+     * copied into a bounded ring, drained in order as soon as the socket
+     * is writable again. Once the ring is full new datagrams are dropped.
+     *
+     * The queue has a thread, started with the first queued datagram, that
+     * waits for the socket to become writable while datagrams are pending,
+     * so that they leave even if nothing else is sent. It must be closed
+     * before the socket is.
+     */
+    class OutboundQueue : public Concurrency::Thread
+    {
+    public:
+        enum Result
+        {
+            SENT,   // Given to the kernel right away
+            QUEUED, // Copied into the queue, it will leave later
+            DROPPED // Lost, errno tells the reason
+        };
+
+    private:
+        struct Entry
+        {
+            std::vector<unsigned char> data;                // The content of the datagram
+            struct sockaddr_in dst;                         // The destination address
+            std::chrono::steady_clock::time_point enqueued; // When the datagram entered the queue
+        };
+
+        std::vector<Entry> _entries; // The ring of queued datagrams
+        std::size_t _head;           // Position of the oldest datagram
+        std::size_t _size;           // Number of queued datagrams
+        struct OutboundStats _stats; // Counters of the queue
+        int _fd;                     // The socket drained by the thread
+        bool _closed;                // The thread stops, and never starts again
+        mutable std::mutex _mutex;   // Serializes the senders of the same socket
+        std::condition_variable _pending; // Wakes the thread when a datagram is queued
+
+        bool push(int fd, const struct iovec *iov, const std::size_t iovcnt, const struct sockaddr_in *dst);
+
+        // Sends the queued datagrams in order, until the socket would block
+        void drainLocked(int fd);
+
+    public:
+        OutboundQueue(const std::size_t capacity = UDP_OUTBOUND_QUEUE_SIZE);
+        OutboundQueue(const OutboundQueue &other) = delete;
+        ~OutboundQueue()
+        {
+            close();
+        }
+
+        OutboundQueue &operator=(const OutboundQueue &other) = delete;
+
+        // Sends the datagram without blocking, queueing it if needed. Returns
+        // false if it has been dropped, with errno telling the reason.
+        bool send(int fd, const unsigned char *buff, const std::size_t n, const struct sockaddr_in *dst);
+
+        // Sends the segments as a single datagram, with the given sendmsg flags
+        // (e.g., MSG_ZEROCOPY). A queued datagram is a copy of the segments.
+        Result sendv(int fd, const struct iovec *iov, const std::size_t iovcnt,
+                     const struct sockaddr_in *dst, const int flags = 0);
+
+        // Sends the pending datagrams, returns true if none is left
+        bool drain(int fd);
+
+        // Stops the thread, the datagrams still pending are left to flush
+        void close();
+
+        void run() override;
+        bool isRunning() const override;
+
+        bool isEmpty() const;
+        std::size_t getNofPending() const;
+        std::size_t getCapacity() const;
+        struct OutboundStats getStats() const;
+    };
+}
+
+#endif
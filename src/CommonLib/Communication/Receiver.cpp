@@ -2,13 +2,92 @@
 
 using namespace Lib::Network;
 
-struct ReceivedData Receiver::handleReceivedMessages(
-    unsigned char *buff, const std::size_t n, sockaddr_in *src
-) {
+void Receiver::pushReceivedData(const unsigned char *buff, const std::size_t n, const sockaddr_in &src,
+                                const std::uint64_t kernel_ns)
+{
     struct ReceivedData rdata;
-    rdata.data = std::make_shared<ByteBuffer>(buff, n);
+
+    // The bytes are copied into a recycled buffer of the pool
+    rdata.data = _pool->acquire(n);
+    rdata.data->put(buff, n);
+    rdata.data->position(0);
     rdata.src = src;
-    return rdata;
+    rdata.kernel_ns = kernel_ns;
+    rdata.receiver_ns = System::getRealTime_ns();
+    _queue->push(rdata);
+}
+
+ByteBuffer_ptr Receiver::decompress(const unsigned char *buff, const std::size_t n)
+{
+    MessageHeaderView header(buff, n);
+    std::size_t size = Message::getDecompressedSize(buff, n, _maxMessageSize);
+    if (size == 0)
+    {
+        std::cerr << "[Receiver::decompress] Dropped message with id ";
+        std::cerr << header.getMessageId() << ": too large once decompressed" << std::endl;
+        return nullptr;
+    }
+
+    ByteBuffer_ptr msg = _pool->acquire(size);
+    if (!Message::decompress(buff, n, *msg))
+    {
+        std::cerr << "[Receiver::decompress] Dropped corrupted message with id ";
+        std::cerr << header.getMessageId() << std::endl;
+        return nullptr;
+    }
+
+    msg->position(0);
+    return msg;
+}
+
+std::size_t Receiver::removeChecksum(unsigned char *buff, const std::size_t n)
+{
+    MessageHeaderView header(buff, n);
+    std::size_t size = Message::removeChecksum(buff, n);
+
+    if (size == 0)
+    {
+        std::cerr << "[Receiver::removeChecksum] Dropped message with id ";
+        std::cerr << header.getMessageId() << ": wrong checksum" << std::endl;
+    }
+
+    return size;
+}
+
+void Receiver::handleReceivedFrame(const ByteBuffer_ptr &frame, const sockaddr_in &src, const std::uint64_t kernel_ns)
+{
+    MessageHeaderView header(*frame);
+    if (header.isValid() && header.hasChecksum())
+    {
+        std::size_t size = removeChecksum(frame->getData(), frame->getBufferSize());
+        if (size == 0) return;
+        frame->truncate(size);
+    }
+
+    if (header.isValid() && header.isCompressed())
+    {
+        ByteBuffer_ptr msg = decompress(frame->getData(), frame->getBufferSize());
+        if (msg != nullptr) handleReceivedFrame(msg, src, kernel_ns);
+        return;
+    }
+
+    BatchMessageView batch(*frame);
+    if (!batch.isValid())
+    {
+        struct ReceivedData rdata;
+        rdata.data = frame;
+        rdata.src = src;
+        rdata.kernel_ns = kernel_ns;
+        rdata.receiver_ns = System::getRealTime_ns();
+        _queue->push(rdata);
+        return;
+    }
+
+    for (std::size_t idx = 0; idx < batch.getNofMessages(); idx++)
+    {
+        ByteBufferView msg = batch.getMessage(idx);
+        pushReceivedData(msg.getData(), msg.getBufferSize(), src, kernel_ns);
+    }
 }
 
 bool Receiver::hasStopped() const
@@ -21,109 +100,311 @@ void Receiver::stop()
     this->_stopped = true;
 }
 
+UdpReceiver::UdpReceiver(const Concurrency::Queue_ptr<struct ReceivedData> &queue, const ByteBufferPool_ptr &pool,
+                         const UdpSocket &socket, const std::size_t batchSize)
+    : Receiver(queue, pool, MAX_MESSAGE_CAPACITY), _socket(socket),
+      _batchSize(std::max<std::size_t>(1, std::min<std::size_t>(batchSize, UDP_MAX_BATCH_SIZE))),
+      _buffers(_batchSize), _msgs(_batchSize), _iovs(_batchSize), _srcs(_batchSize),
+      _controls(_batchSize * TIMESTAMP_CONTROL_SIZE)
+{
+}
+
 void UdpReceiver::receive()
 {
     // If the sigstop is set to True then return
     if (this->_stopped) return;
 
-    // Creates the buffer that will receives the data and initialize it to 0
-    char buffer[RECVBUFFSIZE];
-    memset(buffer, 0, sizeof(buffer));
-
-    // Initiziale all the datas needed for the reception of a single message
     int fd = this->_socket.getSocketFileDescriptor();
-    struct sockaddr_in src;
-    socklen_t srclen = sizeof(src);
-    ssize_t nofBytes;
-
-    // If the reception has failed, we returns nothing
-    if ((nofBytes = recvfrom(fd, buffer, sizeof(buffer), 0, 
-                (struct sockaddr*)&src, &srclen
-        )) < 0
-    ) {
-        std::cout << "[UdpReceiver::receive] Error when receiving data: ";
-        std::cout << std::strerror(errno) << std::endl;
+
+    while (true)
+    {
+        // Each datagram is received directly into a buffer of the pool,
+        // buffers that have been pushed into the queue are replaced.
+        for (std::size_t idx = 0; idx < _batchSize; idx++)
+        {
+            if (_buffers[idx] == nullptr)
+            {
+                _buffers[idx] = _pool->acquire(RECVBUFFSIZE);
+                _iovs[idx].iov_base = _buffers[idx]->write(RECVBUFFSIZE);
+                _iovs[idx].iov_len = RECVBUFFSIZE;
+            }
+
+            memset(&_msgs[idx], 0, sizeof(struct mmsghdr));
+            _msgs[idx].msg_hdr.msg_name = &_srcs[idx];
+            _msgs[idx].msg_hdr.msg_namelen = sizeof(struct sockaddr_storage);
+            _msgs[idx].msg_hdr.msg_iov = &_iovs[idx];
+            _msgs[idx].msg_hdr.msg_iovlen = 1;
+            _msgs[idx].msg_hdr.msg_control = &_controls[idx * TIMESTAMP_CONTROL_SIZE];
+            _msgs[idx].msg_hdr.msg_controllen = TIMESTAMP_CONTROL_SIZE;
+        }
+
+        int nofMsgs = recvmmsg(fd, _msgs.data(), _batchSize, MSG_DONTWAIT, nullptr);
+        if (nofMsgs < 0)
+        {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) return; // The socket is drained
+
+            std::cout << "[UdpReceiver::receive] Error when receiving data: ";
+            std::cout << std::strerror(errno) << std::endl;
+            return;
+        }
+
+        for (int idx = 0; idx < nofMsgs; idx++)
+        {
+            if (_msgs[idx].msg_hdr.msg_flags & MSG_TRUNC)
+            {
+                std::cerr << "[UdpReceiver::receive] Dropped datagram larger than ";
+                std::cerr << RECVBUFFSIZE << " bytes" << std::endl;
+                continue;
+            }
+
+            // Datagrams of a local socket come from the address it stands for
+            struct sockaddr_in *src = (struct sockaddr_in*)&_srcs[idx];
+            if (_srcs[idx].ss_family == AF_UNIX)
+            {
+                struct sockaddr_in addr;
+                if (!Socket::fromLocalAddress(*(struct sockaddr_un*)&_srcs[idx], _msgs[idx].msg_hdr.msg_namelen, addr))
+                {
+                    memset(&addr, 0, sizeof(struct sockaddr_in));
+                    addr.sin_family = AF_INET;
+                }
+
+                *src = addr;
+            }
+
+            ByteBuffer_ptr buffer = std::move(_buffers[idx]);
+            buffer->truncate(_msgs[idx].msg_len);
+            buffer->position(0);
+            handleReceivedFrame(buffer, *src, Socket::getKernelTimestamp(_msgs[idx].msg_hdr));
+        }
+
+        // Less datagrams than requested, nothing else is waiting
+        if (static_cast<std::size_t>(nofMsgs) < _batchSize) return;
+    }
+}
+
+UringUdpReceiver::UringUdpReceiver(const Concurrency::Queue_ptr<struct ReceivedData> &queue,
+                                   const ByteBufferPool_ptr &pool, const UdpSocket &socket)
+    : Receiver(queue, pool, MAX_MESSAGE_CAPACITY), _socket(socket), _armed(false), _error(0)
+{
+    // Each buffer holds the recvmsg header, the sender address, the kernel timestamp and the datagram
+    std::size_t bufSize = sizeof(struct io_uring_recvmsg_out) + sizeof(struct sockaddr_in)
+                        + TIMESTAMP_CONTROL_SIZE + RECVBUFFSIZE;
+    _buffers.resize(IOURING_RECV_BUFFERS * bufSize);
+    _ring.registerBuffers(_buffers.data(), IOURING_RECV_BUFFERS, bufSize, 0);
+
+    memset(&_msg, 0, sizeof(struct msghdr));
+    _msg.msg_namelen = sizeof(struct sockaddr_in);
+    _msg.msg_controllen = TIMESTAMP_CONTROL_SIZE;
+}
+
+void UringUdpReceiver::arm()
+{
+    struct io_uring_sqe *sqe = _ring.getSqe();
+    if (sqe == nullptr) return;
+
+    sqe->opcode = IORING_OP_RECVMSG;
+    sqe->fd = _socket.getSocketFileDescriptor();
+    sqe->addr = (std::uint64_t)&_msg;
+    sqe->len = 1;
+    sqe->ioprio = IORING_RECV_MULTISHOT;
+    sqe->flags = IOSQE_BUFFER_SELECT;
+    sqe->buf_group = 0;
+    _armed = true;
+}
+
+void UringUdpReceiver::handleCompletion(const struct io_uring_cqe &cqe)
+{
+    // Without the MORE flag the recvmsg has ended and must be submitted again
+    if (!(cqe.flags & IORING_CQE_F_MORE)) _armed = false;
+
+    if (cqe.res < 0)
+    {
+        // Running out of buffers only pauses the reception
+        if (cqe.res == -ENOBUFS) return;
+
+        std::cerr << "[UringUdpReceiver::receive] Error when receiving data: ";
+        std::cerr << std::strerror(-cqe.res) << std::endl;
+        _error = -cqe.res;
+        _stopped = true;
         return;
     }
 
-    // Otherwise we need the user-defined handleReceivedMessages function to
-    // convert, in some way, the received message and put it in the queue.
-    auto result = this->handleReceivedMessages((unsigned char*)buffer, nofBytes, &src);
+    if (!(cqe.flags & IORING_CQE_F_BUFFER)) return;
+
+    unsigned short bufferId = cqe.flags >> IORING_CQE_BUFFER_SHIFT;
+    unsigned char *buffer = _ring.getBuffer(bufferId);
+    struct io_uring_recvmsg_out *out = (struct io_uring_recvmsg_out*)buffer;
+    unsigned char *payload = buffer + sizeof(struct io_uring_recvmsg_out) + _msg.msg_namelen + _msg.msg_controllen;
+
+    if (out->flags & MSG_TRUNC)
+    {
+        std::cerr << "[UringUdpReceiver::receive] Dropped datagram larger than ";
+        std::cerr << RECVBUFFSIZE << " bytes" << std::endl;
+    }
+    else
+    {
+        struct sockaddr_in src;
+        memcpy(&src, buffer + sizeof(struct io_uring_recvmsg_out), sizeof(struct sockaddr_in));
+
+        // The control messages follow the name, as for a plain recvmsg
+        struct msghdr control;
+        memset(&control, 0, sizeof(struct msghdr));
+        control.msg_control = buffer + sizeof(struct io_uring_recvmsg_out) + _msg.msg_namelen;
+        control.msg_controllen = out->controllen;
 
-    // Otherwise push the data into the queue
-    this->_queue->push(result);
+        ByteBuffer_ptr frame = _pool->acquire(out->payloadlen);
+        frame->put(payload, out->payloadlen);
+        frame->position(0);
+        handleReceivedFrame(frame, src, Socket::getKernelTimestamp(control));
+    }
+
+    _ring.recycleBuffer(bufferId);
 }
 
-void TcpReceiver::receive()
+void UringUdpReceiver::receive()
+{
+    // If the sigstop is set to True then return
+    if (this->_stopped) return;
+
+    if (!_armed) arm();
+
+    if (!_ring.submitAndWait(1, IOURING_WAIT_MS))
+    {
+        std::cerr << "[UringUdpReceiver::receive] Error when waiting: " << std::strerror(errno) << std::endl;
+        _error = errno;
+        _stopped = true;
+        return;
+    }
+
+    struct io_uring_cqe cqe;
+    while (!_stopped && _ring.popCqe(cqe)) handleCompletion(cqe);
+}
+
+int UringUdpReceiver::getError() const
 {
-    char buffer[RECVBUFFSIZE];
-    ssize_t nofBytes;
-    struct Socket::SocketInfo si = {true, false, false, false, false, false, 0};
+    return _error;
+}
 
-    while (!this->_stopped)
+bool TcpReceiver::extractFrames()
+{
+    unsigned char header[Message::NUM_HEAD_BYTES];
+
+    // A single read can contain many messages, the last one possibly partial
+    while (_ring.getSize() >= Message::NUM_HEAD_BYTES)
     {
-        // Get the socket info for the client socket
-        Socket::getSocketInfo(_clientfd, &si);
+        _ring.peek(header, sizeof(header));
+        MessageHeaderView view(header, sizeof(header));
+        std::size_t length = view.getMessageLength();
 
-        // Check for any possible errors
-        if (!si.active && si.socket_error)
+        if (length < Message::NUM_HEAD_BYTES || length > MAX_FRAME_SIZE)
         {
-            std::cerr << strerror(si.error) << std::endl;
-            break;
+            std::cerr << "[TcpReceiver::receive] Invalid message length " << length;
+            std::cerr << " on client socket " << _clientfd << std::endl;
+            return false;
         }
 
-        // Check for connection closed
-        if (si.connecition_cld)
+        // Wait for the rest of the message, making room for it if needed
+        if (_ring.getSize() < length)
         {
-            std::cout << "Connection closed on client socket ";
-            std::cout << _clientfd << std::endl;
-            break;
+            _ring.reserve(length);
+            return true;
         }
 
-        if (si.timeout_ela || !si.ready_to_read) continue;
+        if (view.getMessageSubType() == Message::MessageSubType::DISCONNECT)
+        {
+            _ring.consume(length);
+            return false;
+        }
 
-        // Before going on we need to check if during the poll
-        // an external call to stop the received have been made
-        if (this->hasStopped()) break;
+        ByteBuffer_ptr frame = _pool->acquire(length);
+        _ring.read(*frame, length);
+        frame->position(0);
+        handleReceivedFrame(frame, _client);
+    }
 
-        // Initialize the buffer for receiving the data from the socket
-        memset(buffer, 0, sizeof(buffer));
+    return true;
+}
 
-        // Receives the data from the socket. If there was an error when receiving
-        // we need to print the error message and continue with the reception.
-        if ((nofBytes = recv(_clientfd, buffer, sizeof(buffer), 0)) < 0)
+void TcpReceiver::receive()
+{
+    while (!this->_stopped)
+    {
+        // Receives the data directly into the ring buffer
+        ssize_t nofBytes = recv(_clientfd, _ring.getWritePointer(), _ring.getContiguousFreeSpace(), 0);
+        if (nofBytes < 0)
         {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) return; // Nothing more to read
+
             // Take the IP and port of the client
-            unsigned short port = ntohs(_client->sin_port);
-            std::string ipaddr = Socket::addressNumberToString(_client->sin_addr.s_addr, true);
+            unsigned short port = ntohs(_client.sin_port);
+            std::string ipaddr = Socket::addressNumberToString(_client.sin_addr.s_addr, true);
             std::cerr << "[TcpReceiver::receive] Error when receiving from IP ";
             std::cerr << ipaddr << " Port " << port << ": " << std::strerror(errno) << std::endl;
-            continue;
+            break;
         }
 
-        // In the other case, if the number of received bytes is equal
-        // to 0, this means that the client disconnected
-        if (nofBytes == 1 || nofBytes == 0) break;
+        // If the number of received bytes is 0 the client disconnected
+        if (nofBytes == 0) break;
 
-        // Otherwise, we have received something and needs to convert it
-        auto result = this->handleReceivedMessages((unsigned char*)buffer, nofBytes, _client);
-
-        // Push the received message into the queue
-        this->_queue->push(result);
+        // Otherwise push all the complete messages into the queue
+        _ring.commit(nofBytes);
+        if (!extractFrames()) break;
     }
 
     this->_stopped = true;
-    
-    // Close the connection with the client
-    // close(_clientfd);
 }
 
-void TcpReceiver::run()
+int TcpReceiver::getClientSocket() const
+{
+    return _clientfd;
+}
+
+const struct sockaddr_in &TcpReceiver::getClient() const
 {
-    receive();
+    return _client;
 }
 
-bool TcpReceiver::isRunning() const
+void SharedMemoryReceiver::drain(SharedChannel &channel)
 {
-    return !hasStopped();
+    SharedRing &ring = *channel.in;
+    ring.clearWait();
+
+    do
+    {
+        std::size_t nofBytes;
+        const unsigned char *msg;
+        while ((msg = ring.front(nofBytes)) != nullptr)
+        {
+            ByteBuffer_ptr buffer = _pool->acquire(nofBytes);
+            buffer->put(msg, nofBytes);
+            buffer->position(0);
+            ring.pop();
+
+            handleReceivedFrame(buffer, channel.peer);
+        }
+    }
+    while (!ring.prepareWait());
+}
+
+void SharedMemoryReceiver::receive()
+{
+    if (this->_stopped) return;
+
+    SharedChannel *ready[SHM_EPOLL_EVENTS];
+    int nofEvents = _channels->wait(ready, SHM_WAIT_MS);
+    if (nofEvents < 0)
+    {
+        std::cerr << "[SharedMemoryReceiver::receive] Error when waiting: ";
+        std::cerr << std::strerror(errno) << std::endl;
+        this->_stopped = true;
+        return;
+    }
+
+    for (int idx = 0; idx < nofEvents; idx++)
+    {
+        if (ready[idx] == nullptr) _channels->acceptHandshakes();
+        else drain(*ready[idx]);
+    }
 }
@@ -7,9 +7,20 @@
 #include <CommonLib/Concurrency/Thread.hpp>
 #include <CommonLib/Concurrency/Queue.hpp>
 #include <CommonLib/Communication/ByteBuffer.hpp>
+#include <CommonLib/Communication/ByteBufferPool.hpp>
 #include <CommonLib/Communication/Message.hpp>
+#include <CommonLib/Communication/MessageView.hpp>
+#include <CommonLib/Communication/RingBuffer.hpp>
+#include <CommonLib/Communication/IoUring.hpp>
+#include <CommonLib/Communication/SharedRing.hpp>
+#include <CommonLib/System/Latency.hpp>
 
 #define RECVBUFFSIZE 4096
+#define RECVPOOLSIZE 128
+#define TCPRINGSIZE 65536 // Initial size of the reassembly buffer of a TCP connection
+#define IOURING_RECV_BUFFERS 256 // Buffers registered by the UringUdpReceiver, a power of two
+#define IOURING_WAIT_MS 100      // How long the UringUdpReceiver waits for datagrams
+#define SHM_WAIT_MS 100          // How long the SharedMemoryReceiver waits for messages
 
 namespace Lib::Network
 {
@@ -17,13 +28,30 @@ namespace Lib::Network
     {
     protected:
         Concurrency::Queue_ptr<struct ReceivedData> _queue;
+        ByteBufferPool_ptr _pool;     // The pool of the receive buffers
+        std::size_t _maxMessageSize; // Largest message the transport carries, once decompressed
         bool _stopped;
 
-        static struct ReceivedData handleReceivedMessages(unsigned char *buff,
-                                                          const std::size_t n, struct sockaddr_in *src);
+        // Pushes the received message into the queue. A batch is unpacked and
+        // each of its messages is pushed as a single ReceivedData. The checksum,
+        // if any, is verified and removed, and compressed messages are restored.
+        // The kernel timestamp, if known, is carried along with each message.
+        void handleReceivedFrame(const ByteBuffer_ptr &frame, const struct sockaddr_in &src, const std::uint64_t kernel_ns = 0);
+        void pushReceivedData(const unsigned char *buff, const std::size_t n, const struct sockaddr_in &src,
+                              const std::uint64_t kernel_ns = 0);
+
+        // Verifies and removes the checksum trailer, returns 0 if it does not match
+        std::size_t removeChecksum(unsigned char *buff, const std::size_t n);
+
+        // Restores the original body of a compressed message, nullptr if corrupted
+        // or larger than the transport allows. The size claimed by the message is
+        // checked before taking a buffer, as the message is not authenticated.
+        ByteBuffer_ptr decompress(const unsigned char *buff, const std::size_t n);
 
     public:
-        Receiver(const Concurrency::Queue_ptr<struct ReceivedData> &queue) : _queue(queue), _stopped(false) {};
+        Receiver(const Concurrency::Queue_ptr<struct ReceivedData> &queue, const ByteBufferPool_ptr &pool,
+                 const std::size_t maxMessageSize = MAX_FRAME_SIZE)
+            : _queue(queue), _pool(pool), _maxMessageSize(maxMessageSize), _stopped(false) {};
 
         virtual void receive() = 0;
         bool hasStopped() const;
@@ -33,34 +61,108 @@ namespace Lib::Network
     class UdpReceiver : public Receiver
     {
     protected:
-        UdpSocket _socket; // The Udp Socket of the listener
+        UdpSocket _socket;                          // The Udp Socket of the listener
+        std::size_t _batchSize;                     // Maximum number of datagrams for each recvmmsg
+        std::vector<ByteBuffer_ptr> _buffers;       // The pooled buffers the datagrams are received into
+        std::vector<struct mmsghdr> _msgs;          // The headers of the datagrams
+        std::vector<struct iovec> _iovs;            // The storage of each buffer
+        std::vector<struct sockaddr_storage> _srcs; // The sender of each datagram, IPv4 or local
+        std::vector<unsigned char> _controls;       // The kernel timestamp of each datagram
 
     public:
-        UdpReceiver(const Concurrency::Queue_ptr<struct ReceivedData> &queue, const UdpSocket &socket)
-            : Receiver(queue), _socket(socket) {};
+        UdpReceiver(const Concurrency::Queue_ptr<struct ReceivedData> &queue, const ByteBufferPool_ptr &pool,
+                    const UdpSocket &socket, const std::size_t batchSize = UDP_BATCH_SIZE);
 
+        // Receives all the available datagrams, batchSize at a time
         void receive() override;
     };
 
-    class TcpReceiver : public Receiver, public Concurrency::Thread
+    /**
+     * Receives the datagrams through io_uring. A single multishot recvmsg
+     * produces a completion for each datagram, written by the kernel into
+     * one of the registered buffers, hence there is no system call for each
+     * datagram. The content is copied into a buffer of the pool and the
+     * registered buffer is given back to the kernel right away.
+     */
+    class UringUdpReceiver : public Receiver
     {
     protected:
-        TcpSocket _socket;           // The Tcp Socket of the listener
-        int _clientfd;               // Socket file descriptor of accepted client
-        struct sockaddr_in *_client; // Structure containings all client information
+        UdpSocket _socket;                   // The Udp Socket of the listener
+        IoUring _ring;                       // The io_uring instance
+        std::vector<unsigned char> _buffers; // The memory of the registered buffers
+        struct msghdr _msg;                  // Tells the kernel how much room name and control need
+        bool _armed;                         // If the multishot recvmsg is still active
+        int _error;                          // The error that stopped the receiver, if any
 
-    private:
+        // Submits a new multishot recvmsg, when the previous one has ended
+        void arm();
+        void handleCompletion(const struct io_uring_cqe &cqe);
+
+    public:
+        /**
+         * @throw std::runtime_error if the kernel does not support io_uring
+         */
+        UringUdpReceiver(const Concurrency::Queue_ptr<struct ReceivedData> &queue, const ByteBufferPool_ptr &pool,
+                         const UdpSocket &socket);
+
+        // Handles the received datagrams, waiting up to IOURING_WAIT_MS for them
         void receive() override;
-        void run() override;
+        int getError() const;
+    };
+
+    /**
+     * Receives the messages of the peers on the same host from the shared
+     * memory rings, see SharedChannels. Each message is copied once out of
+     * the ring into a buffer of the pool, so that the ring space is given
+     * back to the producer right away.
+     */
+    class SharedMemoryReceiver : public Receiver
+    {
+    protected:
+        SharedChannels_ptr _channels; // The rings shared with the peers
+
+        // Takes all the messages out of the ring of the channel
+        void drain(SharedChannel &channel);
+
+    public:
+        SharedMemoryReceiver(const Concurrency::Queue_ptr<struct ReceivedData> &queue, const ByteBufferPool_ptr &pool,
+                             const SharedChannels_ptr &channels)
+            : Receiver(queue, pool, MAX_MESSAGE_CAPACITY), _channels(channels) {};
+
+        // Handles the incoming messages, waiting up to SHM_WAIT_MS for them
+        void receive() override;
+    };
+
+    /**
+     * The state of a single TCP connection accepted by the TcpListener. It
+     * does not own a thread: the listener calls receive whenever the socket
+     * becomes readable, and closes the connection once hasStopped is true.
+     */
+    class TcpReceiver : public Receiver
+    {
+    protected:
+        int _clientfd;              // Socket file descriptor of accepted client
+        struct sockaddr_in _client; // Structure containings all client information
+        RingBuffer _ring;           // Bytes received but not yet part of a whole message
+
+    private:
+        // Takes all the complete messages out of the ring buffer. Returns
+        // false if the connection has to be closed, either on request of
+        // the client or because the stream is corrupted.
+        bool extractFrames();
 
     public:
         TcpReceiver(
-            const Concurrency::Queue_ptr<struct ReceivedData> &queue, const TcpSocket &socket, 
-            const std::string &name, int clientfd, struct sockaddr_in *client)
-            : Receiver(queue), Thread(name), _socket(socket),
-              _clientfd(clientfd), _client(client) {};
+            const Concurrency::Queue_ptr<struct ReceivedData> &queue, const ByteBufferPool_ptr &pool,
+            int clientfd, const struct sockaddr_in &client)
+            : Receiver(queue, pool), _clientfd(clientfd), _client(client), _ring(TCPRINGSIZE) {};
+
+        // Reads all the available bytes from the non-blocking client socket,
+        // as required by an edge-triggered notification.
+        void receive() override;
 
-        bool isRunning() const override;
+        int getClientSocket() const;
+        const struct sockaddr_in &getClient() const;
     };
 }
 
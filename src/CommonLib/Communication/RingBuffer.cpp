@@ -0,0 +1,119 @@
+#include "RingBuffer.hpp"
+
+using namespace Lib::Network;
+
+namespace
+{
+    std::size_t nextPowerOfTwo(const std::size_t value)
+    {
+        std::size_t result = 1;
+        while (result < value) result <<= 1;
+        return result;
+    }
+}
+
+RingBuffer::RingBuffer(const std::size_t capacity)
+    : _capacity(nextPowerOfTwo(capacity)), _head(0), _tail(0)
+{
+    _data.reset(new unsigned char[_capacity]);
+}
+
+std::size_t RingBuffer::index(const std::size_t pos) const
+{
+    return pos & (_capacity - 1);
+}
+
+std::size_t RingBuffer::getCapacity() const
+{
+    return _capacity;
+}
+
+std::size_t RingBuffer::getSize() const
+{
+    return _tail - _head;
+}
+
+std::size_t RingBuffer::getFreeSpace() const
+{
+    return _capacity - getSize();
+}
+
+bool RingBuffer::isEmpty() const
+{
+    return _head == _tail;
+}
+
+unsigned char *RingBuffer::getWritePointer()
+{
+    return _data.get() + index(_tail);
+}
+
+std::size_t RingBuffer::getContiguousFreeSpace() const
+{
+    return std::min(getFreeSpace(), _capacity - index(_tail));
+}
+
+void RingBuffer::commit(const std::size_t nofBytes)
+{
+    ByteBuffer::checkForOutOfBound(0, nofBytes, getFreeSpace(), "RingBuffer::commit");
+    _tail += nofBytes;
+}
+
+bool RingBuffer::write(const unsigned char *data, const std::size_t nofBytes)
+{
+    if (nofBytes > getFreeSpace()) return false;
+
+    std::size_t first = std::min(nofBytes, _capacity - index(_tail));
+    memcpy(_data.get() + index(_tail), data, first);
+    memcpy(_data.get(), data + first, nofBytes - first);
+    _tail += nofBytes;
+    return true;
+}
+
+void RingBuffer::peek(unsigned char *dst, const std::size_t nofBytes) const
+{
+    ByteBuffer::checkForOutOfBound(0, nofBytes, getSize(), "RingBuffer::peek");
+
+    // The bytes can wrap around the end of the storage
+    std::size_t first = std::min(nofBytes, _capacity - index(_head));
+    memcpy(dst, _data.get() + index(_head), first);
+    memcpy(dst + first, _data.get(), nofBytes - first);
+}
+
+void RingBuffer::read(unsigned char *dst, const std::size_t nofBytes)
+{
+    peek(dst, nofBytes);
+    _head += nofBytes;
+}
+
+void RingBuffer::read(ByteBuffer &dst, const std::size_t nofBytes)
+{
+    ByteBuffer::checkForOutOfBound(0, nofBytes, getSize(), "RingBuffer::read");
+
+    std::size_t first = std::min(nofBytes, _capacity - index(_head));
+    dst.put(_data.get() + index(_head), first);
+    dst.put(_data.get(), nofBytes - first);
+    _head += nofBytes;
+}
+
+void RingBuffer::consume(const std::size_t nofBytes)
+{
+    ByteBuffer::checkForOutOfBound(0, nofBytes, getSize(), "RingBuffer::consume");
+    _head += nofBytes;
+}
+
+void RingBuffer::reserve(const std::size_t nofBytes)
+{
+    if (nofBytes <= _capacity) return;
+
+    // The content is moved at the beginning of the new storage
+    std::size_t size = getSize();
+    std::size_t capacity = nextPowerOfTwo(nofBytes);
+    std::unique_ptr<unsigned char[]> data(new unsigned char[capacity]);
+    peek(data.get(), size);
+
+    _data = std::move(data);
+    _capacity = capacity;
+    _head = 0;
+    _tail = size;
+}
@@ -0,0 +1,58 @@
+#ifndef _RINGBUFFER_HPP
+#define _RINGBUFFER_HPP
+
+#include <iostream>
+#include <memory>
+#include <cstring>
+#include <CommonLib/Communication/ByteBuffer.hpp>
+
+namespace Lib::Network
+{
+    /**
+     * A circular buffer of bytes, used to reassemble the messages of a stream.
+     * Bytes can be written directly into its free space (for instance by recv)
+     * and then committed, while they are read in the same order they have been
+     * written. The capacity is always a power of two, and it can grow without
+     * losing the content.
+     */
+    class RingBuffer
+    {
+    private:
+        std::unique_ptr<unsigned char[]> _data; // The storage
+        std::size_t _capacity;                  // The size of the storage
+        std::size_t _head;                      // Total number of bytes read
+        std::size_t _tail;                      // Total number of bytes written
+
+        std::size_t index(const std::size_t pos) const;
+
+    public:
+        RingBuffer(const std::size_t capacity);
+        RingBuffer(const RingBuffer &other) = delete;
+        ~RingBuffer() = default;
+
+        RingBuffer &operator=(const RingBuffer &other) = delete;
+
+        std::size_t getCapacity() const;
+        std::size_t getSize() const;
+        std::size_t getFreeSpace() const;
+        bool isEmpty() const;
+
+        // The contiguous free space after the last written byte
+        unsigned char *getWritePointer();
+        std::size_t getContiguousFreeSpace() const;
+        void commit(const std::size_t nofBytes); // Marks nofBytes as written
+
+        // Copies the bytes into the free space, returns false if they do not fit
+        bool write(const unsigned char *data, const std::size_t nofBytes);
+
+        void peek(unsigned char *dst, const std::size_t nofBytes) const;
+        void read(unsigned char *dst, const std::size_t nofBytes);
+        void read(ByteBuffer &dst, const std::size_t nofBytes);
+        void consume(const std::size_t nofBytes);
+
+        // Grows the storage so that it can hold at least nofBytes
+        void reserve(const std::size_t nofBytes);
+    };
+}
+
+#endif
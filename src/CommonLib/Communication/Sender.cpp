@@ -7,42 +7,293 @@ bool Sender::sendTo(const std::string &ip, const unsigned short port, Message &m
     // Encode all the fields of the Message into the bytebuffer
     msg.encode();
 
-    // Create the vector of bytes that will contains the buffer
-    std::size_t nofBytes = msg.getBufferSize();
-    unsigned char buff[nofBytes];
-    memset(buff, 0, sizeof(buff));
-    
-    // Fill the byte vector with the content of the buffer 
-    msg.getBuffer(buff, 0, nofBytes);
+    return sendMessage(ip, port, msg.getData(), msg.getBufferSize());
+}
+
+bool Sender::sendTo(const std::string &ip, const unsigned short port, const std::shared_ptr<Message> &msg)
+{
+    msg->encode();
+
+    return sendMessage(ip, port, msg->getData(), msg->getBufferSize(), msg);
+}
+
+bool Sender::sendMessage(const std::string &ip, const unsigned short port, const unsigned char *msg, const std::size_t n,
+                         const ZeroCopyPin &owner)
+{
+    bool compress = _compressionThreshold != 0 && n >= Message::NUM_HEAD_BYTES + _compressionThreshold;
+
+    // A borrowed message cannot be kept alive after the call, it is never zero-copy
+    ZeroCopyPin pin = (_zeroCopyThreshold != 0 && n >= _zeroCopyThreshold) ? owner : nullptr;
+
+    std::size_t size = 0;
+    static thread_local std::vector<unsigned char> scratch;
+
+    if (compress)
+    {
+        if (scratch.size() < n + Message::CHECKSUM_SIZE) scratch.resize(n + Message::CHECKSUM_SIZE);
+        size = Message::compress(msg, n, scratch.data(), n);
+    }
+
+    // Uncompressed messages are sent from where they are, with the
+    // updated header and the checksum as segments apart.
+    if (size == 0)
+    {
+        if (_checksumEnabled) return sendWithChecksum(ip, port, msg, n, pin);
+        if (pin == nullptr) return sendTo(ip, port, const_cast<unsigned char*>(msg), n);
+
+        struct iovec iov;
+        iov.iov_base = const_cast<unsigned char*>(msg);
+        iov.iov_len = n;
+        return sendv(ip, port, &iov, 1, pin);
+    }
+
+    if (_checksumEnabled) size = Message::appendChecksum(scratch.data(), size);
+    return sendTo(ip, port, scratch.data(), size);
+}
+
+bool Sender::sendWithChecksum(const std::string &ip, const unsigned short port,
+                              const unsigned char *msg, const std::size_t n, const ZeroCopyPin &owner)
+{
+    // The segments of a zero-copy send are pinned with the message
+    struct ChecksumSegments local;
+    std::shared_ptr<struct ChecksumSegments> pinned;
+    struct ChecksumSegments *segments = &local;
+    if (owner != nullptr)
+    {
+        pinned = std::make_shared<struct ChecksumSegments>();
+        pinned->owner = owner;
+        segments = pinned.get();
+    }
+
+    Message::prepareChecksum(msg, n, segments->header, segments->trailer);
+
+    struct iovec iov[3];
+    iov[0].iov_base = segments->header;
+    iov[0].iov_len = Message::NUM_HEAD_BYTES;
+    iov[1].iov_base = const_cast<unsigned char*>(msg + Message::NUM_HEAD_BYTES);
+    iov[1].iov_len = n - Message::NUM_HEAD_BYTES;
+    iov[2].iov_base = segments->trailer;
+    iov[2].iov_len = Message::CHECKSUM_SIZE;
+    return sendv(ip, port, iov, 3, pinned);
+}
+
+bool Sender::sendv(const std::string &ip, const unsigned short port,
+                   const struct iovec *iov, const std::size_t iovcnt, const ZeroCopyPin &)
+{
+    static thread_local std::vector<unsigned char> gathered;
+    gathered.clear();
+
+    for (std::size_t idx = 0; idx < iovcnt; idx++)
+    {
+        const unsigned char *base = (const unsigned char*)iov[idx].iov_base;
+        gathered.insert(gathered.end(), base, base + iov[idx].iov_len);
+    }
+
+    return sendTo(ip, port, gathered.data(), gathered.size());
+}
+
+void Sender::setCompressionThreshold(const std::size_t nofBytes)
+{
+    _compressionThreshold = nofBytes;
+}
+
+std::size_t Sender::getCompressionThreshold() const
+{
+    return _compressionThreshold;
+}
+
+void Sender::setChecksumEnabled(const bool enabled)
+{
+    _checksumEnabled = enabled;
+}
+
+bool Sender::isChecksumEnabled() const
+{
+    return _checksumEnabled;
+}
+
+void Sender::setZeroCopyThreshold(const std::size_t nofBytes)
+{
+    _zeroCopyThreshold = nofBytes;
+}
+
+std::size_t Sender::getZeroCopyThreshold() const
+{
+    return _zeroCopyThreshold;
+}
+
+std::uint64_t TcpSender::getKey(const std::string &ip, const unsigned short port)
+{
+    return ((std::uint64_t)Socket::addressStringToNumber(ip) << 16) | port;
+}
+
+TcpSender::Connection_ptr TcpSender::getConnection(const std::string &ip, const unsigned short port, bool &isNew)
+{
+    std::uint64_t key = getKey(ip, port);
+    struct timeval timeout;
+    isNew = false;
+
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        if (_socket.isClosed()) return nullptr;
+
+        // A warm connection becomes the most recently used one
+        auto it = _map.find(key);
+        if (it != _map.end())
+        {
+            _connections.splice(_connections.begin(), _connections, it->second);
+            return *it->second;
+        }
+
+        timeout = _socket.getTimeout();
+    }
+
+    Connection_ptr connection = std::make_shared<Connection>();
+    connection->ip = ip;
+    connection->port = port;
+    connection->socket = std::make_unique<TcpSocket>(_socket.getIpAddress(), 0);
+    connection->socket->setTimeout(timeout.tv_sec, timeout.tv_usec);
+    connection->socket->connectTo(ip, port);
 
-    // Send the message
-    return sendTo(ip, port, buff, nofBytes);
+    if (!connection->socket->isConnected())
+    {
+        std::cerr << "[TcpSender] Connection to " << ip << ":" << port << " failed" << std::endl;
+        return nullptr;
+    }
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    if (_socket.isClosed()) return nullptr;
+
+    // Another send connected to the same destination in the meanwhile,
+    // its connection is kept and the new one is closed on return
+    auto it = _map.find(key);
+    if (it != _map.end())
+    {
+        _connections.splice(_connections.begin(), _connections, it->second);
+        return *it->second;
+    }
+
+    // Make room for the new connection closing the least recently used.
+    // A send still running on it keeps it open until it ends.
+    if (_connections.size() >= _maxNofConnections)
+    {
+        _map.erase(getKey(_connections.back()->ip, _connections.back()->port));
+        _connections.pop_back();
+    }
+
+    _connections.push_front(connection);
+    _map[key] = _connections.begin();
+    isNew = true;
+    return connection;
+}
+
+void TcpSender::closeConnection(const Connection_ptr &connection)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    auto it = _map.find(getKey(connection->ip, connection->port));
+    if (it == _map.end() || *it->second != connection) return;
+
+    _connections.erase(it->second);
+    _map.erase(it);
+}
+
+void TcpSender::closeConnections()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    _map.clear();
+    _connections.clear(); // Each socket is closed once no send uses it
 }
 
 bool TcpSender::sendTo(
     const std::string &ip, const unsigned short port, unsigned char *buff, const std::size_t n
 ) {
-    return _socket.sendTo(ip, port, buff, n);
+    struct iovec iov;
+    iov.iov_base = buff;
+    iov.iov_len = n;
+    return sendv(ip, port, &iov, 1);
+}
+
+bool TcpSender::sendOn(Connection &connection, const struct iovec *iov, const std::size_t iovcnt,
+                       const ZeroCopyPin &pin, const bool checkAlive)
+{
+    std::unique_lock<std::mutex> lock(connection.mutex);
+
+    // A warm connection might have been closed by the other end
+    if (checkAlive && !connection.socket->isAlive()) return false;
+    return connection.socket->sendAllv(iov, iovcnt, pin);
+}
+
+bool TcpSender::sendv(const std::string &ip, const unsigned short port,
+                      const struct iovec *iov, const std::size_t iovcnt, const ZeroCopyPin &pin)
+{
+    bool isNew;
+    Connection_ptr connection = getConnection(ip, port, isNew);
+    if (connection == nullptr) return false;
+    if (sendOn(*connection, iov, iovcnt, pin, !isNew)) return true;
+
+    // A warm connection might have been broken since the last send,
+    // then the message gets another chance on a new connection.
+    int error = errno;
+    closeConnection(connection);
+    if (!isNew)
+    {
+        connection = getConnection(ip, port, isNew);
+        if (connection != nullptr && sendOn(*connection, iov, iovcnt, pin, !isNew)) return true;
+
+        error = errno;
+        if (connection != nullptr) closeConnection(connection);
+    }
+
+    // The error is reported on the socket of the sender
+    std::unique_lock<std::mutex> lock(_mutex);
+    _socket.getSocketInfo()->socket_error = true;
+    _socket.getSocketInfo()->error = error;
+    return false;
 }
 
 void TcpSender::setTimeout(long int sec, long int usec)
 {
+    std::unique_lock<std::mutex> lock(_mutex);
     _socket.setTimeout(sec, usec);
+
+    for (auto &connection : _connections) connection->socket->setTimeout(sec, usec);
 }
 
 void TcpSender::setTimeout(long int sec)
 {
-    _socket.setTimeout(sec);
+    setTimeout(sec, 0);
 }
 
 void TcpSender::disconnect()
 {
-    // If the socket is not connected to any address then returns
-    if (!_socket.isConnected()) return;
-    
-    std::string ip = _socket.getDestinationIp();
-    unsigned short port = _socket.getDestinationPort();
-    sendTo(ip, port, (unsigned char*)"1", 1);
+    std::vector<std::pair<std::string, unsigned short>> destinations;
+
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        for (auto &connection : _connections) destinations.emplace_back(connection->ip, connection->port);
+    }
+
+    // Tells each receiver that no more messages will come
+    for (auto &destination : destinations)
+    {
+        DisconnectMessage msg(0, 0);
+        msg.setMessageProtocol(Message::MessageProto::TCP);
+        Sender::sendTo(destination.first, destination.second, msg);
+    }
+
+    closeConnections();
+}
+
+std::size_t TcpSender::getNofConnections()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    return _connections.size();
+}
+
+bool TcpSender::isConnectedTo(const std::string &ip, const unsigned short port)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    return _map.find(getKey(ip, port)) != _map.end();
 }
 
 bool UdpSender::sendTo(
@@ -54,5 +305,127 @@ bool UdpSender::sendTo(
     dst.sin_port = htons(port);
     inet_pton(AF_INET, ip.c_str(), &dst.sin_addr);
 
+    struct iovec iov;
+    iov.iov_base = buff;
+    iov.iov_len = n;
+    if (sendLocal(&iov, 1, &dst)) return true;
+
     return _socket.send(buff, n, &dst);
 }
+
+bool UdpSender::sendv(const std::string &ip, const unsigned short port,
+                      const struct iovec *iov, const std::size_t iovcnt, const ZeroCopyPin &pin)
+{
+    struct sockaddr_in dst;
+    memset(&dst, 0, sizeof(struct sockaddr_in));
+    dst.sin_family = AF_INET;
+    dst.sin_port = htons(port);
+    inet_pton(AF_INET, ip.c_str(), &dst.sin_addr);
+
+    // Local datagrams are copied anyway, zero-copy does not apply
+    if (sendLocal(iov, iovcnt, &dst)) return true;
+    return _socket.sendv(iov, iovcnt, &dst, pin);
+}
+
+std::size_t UdpSender::sendBatch(const struct Datagram *datagrams, const std::size_t count)
+{
+    static thread_local std::vector<struct mmsghdr> msgs;
+    static thread_local std::vector<struct iovec> iovs;
+    msgs.resize(_batchSize);
+    iovs.resize(_batchSize);
+
+    std::size_t nofSent = 0;
+    while (nofSent < count)
+    {
+        std::size_t nofMsgs = std::min(_batchSize, count - nofSent);
+        for (std::size_t idx = 0; idx < nofMsgs; idx++)
+        {
+            const struct Datagram &datagram = datagrams[nofSent + idx];
+            iovs[idx].iov_base = const_cast<unsigned char*>(datagram.data);
+            iovs[idx].iov_len = datagram.size;
+
+            memset(&msgs[idx], 0, sizeof(struct mmsghdr));
+            msgs[idx].msg_hdr.msg_name = const_cast<struct sockaddr_in*>(&datagram.dst);
+            msgs[idx].msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+            msgs[idx].msg_hdr.msg_iov = &iovs[idx];
+            msgs[idx].msg_hdr.msg_iovlen = 1;
+        }
+
+        // The kernel can send less datagrams than requested
+        int result = _socket.sendBatch(msgs.data(), nofMsgs);
+        if (result <= 0) break;
+        nofSent += result;
+    }
+
+    return nofSent;
+}
+
+bool UdpSender::sendLocal(const struct iovec *iov, const std::size_t iovcnt, const struct sockaddr_in *dst)
+{
+    if (_local == nullptr || !Socket::isLocalAddress(dst->sin_addr)) return false;
+    return _local->sendLocal(iov, iovcnt, dst);
+}
+
+void UdpSender::setLocalTransport(const bool enabled)
+{
+    if (!enabled)
+    {
+        _local = nullptr;
+        return;
+    }
+
+    if (_local != nullptr) return;
+
+    // Named after the bound address, which is what the receivers see
+    struct sockaddr_in addr;
+    socklen_t addrlen = sizeof(struct sockaddr_in);
+    getsockname(_socket.getSocketFileDescriptor(), (struct sockaddr*)&addr, &addrlen);
+    _local = std::make_unique<LocalSocket>(_socket.getIpAddress(), ntohs(addr.sin_port));
+}
+
+bool UdpSender::isLocalTransportEnabled() const
+{
+    return _local != nullptr;
+}
+
+void UdpSender::setBatchSize(const std::size_t batchSize)
+{
+    _batchSize = std::max<std::size_t>(1, std::min<std::size_t>(batchSize, UDP_MAX_BATCH_SIZE));
+}
+
+std::size_t UdpSender::getBatchSize() const
+{
+    return _batchSize;
+}
+
+bool UdpSender::flush(const int timeout_ms)
+{
+    return _socket.flush(timeout_ms);
+}
+
+OutboundStats UdpSender::getOutboundStats() const
+{
+    return _socket.getOutboundStats();
+}
+
+bool SharedMemorySender::sendTo(
+    const std::string &ip, const unsigned short port, unsigned char *buff, const std::size_t n
+) {
+    struct iovec iov;
+    iov.iov_base = buff;
+    iov.iov_len = n;
+    return sendv(ip, port, &iov, 1);
+}
+
+bool SharedMemorySender::sendv(const std::string &ip, const unsigned short port,
+                               const struct iovec *iov, const std::size_t iovcnt, const ZeroCopyPin &)
+{
+    struct sockaddr_in dst;
+    memset(&dst, 0, sizeof(struct sockaddr_in));
+    dst.sin_family = AF_INET;
+    dst.sin_port = htons(port);
+    inet_pton(AF_INET, ip.c_str(), &dst.sin_addr);
+
+    // The segments are copied into the ring, zero-copy does not apply
+    return _channels->send(dst, iov, iovcnt);
+}
@@ -3,42 +3,146 @@
 
 #include <iostream>
 #include <type_traits>
+#include <list>
+#include <mutex>
+#include <memory>
+#include <unordered_map>
 #include <CommonLib/Communication/Socket.hpp>
 #include <CommonLib/Communication/Message.hpp>
+#include <CommonLib/Communication/SharedRing.hpp>
+
+#define TCP_CONNECTION_CACHE_SIZE 16 // Default number of connections kept open by a TcpSender
 
 namespace Lib::Network
 {
+    // A datagram to be sent, as part of a batch
+    struct Datagram
+    {
+        struct sockaddr_in dst;    // The destination address
+        const unsigned char *data; // The content (not owned)
+        std::size_t size;          // The number of bytes
+    };
+
     class Sender
     {
+        protected:
+            std::size_t _compressionThreshold = 0; // Smallest body that is compressed, 0 to disable
+            bool _checksumEnabled = false;         // Appends a CRC32C trailer to each message
+            std::size_t _zeroCopyThreshold = 0;    // Smallest message sent with MSG_ZEROCOPY, 0 to disable
+
+            // The header and the trailer of a zero-copy send, that live as long as its message
+            struct ChecksumSegments
+            {
+                ZeroCopyPin owner;                             // The message
+                unsigned char header[Message::NUM_HEAD_BYTES]; // The header with the checksum flag
+                unsigned char trailer[Message::CHECKSUM_SIZE]; // The checksum
+            };
+
+            // Sends the message with its checksum, without copying the body
+            bool sendWithChecksum(const std::string& ip, const unsigned short port,
+                                  const unsigned char* msg, const std::size_t n, const ZeroCopyPin &owner);
+
         public:
             virtual bool sendTo(const std::string& ip, const unsigned short port, unsigned char* buff, const std::size_t n) = 0;
             virtual void closeSocket() = 0;
             virtual bool isSocketClosed() = 0;
             virtual Socket& getSocket() = 0;
             bool sendTo(const std::string& ip, const unsigned short port, Message& msg);
+
+            // Sends a message shared with the sender, which can then keep it alive
+            // until a zero-copy send is completed. It must not change meanwhile.
+            bool sendTo(const std::string& ip, const unsigned short port, const std::shared_ptr<Message>& msg);
+
+            // Sends the segments as a single message. This implementation gathers
+            // them into a buffer, senders overriding it send them as they are.
+            // With a pin they go with MSG_ZEROCOPY, see UdpSocket::sendv.
+            virtual bool sendv(const std::string& ip, const unsigned short port,
+                               const struct iovec* iov, const std::size_t iovcnt, const ZeroCopyPin &pin = nullptr);
+
+            // Sends an encoded message, compressing it if it is worth it and
+            // appending the checksum if enabled. Only a message with an owner
+            // can go with zero-copy, the owner being pinned until it completes.
+            bool sendMessage(const std::string& ip, const unsigned short port, const unsigned char* msg, const std::size_t n,
+                             const ZeroCopyPin &owner = nullptr);
+
+            void setCompressionThreshold(const std::size_t nofBytes);
+            std::size_t getCompressionThreshold() const;
+            void setChecksumEnabled(const bool enabled);
+            bool isChecksumEnabled() const;
+            void setZeroCopyThreshold(const std::size_t nofBytes);
+            std::size_t getZeroCopyThreshold() const;
     };
 
+    /**
+     * Sends the messages over TCP, keeping the connections open between
+     * sends. The connections are cached by destination (ip, port), up to
+     * a maximum number, above which the least recently used one is closed.
+     * A cached connection found closed by the other end is replaced by a
+     * new one, so that repeated sends to the same destination only cost
+     * a send() on an already established connection.
+     *
+     * The bound socket is the identity of the sender, while the cached
+     * connections use ephemeral ports.
+     */
     class TcpSender : public Sender
     {
         private:
-            TcpSocket _socket; // The socket of the sender
+            // A connection is shared with the sends still using it, so that
+            // it can leave the cache while they are running
+            struct Connection
+            {
+                std::string ip;                    // The destination address
+                unsigned short port;               // The destination port
+                std::unique_ptr<TcpSocket> socket; // The connected socket
+                std::mutex mutex;                  // Serializes the sends on the connection
+            };
+
+            typedef std::shared_ptr<struct Connection> Connection_ptr;
+            typedef std::list<Connection_ptr>::iterator Connection_it;
+
+            TcpSocket _socket;                                     // The socket of the sender
+            std::size_t _maxNofConnections;                        // Maximum number of cached connections
+            std::list<Connection_ptr> _connections;                // The connections, most recently used first
+            std::unordered_map<std::uint64_t, Connection_it> _map; // The connections by destination
+            std::mutex _mutex;                                     // Protects the cache, never held on the network
+
+            static std::uint64_t getKey(const std::string &ip, const unsigned short port);
+
+            // Returns a connection to the destination, either cached or new.
+            // Sets isNew accordingly, returns nullptr on failure. The connect
+            // happens out of the cache lock, so a slow peer does not hold the others.
+            Connection_ptr getConnection(const std::string &ip, const unsigned short port, bool &isNew);
+            void closeConnection(const Connection_ptr &connection); // If it is still cached
+            void closeConnections();
+
+            // Sends on the connection, holding only its own lock
+            bool sendOn(Connection &connection, const struct iovec *iov, const std::size_t iovcnt,
+                        const ZeroCopyPin &pin, const bool checkAlive);
 
         public:
-            TcpSender(const std::string& ip, unsigned short port) : _socket(ip, port) {};
-            TcpSender(const TcpSocket& socket) : _socket(socket) {};
+            TcpSender(const std::string& ip, unsigned short port, const std::size_t nofConnections = TCP_CONNECTION_CACHE_SIZE)
+                : _socket(ip, port), _maxNofConnections(std::max<std::size_t>(nofConnections, 1)) {};
+
+            TcpSender(const TcpSocket& socket, const std::size_t nofConnections = TCP_CONNECTION_CACHE_SIZE)
+                : _socket(socket), _maxNofConnections(std::max<std::size_t>(nofConnections, 1)) {};
+
             ~TcpSender()
             {
                 // close the socket when the sender goes out of scope
-                _socket.closeSocket();
+                closeSocket();
             }
 
             bool sendTo(const std::string& ip, const unsigned short port, 
                 unsigned char* buff, const std::size_t n);
 
+            bool sendv(const std::string& ip, const unsigned short port,
+                       const struct iovec* iov, const std::size_t iovcnt, const ZeroCopyPin &pin = nullptr) override;
+
             using Sender::sendTo;
 
             void closeSocket()
             {
+                closeConnections();
                 _socket.closeSocket();
             }
 
@@ -49,8 +153,14 @@ namespace Lib::Network
 
             void setTimeout(long int sec, long int usec);
             void setTimeout(long int sec);
+
+            // Tells all the connected receivers that no more messages
+            // will come, and closes the connections.
             void disconnect();
 
+            std::size_t getNofConnections();
+            bool isConnectedTo(const std::string &ip, const unsigned short port);
+
             TcpSocket& getSocket() override
             {
                 return _socket;
@@ -66,26 +176,59 @@ namespace Lib::Network
     class UdpSender : public Sender
     {
         private:
-            UdpSocket _socket; // The socket of the Udp Sender
+            UdpSocket _socket;                   // The socket of the Udp Sender
+            std::size_t _batchSize;              // Maximum number of datagrams sent by each system call
+            std::unique_ptr<LocalSocket> _local; // The local socket for the peers on this host, if enabled
+
+            // Sends through the local socket if enabled and the destination
+            // is on this host. False if the datagram has to go through IP.
+            bool sendLocal(const struct iovec* iov, const std::size_t iovcnt, const struct sockaddr_in* dst);
         
         public:
-            UdpSender(const std::string& ip, unsigned short port) : _socket(ip, port) {};
-            UdpSender(const UdpSocket& socket) : _socket(socket) {};
+            UdpSender(const std::string& ip, unsigned short port) : _socket(ip, port), _batchSize(UDP_BATCH_SIZE) {};
+            UdpSender(const UdpSocket& socket) : _socket(socket), _batchSize(UDP_BATCH_SIZE) {};
             ~UdpSender()
             {
                 // Close the socket when the sender goes out of scope
-                _socket.closeSocket();
+                closeSocket();
             }
 
             bool sendTo(
                 const std::string& ip, const unsigned short port, 
                 unsigned char* buff, const std::size_t n);
 
+            bool sendv(const std::string& ip, const unsigned short port,
+                       const struct iovec* iov, const std::size_t iovcnt, const ZeroCopyPin &pin = nullptr) override;
+
             using Sender::sendTo;
 
+            // Sends all the datagrams with as few system calls as possible.
+            // Returns the number of datagrams actually sent.
+            std::size_t sendBatch(const struct Datagram *datagrams, const std::size_t count);
+
+            void setBatchSize(const std::size_t batchSize);
+            std::size_t getBatchSize() const;
+
+            /**
+             * Sends the datagrams to the peers on the same host through the
+             * local socket standing for the address of this sender, when the
+             * destination has one. The others still go through IP.
+             *
+             * @throw std::runtime_error if the local socket cannot be bound
+             */
+            void setLocalTransport(const bool enabled);
+            bool isLocalTransportEnabled() const;
+
+            // Waits up to timeout_ms for the datagrams queued on a full socket
+            bool flush(const int timeout_ms);
+            struct OutboundStats getOutboundStats() const;
+
             void closeSocket()
             {
+                // The datagrams still queued get a last chance to leave
+                if (!_socket.isClosed()) _socket.flush(UDP_OUTBOUND_FLUSH_MS);
                 _socket.closeSocket();
+                _local = nullptr;
             }
 
             bool isSocketClosed()
@@ -103,6 +246,44 @@ namespace Lib::Network
                 _socket.flushSocketError();
             }
     };
+
+    /**
+     * Sends the messages to the peers on the same host through the shared
+     * memory rings, see SharedChannels. Each message is written once into
+     * the ring, directly from its segments.
+     */
+    class SharedMemorySender : public Sender
+    {
+        private:
+            SharedChannels_ptr _channels; // The rings shared with the peers
+
+        public:
+            SharedMemorySender(const SharedChannels_ptr &channels) : _channels(channels) {};
+
+            bool sendTo(
+                const std::string& ip, const unsigned short port,
+                unsigned char* buff, const std::size_t n);
+
+            bool sendv(const std::string& ip, const unsigned short port,
+                       const struct iovec* iov, const std::size_t iovcnt, const ZeroCopyPin &pin = nullptr) override;
+
+            using Sender::sendTo;
+
+            void closeSocket()
+            {
+                _channels->getSocket().closeSocket();
+            }
+
+            bool isSocketClosed()
+            {
+                return _channels->getSocket().isClosed();
+            }
+
+            LocalSocket& getSocket() override
+            {
+                return _channels->getSocket();
+            }
+    };
 }
 
 #endif
\ No newline at end of file
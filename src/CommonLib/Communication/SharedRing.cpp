@@ -0,0 +1,446 @@
+#include "SharedRing.hpp"
+
+using namespace Lib::Network;
+
+namespace
+{
+    const std::size_t HEADER_SIZE = 4096;         // The header takes its own page
+    const std::uint64_t RECORD_HEADER = 8;        // The length and the padding of a record
+    const std::uint32_t WRAP_MARKER = 0xFFFFFFFF; // The rest of the data is skipped
+    const std::size_t HANDSHAKE_FDS = 4;          // Memory and eventfd of both the rings
+
+    std::uint64_t recordSize(const std::size_t nofBytes)
+    {
+        return (RECORD_HEADER + nofBytes + 7) & ~(std::uint64_t)7;
+    }
+}
+
+SharedRing::SharedRing(const std::size_t capacity)
+    : _mapSize(HEADER_SIZE + capacity), _frontSize(0)
+{
+    if (capacity < 2 * RECORD_HEADER || (capacity & (capacity - 1)) != 0)
+    {
+        throw std::invalid_argument("[SharedRing] The capacity must be a power of two");
+    }
+
+    _memfd = memfd_create("disqube-ring", MFD_CLOEXEC);
+    if (_memfd < 0 || ftruncate(_memfd, _mapSize) < 0)
+    {
+        std::cerr << std::strerror(errno) << std::endl;
+        if (_memfd >= 0) close(_memfd);
+        throw std::runtime_error("[SharedRing] Failed creating the shared memory");
+    }
+
+    if ((_eventfd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK)) < 0)
+    {
+        std::cerr << std::strerror(errno) << std::endl;
+        close(_memfd);
+        throw std::runtime_error("[SharedRing] Failed creating the eventfd");
+    }
+
+    map();
+
+    // The new memory is zeroed, only the capacity and the idle consumer are set
+    _header->capacity = capacity;
+    _header->idle.store(1);
+}
+
+SharedRing::SharedRing(int memfd, int eventfd) : _memfd(memfd), _eventfd(eventfd), _frontSize(0)
+{
+    struct stat info;
+    if (fstat(_memfd, &info) < 0 || (std::size_t)info.st_size <= HEADER_SIZE)
+    {
+        close(_memfd);
+        close(_eventfd);
+        throw std::runtime_error("[SharedRing] Invalid shared memory");
+    }
+
+    _mapSize = info.st_size;
+    map();
+
+    std::uint64_t capacity = _header->capacity;
+    if (capacity != _mapSize - HEADER_SIZE || (capacity & (capacity - 1)) != 0)
+    {
+        munmap(_header, _mapSize);
+        close(_memfd);
+        close(_eventfd);
+        throw std::runtime_error("[SharedRing] Invalid shared memory");
+    }
+}
+
+SharedRing::~SharedRing()
+{
+    munmap(_header, _mapSize);
+    close(_memfd);
+    close(_eventfd);
+}
+
+void SharedRing::map()
+{
+    void *memory = mmap(nullptr, _mapSize, PROT_READ | PROT_WRITE, MAP_SHARED, _memfd, 0);
+    if (memory == MAP_FAILED)
+    {
+        std::cerr << std::strerror(errno) << std::endl;
+        close(_memfd);
+        close(_eventfd);
+        throw std::runtime_error("[SharedRing] Failed mapping the shared memory");
+    }
+
+    _header = (SharedRingHeader*)memory;
+    _data = (unsigned char*)memory + HEADER_SIZE;
+}
+
+bool SharedRing::push(const struct iovec *iov, const std::size_t iovcnt)
+{
+    std::size_t nofBytes = 0;
+    for (std::size_t idx = 0; idx < iovcnt; idx++) nofBytes += iov[idx].iov_len;
+    if (nofBytes > getMaxMessageSize()) return false;
+
+    std::uint64_t capacity = _header->capacity;
+    std::uint64_t head = _header->head.load(std::memory_order_acquire);
+    std::uint64_t tail = _header->tail.load(std::memory_order_relaxed);
+    std::uint64_t size = recordSize(nofBytes);
+
+    // A record does not wrap, the end of the data is skipped instead
+    std::uint64_t offset = tail & (capacity - 1);
+    std::uint64_t skip = (capacity - offset < size) ? capacity - offset : 0;
+    if (tail + skip + size - head > capacity) return false;
+
+    if (skip != 0)
+    {
+        memcpy(_data + offset, &WRAP_MARKER, sizeof(std::uint32_t));
+        tail += skip;
+        offset = 0;
+    }
+
+    std::uint32_t length = (std::uint32_t)nofBytes;
+    memcpy(_data + offset, &length, sizeof(std::uint32_t));
+
+    unsigned char *dst = _data + offset + RECORD_HEADER;
+    for (std::size_t idx = 0; idx < iovcnt; idx++)
+    {
+        memcpy(dst, iov[idx].iov_base, iov[idx].iov_len);
+        dst += iov[idx].iov_len;
+    }
+
+    _header->tail.store(tail + size, std::memory_order_release);
+
+    // Pairs with prepareWait: either the consumer sees the new tail,
+    // or this side sees the consumer idle and wakes it up.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (_header->idle.load(std::memory_order_relaxed))
+    {
+        std::uint64_t one = 1;
+        ssize_t result = write(_eventfd, &one, sizeof(one));
+        (void)result;
+    }
+
+    return true;
+}
+
+const unsigned char *SharedRing::front(std::size_t &nofBytes)
+{
+    std::uint64_t capacity = _header->capacity;
+    std::uint64_t head = _header->head.load(std::memory_order_relaxed);
+    std::uint64_t tail = _header->tail.load(std::memory_order_acquire);
+    if (head == tail) return nullptr;
+
+    std::uint64_t offset = head & (capacity - 1);
+    std::uint32_t length;
+    memcpy(&length, _data + offset, sizeof(std::uint32_t));
+
+    if (length == WRAP_MARKER)
+    {
+        head += capacity - offset;
+        _header->head.store(head, std::memory_order_release);
+        if (head == tail) return nullptr;
+
+        offset = 0;
+        memcpy(&length, _data, sizeof(std::uint32_t));
+    }
+
+    _frontSize = recordSize(length);
+    nofBytes = length;
+    return _data + offset + RECORD_HEADER;
+}
+
+void SharedRing::pop()
+{
+    std::uint64_t head = _header->head.load(std::memory_order_relaxed);
+    _header->head.store(head + _frontSize, std::memory_order_release);
+    _frontSize = 0;
+}
+
+bool SharedRing::prepareWait()
+{
+    _header->idle.store(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (!isEmpty())
+    {
+        _header->idle.store(0, std::memory_order_relaxed);
+        return false;
+    }
+
+    return true;
+}
+
+void SharedRing::clearWait()
+{
+    _header->idle.store(0, std::memory_order_relaxed);
+
+    std::uint64_t count;
+    ssize_t result = read(_eventfd, &count, sizeof(count));
+    (void)result;
+}
+
+bool SharedRing::isEmpty() const
+{
+    return _header->head.load(std::memory_order_acquire) == _header->tail.load(std::memory_order_acquire);
+}
+
+std::size_t SharedRing::getCapacity() const
+{
+    return _header->capacity;
+}
+
+std::size_t SharedRing::getMaxMessageSize() const
+{
+    // Larger records could never fit after skipping the end of the data
+    return _header->capacity / 2 - RECORD_HEADER;
+}
+
+int SharedRing::getMemoryFileDescriptor() const
+{
+    return _memfd;
+}
+
+int SharedRing::getEventFileDescriptor() const
+{
+    return _eventfd;
+}
+
+SharedChannels::SharedChannels(const std::string &ip, const unsigned short port, const std::size_t ringSize)
+    : _socket(ip, port), _ringSize(ringSize)
+{
+    struct epoll_event event;
+    event.events = EPOLLIN;
+    event.data.ptr = nullptr;
+
+    _epollfd = epoll_create1(EPOLL_CLOEXEC);
+    if (_epollfd < 0 || epoll_ctl(_epollfd, EPOLL_CTL_ADD, _socket.getSocketFileDescriptor(), &event) < 0)
+    {
+        std::cerr << std::strerror(errno) << std::endl;
+        if (_epollfd >= 0) close(_epollfd);
+        _socket.closeSocket();
+        throw std::runtime_error("[SharedChannels] Failed creating the epoll instance");
+    }
+}
+
+SharedChannels::~SharedChannels()
+{
+    close(_epollfd);
+}
+
+std::uint64_t SharedChannels::getKey(const struct sockaddr_in &peer)
+{
+    return ((std::uint64_t)peer.sin_addr.s_addr << 16) | peer.sin_port;
+}
+
+SharedChannel *SharedChannels::addChannel(std::unique_ptr<SharedChannel> channel)
+{
+    struct epoll_event event;
+    event.events = EPOLLIN;
+    event.data.ptr = channel.get();
+    if (epoll_ctl(_epollfd, EPOLL_CTL_ADD, channel->in->getEventFileDescriptor(), &event) < 0)
+    {
+        std::cerr << "[SharedChannels::addChannel] Failed watching the ring: ";
+        std::cerr << std::strerror(errno) << std::endl;
+        return nullptr;
+    }
+
+    // Two peers sending to each other at once create two channels,
+    // both are received from while only the first is used to send.
+    _outgoing.emplace(getKey(channel->peer), channel.get());
+    _channels.push_back(std::move(channel));
+    return _channels.back().get();
+}
+
+SharedChannel *SharedChannels::connect(const struct sockaddr_in &peer)
+{
+    std::unique_ptr<SharedChannel> channel = std::make_unique<SharedChannel>();
+    channel->peer = peer;
+
+    try
+    {
+        channel->out = std::make_unique<SharedRing>(_ringSize);
+        channel->in = std::make_unique<SharedRing>(_ringSize);
+    }
+    catch (const std::exception &error)
+    {
+        std::cerr << error.what() << std::endl;
+        return nullptr;
+    }
+
+    int fds[HANDSHAKE_FDS] = {
+        channel->out->getMemoryFileDescriptor(), channel->out->getEventFileDescriptor(),
+        channel->in->getMemoryFileDescriptor(), channel->in->getEventFileDescriptor()
+    };
+
+    struct sockaddr_un local;
+    socklen_t locallen = Socket::toLocalAddress(peer, local);
+
+    struct iovec iov;
+    iov.iov_base = const_cast<char*>(SHM_HANDSHAKE);
+    iov.iov_len = sizeof(SHM_HANDSHAKE);
+
+    alignas(struct cmsghdr) unsigned char control[CMSG_SPACE(sizeof(fds))];
+    memset(control, 0, sizeof(control));
+
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(struct msghdr));
+    msg.msg_name = &local;
+    msg.msg_namelen = locallen;
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+
+    struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(fds));
+    memcpy(CMSG_DATA(cmsg), fds, sizeof(fds));
+
+    // The peer gets its own copies of the file descriptors
+    ssize_t result;
+    int fd = _socket.getSocketFileDescriptor();
+    while ((result = sendmsg(fd, &msg, MSG_DONTWAIT | MSG_NOSIGNAL)) < 0 && errno == EINTR);
+    if (result < 0) return nullptr;
+
+    return addChannel(std::move(channel));
+}
+
+bool SharedChannels::send(const struct sockaddr_in &peer, const struct iovec *iov, const std::size_t iovcnt)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    if (_socket.isClosed()) return false;
+
+    auto outgoing = _outgoing.find(getKey(peer));
+    if (outgoing == _outgoing.end())
+    {
+        // The peer may have set up the rings already, without the
+        // receiving thread having noticed it yet
+        lock.unlock();
+        acceptHandshakes();
+        lock.lock();
+        outgoing = _outgoing.find(getKey(peer));
+    }
+
+    SharedChannel *channel = (outgoing != _outgoing.end()) ? outgoing->second : connect(peer);
+    if (channel == nullptr) return false;
+
+    // A full ring is waited for a while, as the consumer may just be slow
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(SHM_SEND_WAIT_MS);
+    while (!channel->out->push(iov, iovcnt))
+    {
+        if (std::chrono::steady_clock::now() >= deadline) return false;
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+
+    return true;
+}
+
+void SharedChannels::acceptHandshakes()
+{
+    // Otherwise a send could find the socket already drained by the listener,
+    // but not the channel yet, and connect a second one to the same peer
+    std::unique_lock<std::mutex> handshakeLock(_handshakeMutex);
+    int fd = _socket.getSocketFileDescriptor();
+
+    while (true)
+    {
+        char payload[sizeof(SHM_HANDSHAKE)];
+        struct iovec iov;
+        iov.iov_base = payload;
+        iov.iov_len = sizeof(payload);
+
+        struct sockaddr_un local;
+        alignas(struct cmsghdr) unsigned char control[CMSG_SPACE(HANDSHAKE_FDS * sizeof(int)) + TIMESTAMP_CONTROL_SIZE];
+
+        struct msghdr msg;
+        memset(&msg, 0, sizeof(struct msghdr));
+        msg.msg_name = &local;
+        msg.msg_namelen = sizeof(local);
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+
+        ssize_t result = recvmsg(fd, &msg, MSG_DONTWAIT | MSG_CMSG_CLOEXEC);
+        if (result < 0)
+        {
+            if (errno == EINTR) continue;
+            return;
+        }
+
+        int fds[HANDSHAKE_FDS];
+        std::size_t nofFds = 0;
+        for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(&msg, cmsg))
+        {
+            if (cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS) continue;
+            nofFds = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+            memcpy(fds, CMSG_DATA(cmsg), std::min(nofFds, HANDSHAKE_FDS) * sizeof(int));
+        }
+
+        struct sockaddr_in peer;
+        bool valid = nofFds == HANDSHAKE_FDS && (std::size_t)result == sizeof(SHM_HANDSHAKE)
+                  && memcmp(payload, SHM_HANDSHAKE, sizeof(SHM_HANDSHAKE)) == 0
+                  && !(msg.msg_flags & MSG_CTRUNC)
+                  && Socket::fromLocalAddress(local, msg.msg_namelen, peer);
+
+        if (!valid)
+        {
+            std::cerr << "[SharedChannels::acceptHandshakes] Dropped invalid handshake" << std::endl;
+            for (std::size_t idx = 0; idx < std::min(nofFds, HANDSHAKE_FDS); idx++) close(fds[idx]);
+            continue;
+        }
+
+        try
+        {
+            // The rings of the peer are mapped in the opposite roles
+            std::unique_ptr<SharedChannel> channel = std::make_unique<SharedChannel>();
+            channel->peer = peer;
+            channel->in = std::make_unique<SharedRing>(fds[0], fds[1]);
+            channel->out = std::make_unique<SharedRing>(fds[2], fds[3]);
+
+            std::unique_lock<std::mutex> lock(_mutex);
+            addChannel(std::move(channel));
+        }
+        catch (const std::runtime_error &error)
+        {
+            std::cerr << error.what() << std::endl;
+        }
+    }
+}
+
+int SharedChannels::wait(SharedChannel **ready, const int timeout_ms)
+{
+    struct epoll_event events[SHM_EPOLL_EVENTS];
+    int nofEvents = epoll_wait(_epollfd, events, SHM_EPOLL_EVENTS, timeout_ms);
+    if (nofEvents < 0) return (errno == EINTR) ? 0 : -1;
+
+    for (int idx = 0; idx < nofEvents; idx++) ready[idx] = (SharedChannel*)events[idx].data.ptr;
+    return nofEvents;
+}
+
+std::size_t SharedChannels::getNofChannels()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    return _channels.size();
+}
+
+LocalSocket &SharedChannels::getSocket()
+{
+    return _socket;
+}
@@ -0,0 +1,169 @@
+#ifndef _SHAREDRING_HPP
+#define _SHAREDRING_HPP
+
+#include <iostream>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <unordered_map>
+#include <cstring>
+#include <cstdint>
+#include <stdexcept>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/eventfd.h>
+#include <sys/epoll.h>
+#include <sys/uio.h>
+#include <CommonLib/Communication/Socket.hpp>
+
+#define SHM_RING_SIZE (1 << 22)     // Default size of each ring, a power of two
+#define SHM_HANDSHAKE "disqube-shm" // Content of the datagram carrying the rings
+#define SHM_SEND_WAIT_MS 100        // How long a send waits for room in a full ring
+#define SHM_EPOLL_EVENTS 64         // Maximum number of events returned by each wait
+
+namespace Lib::Network
+{
+    /**
+     * The part of a ring shared by the two processes. Head and tail live in
+     * different cache lines, as they are written by different processes.
+     */
+    struct SharedRingHeader
+    {
+        alignas(64) std::atomic<std::uint64_t> head; // Total bytes consumed
+        alignas(64) std::atomic<std::uint64_t> tail; // Total bytes produced
+        alignas(64) std::atomic<std::uint32_t> idle; // If the consumer waits for the eventfd
+        std::uint64_t capacity;                      // Size of the data, a power of two
+    };
+
+    /**
+     * A single producer single consumer ring of messages in shared memory,
+     * backed by a memfd. Each message is a record of its length followed by
+     * its bytes, and it never wraps around the end of the data.
+     *
+     * Producer and consumer do not need any system call while both are busy.
+     * The eventfd is written only when the consumer has declared itself idle,
+     * after having found the ring empty.
+     */
+    class SharedRing
+    {
+    private:
+        int _memfd;                // The memory of the ring
+        int _eventfd;              // Wakes up the idle consumer
+        std::size_t _mapSize;      // Size of the mapping
+        SharedRingHeader *_header; // The shared indexes
+        unsigned char *_data;      // The records
+        std::uint64_t _frontSize;  // Size of the record returned by front
+
+        void map();
+
+    public:
+        /**
+         * Creates a new ring whose data has the given size (a power of two).
+         *
+         * @throw std::runtime_error if memfd or eventfd cannot be created
+         */
+        SharedRing(const std::size_t capacity = SHM_RING_SIZE);
+
+        /**
+         * Maps the ring created by another process. The file descriptors
+         * are owned by the ring from now on.
+         *
+         * @throw std::runtime_error if the memory cannot be mapped
+         */
+        SharedRing(int memfd, int eventfd);
+        SharedRing(const SharedRing &other) = delete;
+        ~SharedRing();
+
+        SharedRing &operator=(const SharedRing &other) = delete;
+
+        // Writes the segments as a single message, returns false if there is no room
+        bool push(const struct iovec *iov, const std::size_t iovcnt);
+
+        // The next message, nullptr if the ring is empty. It stays valid until pop.
+        const unsigned char *front(std::size_t &nofBytes);
+        void pop();
+
+        // Declares the consumer idle. Returns false if a message arrived in
+        // the meanwhile, in which case the consumer must not wait.
+        bool prepareWait();
+        void clearWait(); // Consumes the pending wake ups
+
+        bool isEmpty() const;
+        std::size_t getCapacity() const;
+        std::size_t getMaxMessageSize() const;
+        int getMemoryFileDescriptor() const;
+        int getEventFileDescriptor() const;
+    };
+
+    /**
+     * The two rings shared with a peer on the same host, one for each direction.
+     */
+    struct SharedChannel
+    {
+        struct sockaddr_in peer;         // The address the peer stands for
+        std::unique_ptr<SharedRing> out; // Messages to the peer
+        std::unique_ptr<SharedRing> in;  // Messages from the peer
+    };
+
+    /**
+     * The shared memory channels of a process with its peers. The rings are
+     * created by the first of the two sending a message, which passes the
+     * memfd and eventfd of both rings through SCM_RIGHTS, with a datagram to
+     * the LocalSocket of the peer. The peer maps them in the opposite roles.
+     *
+     * Sending is thread safe, while waiting is for a single thread.
+     */
+    class SharedChannels
+    {
+    private:
+        LocalSocket _socket;   // Exchanges the rings with the peers
+        std::size_t _ringSize; // Size of the rings created by this side
+        int _epollfd;          // Watches the socket and the incoming rings
+
+        std::mutex _mutex;          // Guards the channels
+        std::mutex _handshakeMutex; // A handshake is received and mapped as a whole
+        std::vector<std::unique_ptr<SharedChannel>> _channels;
+        std::unordered_map<std::uint64_t, SharedChannel*> _outgoing; // By peer address
+
+        static std::uint64_t getKey(const struct sockaddr_in &peer);
+
+        // Watches the incoming ring of the channel, and uses it to send if
+        // there is no other channel to the same peer
+        SharedChannel *addChannel(std::unique_ptr<SharedChannel> channel);
+        SharedChannel *connect(const struct sockaddr_in &peer);
+
+    public:
+        /**
+         * @throw std::runtime_error if the local socket cannot be bound
+         */
+        SharedChannels(const std::string &ip, const unsigned short port, const std::size_t ringSize = SHM_RING_SIZE);
+        SharedChannels(const SharedChannels &other) = delete;
+        ~SharedChannels();
+
+        SharedChannels &operator=(const SharedChannels &other) = delete;
+
+        // Writes the message into the ring to the peer, creating it if needed.
+        // Returns false if the peer is not reachable or the ring stays full.
+        bool send(const struct sockaddr_in &peer, const struct iovec *iov, const std::size_t iovcnt);
+
+        // Maps the rings of the handshakes received so far. Returns once any
+        // handshake being received by another thread has been mapped too.
+        void acceptHandshakes();
+
+        // Waits up to timeout_ms for incoming messages. Returns the number of
+        // ready events (up to SHM_EPOLL_EVENTS), each one either the socket
+        // (nullptr) or a channel, or -1 on error.
+        int wait(SharedChannel **ready, const int timeout_ms);
+
+        std::size_t getNofChannels();
+        LocalSocket &getSocket();
+    };
+
+    typedef std::shared_ptr<SharedChannels> SharedChannels_ptr;
+}
+
+#endif
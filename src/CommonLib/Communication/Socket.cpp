@@ -3,31 +3,37 @@
 using namespace Lib::Network;
 
 Socket::Socket(
-    const std::string &ip, const unsigned short port, const SocketType &type
+    const std::string &ip, const unsigned short port, const SocketType &type, const bool reusePort
 ) : _ip(ip), _port(port), _type(type)
 {
     // First construct the socket and get the file descriptor
     struct protoent *prot;
-    int sockType;
+    int sockType, domain = AF_INET, protocol = 0;
 
     switch (_type)
     {
         case SocketType::UDP:
             prot = getprotobyname("udp");
             sockType = SOCK_DGRAM;
+            protocol = prot->p_proto;
             break;
         case SocketType::TCP:
             prot = getprotobyname("tcp");
             sockType = SOCK_STREAM;
+            protocol = prot->p_proto;
+            break;
+        case SocketType::UNIX:
+            domain = AF_UNIX;
+            sockType = SOCK_DGRAM;
             break;
         default:
             throw std::invalid_argument(
-                "[Socket] Input type must be either TCP or UDP"
+                "[Socket] Input type must be either TCP, UDP or UNIX"
             );
     }
 
     // Handle socket creation failure
-    if ((_fd = socket(AF_INET, sockType, prot->p_proto)) < 0)
+    if ((_fd = socket(domain, sockType, protocol)) < 0)
     {
         std::cerr << std::strerror(errno) << std::endl;
         throw std::runtime_error("[Socket creation] Failed socket creation: ");
@@ -39,8 +45,8 @@ Socket::Socket(
     _src.sin_port = htons(_port);
     inet_pton(AF_INET, _ip.c_str(), &_src.sin_addr);
 
-#ifdef REUSE_MODE
     int opt = 1;
+#ifdef REUSE_MODE
     if (setsockopt(_fd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt)) < 0)
     {
         std::cerr << std::strerror(errno) << std::endl;
@@ -48,23 +54,45 @@ Socket::Socket(
         throw std::runtime_error("[Socket setsockopt] Failed to set reusable address");
     }
 
-    if (setsockopt(_fd, SOL_SOCKET, SO_REUSEPORT, &opt, sizeof(opt)) < 0)
+    bool reuse = true;
+#else
+    bool reuse = reusePort;
+#endif
+
+    if (reuse && setsockopt(_fd, SOL_SOCKET, SO_REUSEPORT, &opt, sizeof(opt)) < 0)
     {
         std::cerr << std::strerror(errno) << std::endl;
         closeSocket();
         throw std::runtime_error("[Socket setsockopt] Failed to set reusable port");
     }
-#endif
+
+    // Datagrams are stamped by the kernel when they are received. It is only
+    // used to measure the latencies, hence it is not an error if unsupported.
+    // AF_UNIX sockets only honour the plain nanoseconds timestamp.
+    int stamping = SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE;
+    if (_type == SocketType::UDP) setsockopt(_fd, SOL_SOCKET, SO_TIMESTAMPING, &stamping, sizeof(stamping));
+    if (_type == SocketType::UNIX) setsockopt(_fd, SOL_SOCKET, SO_TIMESTAMPNS, &opt, sizeof(opt));
+
+    // Local sockets bind the abstract name of the same address
+    struct sockaddr_un local;
+    socklen_t locallen = toLocalAddress(_src, local);
+    struct sockaddr *addr = (_type == SocketType::UNIX) ? (struct sockaddr*)&local : (struct sockaddr*)&_src;
+    socklen_t addrlen = (_type == SocketType::UNIX) ? locallen : sizeof(_src);
 
     // Try to bind, if it is unsuccessfull than throws an exception
     // and close the socket previously created.
-    if (bind(_fd, (struct sockaddr*)&_src, sizeof(_src)) < 0)
+    if (bind(_fd, addr, addrlen) < 0)
     {
         std::cerr << std::strerror(errno) << std::endl;
         closeSocket();
         throw std::runtime_error("[Socket binding] Binding failed.");
     }
 
+    // With port 0 the kernel picks a free one, which is read back
+    socklen_t srclen = sizeof(_src);
+    if (_port == 0 && _type != SocketType::UNIX && getsockname(_fd, (struct sockaddr*)&_src, &srclen) == 0)
+        _port = ntohs(_src.sin_port);
+
     // Performs some checks at socket creation
     updateSocketInfo();
 }
@@ -86,6 +114,14 @@ bool Socket::isSocketValid() const
 
 void Socket::closeSocket()
 {
+    // The data of the zero-copy sends is released along with the socket
+    if (_zeroCopy && _info.active) waitZeroCopy(ZEROCOPY_WAIT_MS);
+
+    {
+        std::unique_lock<std::mutex> lock(_zcMutex);
+        _zcPending.clear();
+    }
+
     shutdown(_fd, SHUT_RDWR);
     int ret = close(_fd);
     _info.active = false;
@@ -132,6 +168,102 @@ void Socket::flushSocketError()
     _info.error = 0;
 }
 
+bool Socket::prepareZeroCopy()
+{
+    if (_zeroCopy) return true;
+
+    int opt = 1;
+    _zeroCopy = setsockopt(_fd, SOL_SOCKET, SO_ZEROCOPY, &opt, sizeof(opt)) == 0;
+    return _zeroCopy;
+}
+
+void Socket::pinZeroCopy(const std::uint32_t first, const ZeroCopyPin &pin)
+{
+    // A send copied into the queue, or that fell back, did not use any id
+    std::uint32_t count = _zcStats.sent - first;
+    if (count == 0) return;
+
+    _zcPending.push_back({first, count, count, pin});
+}
+
+void Socket::reapZeroCopyLocked()
+{
+    while (_zcStats.completed != _zcStats.sent)
+    {
+        char control[CMSG_SPACE(sizeof(struct sock_extended_err))];
+        struct msghdr msg;
+        memset(&msg, 0, sizeof(struct msghdr));
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+
+        if (recvmsg(_fd, &msg, MSG_ERRQUEUE | MSG_DONTWAIT) < 0) return;
+
+        for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(&msg, cmsg))
+        {
+            struct sock_extended_err *err = (struct sock_extended_err*)CMSG_DATA(cmsg);
+            if (err->ee_errno != 0 || err->ee_origin != SO_EE_ORIGIN_ZEROCOPY) continue;
+
+            // Each notification covers a range of consecutive ids
+            std::uint32_t count = err->ee_data - err->ee_info + 1;
+            _zcStats.completed += count;
+            if (err->ee_code & SO_EE_CODE_ZEROCOPY_COPIED) _zcStats.copied += count;
+
+            // A send is released once all of its sendmsg are completed,
+            // the ids are compared as offsets so that they can wrap around
+            for (auto &pending : _zcPending)
+            {
+                for (std::uint32_t idx = 0; idx < pending.count; idx++)
+                {
+                    if ((std::uint32_t)(pending.first + idx - err->ee_info) < count) pending.remaining--;
+                }
+            }
+        }
+
+        _zcPending.erase(std::remove_if(_zcPending.begin(), _zcPending.end(),
+                                        [](const PendingZeroCopy &pending) { return pending.remaining == 0; }),
+                         _zcPending.end());
+    }
+}
+
+void Socket::reapZeroCopy()
+{
+    std::unique_lock<std::mutex> lock(_zcMutex);
+    reapZeroCopyLocked();
+}
+
+bool Socket::waitZeroCopy(const int timeout_ms)
+{
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(_zcMutex);
+            reapZeroCopyLocked();
+            if (_zcStats.completed == _zcStats.sent) return true;
+        }
+
+        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now()).count();
+
+        if (remaining <= 0) return false;
+
+        // The completions are signaled as errors on the socket
+        struct pollfd pfd;
+        pfd.fd = _fd;
+        pfd.events = 0;
+        if (poll(&pfd, 1, remaining) < 0 && errno != EINTR) return false;
+    }
+}
+
+ZeroCopyStats Socket::getZeroCopyStats() const
+{
+    std::unique_lock<std::mutex> lock(_zcMutex);
+    struct ZeroCopyStats stats = _zcStats;
+    stats.pending = _zcPending.size();
+    return stats;
+}
+
 std::string Socket::addressNumberToString(unsigned int addr, const bool be)
 {
     // If it is in Little-Endian, then convert it to Big-Endian
@@ -267,6 +399,79 @@ std::string Socket::getInterfaceIp(const std::string &interface)
     return addressNumberToString(_addr_i, true);
 }
 
+socklen_t Socket::toLocalAddress(const struct sockaddr_in &addr, struct sockaddr_un &local)
+{
+    memset(&local, 0, sizeof(struct sockaddr_un));
+    local.sun_family = AF_UNIX;
+
+    // The leading zero byte of sun_path puts the name in the abstract namespace
+    int len = snprintf(local.sun_path + 1, sizeof(local.sun_path) - 1, "%s-%08x-%04x", LOCAL_SOCKET_PREFIX,
+                       ntohl(addr.sin_addr.s_addr), ntohs(addr.sin_port));
+
+    return offsetof(struct sockaddr_un, sun_path) + 1 + len;
+}
+
+bool Socket::fromLocalAddress(const struct sockaddr_un &local, const socklen_t len, struct sockaddr_in &addr)
+{
+    std::size_t pathlen = len - offsetof(struct sockaddr_un, sun_path);
+    if (local.sun_family != AF_UNIX || pathlen < 2 || local.sun_path[0] != '\0') return false;
+
+    std::string name(local.sun_path + 1, pathlen - 1);
+    unsigned int ip, port;
+    char prefix[sizeof(LOCAL_SOCKET_PREFIX)];
+    if (sscanf(name.c_str(), "%7[^-]-%8x-%4x", prefix, &ip, &port) != 3) return false;
+    if (strcmp(prefix, LOCAL_SOCKET_PREFIX) != 0) return false;
+
+    memset(&addr, 0, sizeof(struct sockaddr_in));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(ip);
+    addr.sin_port = htons((unsigned short)port);
+    return true;
+}
+
+bool Socket::isLocalAddress(const struct in_addr &addr)
+{
+    if ((ntohl(addr.s_addr) >> 24) == 127) return true;
+
+    // The addresses of the interfaces are read only once
+    static const std::unordered_set<std::uint32_t> addresses = []()
+    {
+        std::unordered_set<std::uint32_t> result;
+        struct ifaddrs *ifaddr;
+        if (getifaddrs(&ifaddr) < 0) return result;
+
+        for (struct ifaddrs *ifa = ifaddr; ifa != nullptr; ifa = ifa->ifa_next)
+        {
+            if (ifa->ifa_addr == nullptr || ifa->ifa_addr->sa_family != AF_INET) continue;
+            result.insert(((struct sockaddr_in*)ifa->ifa_addr)->sin_addr.s_addr);
+        }
+
+        freeifaddrs(ifaddr);
+        return result;
+    }();
+
+    return addresses.find(addr.s_addr) != addresses.end();
+}
+
+std::uint64_t Socket::getKernelTimestamp(const struct msghdr &msg)
+{
+    struct cmsghdr *cmsg;
+    for (cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(const_cast<struct msghdr*>(&msg), cmsg))
+    {
+        if (cmsg->cmsg_level != SOL_SOCKET) continue;
+
+        // The software timestamp is the first one, the others are for hardware
+        struct timespec stamp;
+        if (cmsg->cmsg_type == SCM_TIMESTAMPING || cmsg->cmsg_type == SCM_TIMESTAMPNS)
+        {
+            memcpy(&stamp, CMSG_DATA(cmsg), sizeof(stamp));
+            return (std::uint64_t)stamp.tv_sec * 1000000000ULL + stamp.tv_nsec;
+        }
+    }
+
+    return 0;
+}
+
 std::string Socket::getBroadcastIp(const std::string& interface)
 {
     int sockfd = socket(AF_INET, SOCK_DGRAM, 0);
@@ -426,29 +631,161 @@ bool TcpSocket::sendTo(const std::string &ip, const unsigned short port, unsigne
 
     // Check if the connection was successfull, then send
     if (!isConnected()) return false;
-    if (send(_fd, buff, n, 0) < 0)
+
+    return sendAll(buff, n);
+}
+
+bool TcpSocket::sendAll(unsigned char *buff, const std::size_t n)
+{
+    struct iovec iov;
+    iov.iov_base = buff;
+    iov.iov_len = n;
+    return sendAllv(&iov, 1);
+}
+
+bool TcpSocket::sendAllv(const struct iovec *iov, const std::size_t iovcnt, const ZeroCopyPin &pin)
+{
+    // The segments are consumed as they are sent, on a copy of their descriptors
+    static thread_local std::vector<struct iovec> segments;
+    segments.assign(iov, iov + iovcnt);
+
+    int flags = MSG_NOSIGNAL;
+    std::unique_lock<std::mutex> lock(_zcMutex, std::defer_lock);
+    if (pin != nullptr && prepareZeroCopy())
+    {
+        flags |= MSG_ZEROCOPY;
+        lock.lock();
+        reapZeroCopyLocked();
+    }
+
+    std::uint32_t first = _zcStats.sent;
+
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(struct msghdr));
+    msg.msg_iov = segments.data();
+    msg.msg_iovlen = segments.size();
+
+    // Large messages can be sent in many pieces, loop until all bytes are gone
+    while (msg.msg_iovlen > 0)
+    {
+        ssize_t result = sendmsg(_fd, &msg, flags);
+        if (result < 0)
+        {
+            if (errno == EINTR) continue;
+
+            // What has been sent so far stays pinned until it is completed
+            _info.socket_error = true;
+            _info.error = errno;
+            std::cerr << "[TcpSender] Sent was unsuccessful: " << std::strerror(errno) << std::endl;
+            if (flags & MSG_ZEROCOPY) pinZeroCopy(first, pin);
+            return false;
+        }
+
+        // The kernel numbers each sendmsg, even when it sends only a part
+        if (flags & MSG_ZEROCOPY) _zcStats.sent++;
+
+        // Skip the segments already sent, and what was sent of the next one
+        std::size_t nofSent = result;
+        while (msg.msg_iovlen > 0 && nofSent >= msg.msg_iov->iov_len)
+        {
+            nofSent -= msg.msg_iov->iov_len;
+            msg.msg_iov++;
+            msg.msg_iovlen--;
+        }
+
+        if (msg.msg_iovlen > 0)
+        {
+            msg.msg_iov->iov_base = (unsigned char*)msg.msg_iov->iov_base + nofSent;
+            msg.msg_iov->iov_len -= nofSent;
+        }
+    }
+
+    if (flags & MSG_ZEROCOPY) pinZeroCopy(first, pin);
+    return true;
+}
+
+bool TcpSocket::isAlive()
+{
+    if (!_connected || !_info.active) return false;
+
+    struct pollfd pfd;
+    pfd.fd = _fd;
+    pfd.events = POLLIN | POLLRDHUP;
+    if (poll(&pfd, 1, 0) < 0) return false;
+
+    // The zero-copy completions are signaled as errors too, once read
+    // only an actual error is left
+    if ((pfd.revents & POLLERR) && _zeroCopy)
+    {
+        reapZeroCopy();
+        if (poll(&pfd, 1, 0) < 0) return false;
+    }
+
+    if (pfd.revents & (POLLERR | POLLHUP | POLLNVAL | POLLRDHUP)) return false;
+
+    // The other end never sends data back, readable means closed
+    char byte;
+    if ((pfd.revents & POLLIN) && recv(_fd, &byte, 1, MSG_PEEK | MSG_DONTWAIT) == 0) return false;
+
+    return true;
+}
+
+int UdpSocket::sendBatch(struct mmsghdr *msgs, const std::size_t count)
+{
+    int nofSent;
+    while ((nofSent = sendmmsg(_fd, msgs, count, 0)) < 0 && errno == EINTR);
+
+    if (nofSent < 0)
+    {
+        _info.socket_error = true;
+        _info.error = errno;
+        std::cerr << "[UdpSender] Batch sent was unsuccessful: " << std::strerror(errno) << std::endl;
+    }
+
+    return nofSent;
+}
+
+void UdpSocket::closeSocket()
+{
+    _outbound->close();
+    Socket::closeSocket();
+}
+
+bool UdpSocket::send(unsigned char *buff, const std::size_t n, sockaddr_in *dst)
+{
+    // A closed socket cannot send anything
+    if (!_info.active) return false;
+
+    // No poll before sending, a full socket buffer is handled by the queue
+    if (!_outbound->send(_fd, buff, n, dst))
     {
         _info.socket_error = true;
         _info.error = errno;
-        std::cerr << "[TcpSender] Sent was unsuccessful: " << std::strerror(errno) << std::endl;
+        std::cerr << "[UdpSender] Sent was unsuccessful: " << std::strerror(errno) << std::endl;
         return false;
     }
 
     return true;
 }
 
-bool UdpSocket::send(unsigned char *buff, const std::size_t n, sockaddr_in *dst)
+bool UdpSocket::sendv(const struct iovec *iov, const std::size_t iovcnt, sockaddr_in *dst, const ZeroCopyPin &pin)
 {
-    updateSocketInfo(); // Socket sanity check
+    // A closed socket cannot send anything
+    if (!_info.active) return false;
 
-    // Check for the socket being active, ready to write and with no errors
-    if (!(_info.active && _info.ready_to_write) || _info.socket_error)
+    // The lock keeps the ids in the order of the sendmsg
+    int flags = 0;
+    std::unique_lock<std::mutex> lock(_zcMutex, std::defer_lock);
+    if (pin != nullptr && prepareZeroCopy())
     {
-        return false;   
+        flags = MSG_ZEROCOPY;
+        lock.lock();
+        reapZeroCopyLocked();
     }
 
-    // Otherwise we can send and check for possible errors
-    if (sendto(_fd, buff, n, 0, (struct sockaddr *)dst, sizeof(*dst)) < 0)
+    OutboundQueue::Result result = _outbound->sendv(_fd, iov, iovcnt, dst, flags);
+
+    if (result == OutboundQueue::Result::DROPPED)
     {
         _info.socket_error = true;
         _info.error = errno;
@@ -456,5 +793,79 @@ bool UdpSocket::send(unsigned char *buff, const std::size_t n, sockaddr_in *dst)
         return false;
     }
 
+    // A queued datagram is a copy, only a direct send needs a completion
+    if (result == OutboundQueue::Result::SENT && flags != 0)
+    {
+        _zcStats.sent++;
+        pinZeroCopy(_zcStats.sent - 1, pin);
+    }
+
     return true;
 }
+
+bool UdpSocket::flush(const int timeout_ms)
+{
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+
+    while (_info.active && !_outbound->drain(_fd))
+    {
+        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now()).count();
+
+        if (remaining <= 0) return false;
+
+        // Wait for the socket to be writable again
+        struct pollfd pfd;
+        pfd.fd = _fd;
+        pfd.events = POLLOUT;
+        int ready = poll(&pfd, 1, remaining);
+        if (ready < 0 && errno != EINTR) return false;
+
+        // The zero-copy completions wake the poll up as errors
+        if (ready > 0 && (pfd.revents & POLLERR)) reapZeroCopy();
+    }
+
+    return _outbound->isEmpty();
+}
+
+OutboundStats UdpSocket::getOutboundStats() const
+{
+    return _outbound->getStats();
+}
+
+bool UdpSocket::enableBroadcast()
+{
+    int opt = 1;
+    if (setsockopt(_fd, SOL_SOCKET, SO_BROADCAST, &opt, sizeof(opt)) < 0) return false;
+
+    // A socket bound to the wildcard address leaves the choice to the routes
+    if (_src.sin_addr.s_addr == htonl(INADDR_ANY)) return true;
+    return setsockopt(_fd, IPPROTO_IP, IP_MULTICAST_IF, &_src.sin_addr, sizeof(_src.sin_addr)) == 0;
+}
+
+bool UdpSocket::joinMulticastGroup(const std::string &group, const std::string &interfaceIp) const
+{
+    struct ip_mreq mreq;
+    memset(&mreq, 0, sizeof(struct ip_mreq));
+    if (inet_pton(AF_INET, group.c_str(), &mreq.imr_multiaddr) != 1) return false;
+    if (inet_pton(AF_INET, interfaceIp.c_str(), &mreq.imr_interface) != 1) return false;
+
+    return setsockopt(_fd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq, sizeof(mreq)) == 0;
+}
+
+bool LocalSocket::sendLocal(const struct iovec *iov, const std::size_t iovcnt, const struct sockaddr_in *dst)
+{
+    struct sockaddr_un local;
+    socklen_t locallen = toLocalAddress(*dst, local);
+
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(struct msghdr));
+    msg.msg_name = &local;
+    msg.msg_namelen = locallen;
+    msg.msg_iov = const_cast<struct iovec*>(iov);
+    msg.msg_iovlen = iovcnt;
+
+    ssize_t result;
+    while ((result = sendmsg(_fd, &msg, MSG_DONTWAIT | MSG_NOSIGNAL)) < 0 && errno == EINTR);
+    return result >= 0;
+}
@@ -7,6 +7,7 @@
 #include <netdb.h>
 #include <unistd.h>
 #include <string>
+#include <vector>
 #include <cstring>
 #include <stdexcept>
 #include <linux/if.h>
@@ -16,12 +17,45 @@
 #include <math.h>
 #include <sys/select.h>
 #include <poll.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <ifaddrs.h>
+#include <unordered_set>
+#include <linux/errqueue.h>
+#include <linux/net_tstamp.h>
+#include <memory>
+#include <mutex>
+#include <chrono>
+#include <algorithm>
+#include <CommonLib/Communication/OutboundQueue.hpp>
 
 #define TCPRECONNECTIONS 5
 #define TCPTIMEOUT 1
+#define UDP_BATCH_SIZE 64      // Default number of datagrams moved by each recvmmsg/sendmmsg
+#define UDP_MAX_BATCH_SIZE 1024 // Kernel limit of datagrams for each recvmmsg/sendmmsg
+#define ZEROCOPY_WAIT_MS 1000   // How long a closing socket waits for the kernel to release the zero-copy data
+#define LOCAL_SOCKET_PREFIX "disqube" // Prefix of the abstract AF_UNIX names of the local sockets
+#define TIMESTAMP_CONTROL_SIZE CMSG_SPACE(sizeof(struct scm_timestamping)) // Room for the receive timestamp
 
 namespace Lib::Network
 {
+    /**
+     * The sends with MSG_ZEROCOPY of a socket. The kernel numbers each sendmsg
+     * with MSG_ZEROCOPY, and completes it when it does not need the data
+     * anymore. A completion can also tell that the kernel copied the data
+     * anyway, as it happens on loopback.
+     */
+    struct ZeroCopyStats
+    {
+        std::uint32_t sent;      // Number of zero-copy sendmsg, i.e., the next notification id
+        std::uint32_t completed; // Number of completed zero-copy sendmsg
+        std::uint32_t copied;    // Number of them for which the kernel made a copy
+        std::uint32_t pending;   // Number of sends whose data is still pinned
+    };
+
+    // Keeps the data of a zero-copy send alive until the kernel releases it
+    typedef std::shared_ptr<const void> ZeroCopyPin;
+
     class Socket
     {
     public:
@@ -62,6 +96,30 @@ namespace Lib::Network
         int _fd;                 // Socket file descriptor
         SocketType _type;        // The type of the socket (UDP, TCP)
 
+        // A zero-copy send still in progress, it used the notification ids
+        // from first to first + count - 1, one for each sendmsg
+        struct PendingZeroCopy
+        {
+            std::uint32_t first;     // The id of the first sendmsg
+            std::uint32_t count;     // The number of sendmsg
+            std::uint32_t remaining; // The number of them not completed yet
+            ZeroCopyPin pin;         // The data of the send
+        };
+
+        bool _zeroCopy = false;                  // If SO_ZEROCOPY has been enabled
+        struct ZeroCopyStats _zcStats = {};      // The zero-copy sends and their completions
+        std::vector<PendingZeroCopy> _zcPending; // The sends whose data is pinned, oldest first
+        mutable std::mutex _zcMutex;             // Protects the zero-copy state, held during the sendmsg
+
+        // Enables SO_ZEROCOPY the first time, returns false if not supported
+        bool prepareZeroCopy();
+
+        // Keeps the pin until the sendmsg from first to the last sent are completed
+        void pinZeroCopy(const std::uint32_t first, const ZeroCopyPin &pin);
+
+        // Reads the completions without blocking, releasing the completed sends
+        void reapZeroCopyLocked();
+
     public:
         /**
          * Constructs the Socket class.
@@ -69,8 +127,12 @@ namespace Lib::Network
          * @throw std::invalid_argument if the type is not UDP nor TCP
          * @throw std::runtime_error If the socket creation has failed
          * @throw std::runtime_error If binding failed
+         *
+         * With reusePort more sockets can bind the same port (SO_REUSEPORT),
+         * and the kernel spreads the incoming traffic among them.
          */
-        Socket(const std::string &ip, const unsigned short port, const SocketType &type);
+        Socket(const std::string &ip, const unsigned short port, const SocketType &type,
+               const bool reusePort = false);
         Socket(const SocketType &type) : _type(type) {};
         Socket(const Socket &other);
         ~Socket()
@@ -89,6 +151,16 @@ namespace Lib::Network
         struct SocketInfo *getSocketInfo();
         void flushSocketError();
 
+        // Reads the completions of the zero-copy sends without blocking, and
+        // releases the data of the completed ones. The completions are also
+        // read by the next sends, or when the socket reports POLLERR.
+        void reapZeroCopy();
+
+        // Waits up to timeout_ms until all the zero-copy sends are completed,
+        // i.e., until their data is released. False on timeout.
+        bool waitZeroCopy(const int timeout_ms);
+        struct ZeroCopyStats getZeroCopyStats() const;
+
         static std::string addressNumberToString(unsigned int addr, const bool be);
         static unsigned int addressStringToNumber(const std::string &addr);
         static std::string getHostnameIp(const std::string &hostname);
@@ -97,17 +169,94 @@ namespace Lib::Network
         static struct SubnetInfo getSubnetConfiguration(const std::string &addr, const std::string &mask);
         static void getSocketInfo(int sockfd, struct SocketInfo *sockinfo);
         static void resetSocketInfo(struct SocketInfo *sockinfo);
+
+        // The abstract AF_UNIX name standing for an IPv4 address and port,
+        // returns the length of the address. fromLocalAddress does the
+        // opposite, false if the name is not one of ours.
+        static socklen_t toLocalAddress(const struct sockaddr_in &addr, struct sockaddr_un &local);
+        static bool fromLocalAddress(const struct sockaddr_un &local, const socklen_t len, struct sockaddr_in &addr);
+
+        // True if the address is a loopback one or belongs to an interface of this host
+        static bool isLocalAddress(const struct in_addr &addr);
+
+        // The software receive timestamp of the kernel carried by the control
+        // messages (SCM_TIMESTAMPING or SCM_TIMESTAMPNS), in nanoseconds
+        // since the epoch, or 0 if there is none.
+        static std::uint64_t getKernelTimestamp(const struct msghdr &msg);
     };
 
     class UdpSocket : public Socket
     {
+    private:
+        std::shared_ptr<OutboundQueue> _outbound; // Datagrams waiting for the socket, shared by the copies
+
     public:
-        UdpSocket(const std::string &ip, const unsigned short port)
-            : Socket(ip, port, SocketType::UDP) {};
+        UdpSocket(const std::string &ip, const unsigned short port, const bool reusePort = false)
+            : Socket(ip, port, SocketType::UDP, reusePort), _outbound(std::make_shared<OutboundQueue>()) {};
 
-        UdpSocket(const UdpSocket &other) : Socket(other) {};
+        UdpSocket(const UdpSocket &other) : Socket(other), _outbound(other._outbound) {};
+        ~UdpSocket()
+        {
+            // The queue stops draining before the socket is closed
+            _outbound->close();
+        }
 
+    protected:
+        UdpSocket(const std::string &ip, const unsigned short port, const SocketType &type)
+            : Socket(ip, port, type), _outbound(std::make_shared<OutboundQueue>()) {};
+
+    public:
+        void closeSocket();
+
+        // Sends without waiting for the socket, see OutboundQueue. Returns
+        // false if the datagram has been dropped.
         bool send(unsigned char *buff, const std::size_t n, struct sockaddr_in *dst);
+
+        // Sends the segments as a single datagram. With a pin the data is not
+        // copied by the kernel, the pin keeps the segments alive until the
+        // send is completed and they must not change meanwhile.
+        bool sendv(const struct iovec *iov, const std::size_t iovcnt, struct sockaddr_in *dst,
+                   const ZeroCopyPin &pin = nullptr);
+
+        // Waits up to timeout_ms for the queued datagrams to be sent,
+        // returns true if none is left.
+        bool flush(const int timeout_ms);
+
+        struct OutboundStats getOutboundStats() const;
+
+        // Sends the prepared datagrams with a single system call, returns
+        // how many of them have been sent or -1 on error.
+        int sendBatch(struct mmsghdr *msgs, const std::size_t count);
+
+        // Allows sending to the broadcast addresses, and sends the multicast
+        // datagrams through the interface the socket is bound to
+        bool enableBroadcast();
+
+        // Receives the datagrams sent to the multicast group through the
+        // interface with the given address. Returns false on error.
+        bool joinMulticastGroup(const std::string &group, const std::string &interfaceIp) const;
+    };
+
+    /**
+     * A datagram socket in the abstract AF_UNIX namespace, named after the
+     * IPv4 address and port it stands for (see Socket::toLocalAddress).
+     * Peers on the same host exchange datagrams through it without going
+     * through the IP stack, and the receiver still sees the IPv4 source.
+     * The abstract namespace belongs to the network namespace, hence two
+     * containers with their own network never reach each other this way.
+     */
+    class LocalSocket : public UdpSocket
+    {
+    public:
+        LocalSocket(const std::string &ip, const unsigned short port)
+            : UdpSocket(ip, port, SocketType::UNIX) {};
+
+        LocalSocket(const LocalSocket &other) : UdpSocket(other) {};
+
+        // Sends the segments as a single datagram to the local socket of dst,
+        // without waiting. Returns false if there is none or it is full, in
+        // which case the datagram should go through the IP socket.
+        bool sendLocal(const struct iovec *iov, const std::size_t iovcnt, const struct sockaddr_in *dst);
     };
 
     class TcpSocket : public Socket
@@ -156,6 +305,16 @@ namespace Lib::Network
 
         bool sendTo(const std::string &ip, const unsigned short port,
                     unsigned char *buff, const std::size_t n);
+
+        // Sends all the bytes on the connected socket, without reconnecting
+        bool sendAll(unsigned char *buff, const std::size_t n);
+
+        // Sends all the bytes of the segments, see UdpSocket::sendv for the pin
+        bool sendAllv(const struct iovec *iov, const std::size_t iovcnt, const ZeroCopyPin &pin = nullptr);
+
+        // Checks, without blocking, that the connection has not been closed
+        // or broken by the other end.
+        bool isAlive();
     };
 }
 
@@ -0,0 +1,47 @@
+#include "TokenBucket.hpp"
+
+using namespace Lib::Network;
+
+TokenBucket::TokenBucket(const double rate, const double burst)
+    : _rate(std::max(rate, 0.0)), _burst(std::max(burst, 1.0)), _tokens(_burst),
+      _last(std::chrono::steady_clock::now())
+{
+}
+
+void TokenBucket::refill()
+{
+    time_point_t now = std::chrono::steady_clock::now();
+    std::chrono::duration<double> elapsed = now - _last;
+    _tokens = std::min(_burst, _tokens + elapsed.count() * _rate);
+    _last = now;
+}
+
+std::size_t TokenBucket::tryAcquire(const std::size_t n)
+{
+    if (_rate == 0.0) return n;
+
+    refill();
+    std::size_t taken = std::min<std::size_t>(n, (std::size_t)_tokens);
+    _tokens -= taken;
+    return taken;
+}
+
+std::size_t TokenBucket::acquire(const std::size_t n)
+{
+    if (n == 0) return 0;
+
+    std::size_t taken;
+    while ((taken = tryAcquire(n)) == 0)
+    {
+        // Sleep until the next token is expected
+        std::chrono::duration<double> missing((1.0 - _tokens) / _rate);
+        std::this_thread::sleep_for(missing);
+    }
+
+    return taken;
+}
+
+double TokenBucket::getRate() const
+{
+    return _rate;
+}
@@ -0,0 +1,42 @@
+#ifndef _TOKENBUCKET_HPP
+#define _TOKENBUCKET_HPP
+
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+namespace Lib::Network
+{
+    /**
+     * Paces the sends to a given rate of packets per second. Tokens are
+     * added continuously up to the burst size, and each packet takes one.
+     * Not thread safe, each sending thread should have its own bucket.
+     */
+    class TokenBucket
+    {
+    private:
+        typedef std::chrono::steady_clock::time_point time_point_t;
+
+        double _rate;       // Tokens added each second, 0 for no limit
+        double _burst;      // Maximum number of tokens
+        double _tokens;     // Currently available tokens
+        time_point_t _last; // When the tokens have been last refilled
+
+        void refill();
+
+    public:
+        TokenBucket(const double rate, const double burst);
+
+        // Takes up to n tokens, waiting until at least one is available.
+        // Returns the number of taken tokens.
+        std::size_t acquire(const std::size_t n);
+
+        // Like acquire, but returns 0 instead of waiting
+        std::size_t tryAcquire(const std::size_t n);
+
+        double getRate() const;
+    };
+}
+
+#endif
@@ -0,0 +1,117 @@
+#include "EventLoop.hpp"
+
+using namespace Lib::Concurrency;
+
+EventLoop::EventLoop() : _notified(false)
+{
+    _epollfd = epoll_create1(EPOLL_CLOEXEC);
+    if (_epollfd < 0)
+    {
+        throw std::runtime_error("[EventLoop] epoll_create1 error: " + std::string(strerror(errno)));
+    }
+
+    _eventfd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (_eventfd < 0)
+    {
+        close(_epollfd);
+        throw std::runtime_error("[EventLoop] eventfd error: " + std::string(strerror(errno)));
+    }
+
+    // The eventfd is told apart from the timers by a zero data,
+    // timers carry their identifier plus one.
+    struct epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.u64 = 0;
+    epoll_ctl(_epollfd, EPOLL_CTL_ADD, _eventfd, &event);
+}
+
+EventLoop::~EventLoop()
+{
+    for (int timerfd : _timers) close(timerfd);
+    close(_eventfd);
+    close(_epollfd);
+}
+
+void EventLoop::notify()
+{
+    std::uint64_t value = 1;
+    if (write(_eventfd, &value, sizeof(value)) < 0 && errno != EAGAIN)
+    {
+        printf("Error: %s - write %s\n", __FUNCTION__, std::strerror(errno));
+    }
+}
+
+int EventLoop::addTimer()
+{
+    int timerfd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (timerfd < 0)
+    {
+        throw std::runtime_error("[EventLoop] timerfd_create error: " + std::string(strerror(errno)));
+    }
+
+    struct epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.u64 = _timers.size() + 1;
+    if (epoll_ctl(_epollfd, EPOLL_CTL_ADD, timerfd, &event) < 0)
+    {
+        close(timerfd);
+        throw std::runtime_error("[EventLoop] epoll_ctl error: " + std::string(strerror(errno)));
+    }
+
+    _timers.push_back(timerfd);
+    _expired.push_back(false);
+    return (int)_timers.size() - 1;
+}
+
+bool EventLoop::setTimer(const int timer, const unsigned int timeout_ms, const unsigned int interval_ms)
+{
+    if (timer < 0 || timer >= (int)_timers.size()) return false;
+
+    struct itimerspec spec;
+    spec.it_value.tv_sec = timeout_ms / 1000;
+    spec.it_value.tv_nsec = (timeout_ms % 1000) * 1000000L;
+    spec.it_interval.tv_sec = interval_ms / 1000;
+    spec.it_interval.tv_nsec = (interval_ms % 1000) * 1000000L;
+
+    // Setting the timer also clears its pending expirations
+    _expired[timer] = false;
+    return timerfd_settime(_timers[timer], 0, &spec, nullptr) == 0;
+}
+
+bool EventLoop::wait(const int timeout_ms)
+{
+    _notified = false;
+    std::fill(_expired.begin(), _expired.end(), false);
+
+    struct epoll_event events[EVENT_LOOP_MAX_EVENTS];
+    int nofEvents = epoll_wait(_epollfd, events, EVENT_LOOP_MAX_EVENTS, timeout_ms);
+    if (nofEvents < 0) return errno == EINTR;
+
+    // Both eventfd and timerfd are read to be cleared
+    std::uint64_t value;
+    for (int idx = 0; idx < nofEvents; idx++)
+    {
+        std::uint64_t source = events[idx].data.u64;
+        if (source == 0)
+        {
+            _notified = read(_eventfd, &value, sizeof(value)) > 0;
+            continue;
+        }
+
+        _expired[source - 1] = read(_timers[source - 1], &value, sizeof(value)) > 0;
+    }
+
+    return true;
+}
+
+bool EventLoop::isNotified() const
+{
+    return _notified;
+}
+
+bool EventLoop::isExpired(const int timer) const
+{
+    return timer >= 0 && timer < (int)_expired.size() && _expired[timer];
+}
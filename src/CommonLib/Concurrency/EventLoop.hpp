@@ -0,0 +1,74 @@
+#ifndef _EVENTLOOP_HPP
+#define _EVENTLOOP_HPP
+
+#include <iostream>
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+#include <stdexcept>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+
+#define EVENT_LOOP_MAX_EVENTS 16 // Maximum number of events returned by each wait
+
+namespace Lib::Concurrency
+{
+    /**
+     * @class Lib::Concurrency::EventLoop
+     *
+     * Blocks a thread on a single epoll set until another thread notifies
+     * it, through an eventfd, or one of its timers expires, each one a
+     * timerfd. Nothing wakes the thread up while there is nothing to do.
+     *
+     * Notifying is thread safe, while timers and waits belong to the
+     * thread running the loop.
+     */
+    class EventLoop
+    {
+    private:
+        int _epollfd;                // Watches the eventfd and the timers
+        int _eventfd;                // Written by notify
+        std::vector<int> _timers;    // The timerfd of each timer
+        std::vector<bool> _expired;  // The timers expired during the last wait
+        bool _notified;              // If the last wait has been notified
+
+    public:
+        /**
+         * @throw std::runtime_error if epoll or eventfd cannot be created
+         */
+        EventLoop();
+        EventLoop(const EventLoop &other) = delete;
+        ~EventLoop();
+
+        EventLoop &operator=(const EventLoop &other) = delete;
+
+        void notify(); // Wakes up the waiting thread, or the next wait
+
+        /**
+         * Creates a new disarmed timer and returns its identifier.
+         *
+         * @throw std::runtime_error if the timerfd cannot be created
+         */
+        int addTimer();
+
+        // Expires the timer after timeout_ms, then every interval_ms if not
+        // zero. A zero timeout disarms it. Expirations not yet waited are lost.
+        bool setTimer(const int timer, const unsigned int timeout_ms, const unsigned int interval_ms = 0);
+
+        // Waits up to timeout_ms (-1 forever) for a notification or a timer.
+        // Returns false on error.
+        bool wait(const int timeout_ms = -1);
+
+        bool isNotified() const;                // If the last wait has been notified
+        bool isExpired(const int timer) const;  // If the timer expired during the last wait
+    };
+
+    typedef std::shared_ptr<EventLoop> EventLoop_ptr;
+}
+
+#endif
@@ -6,6 +6,7 @@
 #include <condition_variable>
 #include <memory>
 #include <queue>
+#include <CommonLib/Concurrency/EventLoop.hpp>
 
 namespace Lib::Concurrency
 {
@@ -18,6 +19,7 @@ namespace Lib::Concurrency
         std::condition_variable _empty; // Conditional variable on items availability
         std::condition_variable _full;  // Conditional variable on residual space
         std::size_t _capacity;          // The total capacity of the queue
+        EventLoop_ptr _loop;            // Notified of each pushed element, if any
 
     public:
         Queue(const std::size_t capacity) : _capacity(capacity) {};
@@ -34,6 +36,14 @@ namespace Lib::Concurrency
 
         void push(const T &element);
         T pop();
+
+        // Pops an element waiting at most timeout_ms for it, returns
+        // false instead of throwing if the queue is still empty.
+        bool tryPop(T &element, const long int timeout_ms = 0);
+
+        // Notifies the loop of each element pushed from now on, so that a
+        // consumer can wait for more queues at once and take with tryPop
+        void setEventLoop(const EventLoop_ptr &loop);
     };
 
     template <typename T>
@@ -72,6 +82,7 @@ namespace Lib::Concurrency
 
         // Notify the waiting thread
         _empty.notify_one();
+        if (_loop != nullptr) _loop->notify();
     }
 
     template <typename T>
@@ -96,6 +107,31 @@ namespace Lib::Concurrency
         }
     }
 
+    template <typename T>
+    inline bool Queue<T>::tryPop(T &element, const long int timeout_ms)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        if (!_empty.wait_for(lock, std::chrono::milliseconds(timeout_ms),
+                             [this]()
+                             { return !this->_queue.empty(); }))
+        {
+            return false;
+        }
+
+        element = _queue.front();
+        _queue.pop();
+
+        _full.notify_one();
+        return true;
+    }
+
+    template <typename T>
+    inline void Queue<T>::setEventLoop(const EventLoop_ptr &loop)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _loop = loop;
+    }
+
     template <typename T>
     using Queue_ptr = std::shared_ptr<Queue<T>>;
 }
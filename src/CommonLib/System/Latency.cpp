@@ -0,0 +1,87 @@
+#include "Latency.hpp"
+
+using namespace Lib::System;
+
+std::uint64_t Lib::System::getRealTime_ns()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+LatencyHistogram::LatencyHistogram()
+{
+    reset();
+}
+
+void LatencyHistogram::record(const std::uint64_t start_ns, const std::uint64_t end_ns)
+{
+    if (start_ns == 0 || end_ns == 0 || end_ns < start_ns) return;
+
+    std::uint64_t latency = (end_ns - start_ns) / 1000;
+    std::size_t idx = 0;
+    while (idx < LATENCY_BUCKETS - 1 && (latency >> idx) != 0) idx++;
+
+    _buckets[idx].fetch_add(1, std::memory_order_relaxed);
+    _count.fetch_add(1, std::memory_order_relaxed);
+    _sum_us.fetch_add(latency, std::memory_order_relaxed);
+
+    std::uint64_t max = _max_us.load(std::memory_order_relaxed);
+    while (latency > max && !_max_us.compare_exchange_weak(max, latency, std::memory_order_relaxed));
+}
+
+void LatencyHistogram::reset()
+{
+    for (std::size_t idx = 0; idx < LATENCY_BUCKETS; idx++) _buckets[idx].store(0);
+    _count.store(0);
+    _sum_us.store(0);
+    _max_us.store(0);
+}
+
+std::uint64_t LatencyHistogram::getPercentile_us(const double percentile) const
+{
+    std::uint64_t count = getCount();
+    if (count == 0) return 0;
+
+    // The rank of the percentile, at least the first latency
+    std::uint64_t rank = (std::uint64_t)(percentile / 100.0 * count + 0.5);
+    if (rank == 0) rank = 1;
+
+    std::uint64_t seen = 0;
+    for (std::size_t idx = 0; idx < LATENCY_BUCKETS; idx++)
+    {
+        seen += getBucket(idx);
+        if (seen >= rank) return std::min<std::uint64_t>((1ULL << idx) - 1, getMax_us());
+    }
+
+    return getMax_us();
+}
+
+std::uint64_t LatencyHistogram::getBucket(const std::size_t idx) const
+{
+    return idx < LATENCY_BUCKETS ? _buckets[idx].load(std::memory_order_relaxed) : 0;
+}
+
+std::uint64_t LatencyHistogram::getCount() const
+{
+    return _count.load(std::memory_order_relaxed);
+}
+
+std::uint64_t LatencyHistogram::getMean_us() const
+{
+    std::uint64_t count = getCount();
+    return count == 0 ? 0 : _sum_us.load(std::memory_order_relaxed) / count;
+}
+
+std::uint64_t LatencyHistogram::getMax_us() const
+{
+    return _max_us.load(std::memory_order_relaxed);
+}
+
+std::string LatencyHistogram::toString() const
+{
+    std::stringstream ss;
+    ss << "n=" << getCount() << " mean=" << getMean_us() << "us";
+    ss << " p50<=" << getPercentile_us(50) << "us p99<=" << getPercentile_us(99) << "us";
+    ss << " max=" << getMax_us() << "us";
+    return ss.str();
+}
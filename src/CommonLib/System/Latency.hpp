@@ -0,0 +1,54 @@
+#ifndef _LATENCY_HPP
+#define _LATENCY_HPP
+
+#include <iostream>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <sstream>
+#include <string>
+
+#define LATENCY_BUCKETS 32 // Bucket i counts the latencies in [2^(i-1), 2^i) microseconds
+
+namespace Lib::System
+{
+    // Nanoseconds since the epoch, on the same clock of the kernel timestamps
+    std::uint64_t getRealTime_ns();
+
+    /**
+     * A histogram of latencies with buckets of increasing powers of two
+     * microseconds. Recording is lock free, so that the threads of the
+     * different stages can share it.
+     */
+    class LatencyHistogram
+    {
+    private:
+        std::atomic<std::uint64_t> _buckets[LATENCY_BUCKETS]; // Number of latencies in each bucket
+        std::atomic<std::uint64_t> _count;                    // Number of recorded latencies
+        std::atomic<std::uint64_t> _sum_us;                   // Sum of the recorded latencies
+        std::atomic<std::uint64_t> _max_us;                   // Highest recorded latency
+
+    public:
+        LatencyHistogram();
+        LatencyHistogram(const LatencyHistogram &other) = delete;
+
+        LatencyHistogram &operator=(const LatencyHistogram &other) = delete;
+
+        // Records the latency between two timestamps in nanoseconds. Nothing
+        // is recorded if any of them is missing (0) or they are not ordered.
+        void record(const std::uint64_t start_ns, const std::uint64_t end_ns);
+        void reset();
+
+        // The upper bound of the bucket containing the given percentile (0-100)
+        std::uint64_t getPercentile_us(const double percentile) const;
+        std::uint64_t getBucket(const std::size_t idx) const;
+        std::uint64_t getCount() const;
+        std::uint64_t getMean_us() const;
+        std::uint64_t getMax_us() const;
+
+        // A single line summary: count, mean, p50, p99 and max
+        std::string toString() const;
+    };
+}
+
+#endif
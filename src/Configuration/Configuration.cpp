@@ -155,6 +155,21 @@ unsigned short Configuration::DisqubeConfiguration::getQubesWorkerUdpPort() cons
     return (unsigned short)std::stoi(this->getConfigurationValue("Qubes", "WORKER_UDP_PORT"));
 }
 
+double Configuration::DisqubeConfiguration::getDiscoverRate() const
+{
+    return std::stod(this->getConfigurationValue("Qubes", "DISCOVER_RATE"));
+}
+
+unsigned int Configuration::DisqubeConfiguration::getRosterTimeout_ms() const
+{
+    return (unsigned int)std::stoi(this->getConfigurationValue("Qubes", "ROSTER_TIMEOUT"));
+}
+
+unsigned int Configuration::DisqubeConfiguration::getRosterMaxAge_s() const
+{
+    return (unsigned int)std::stoi(this->getConfigurationValue("Qubes", "ROSTER_MAX_AGE"));
+}
+
 std::string Configuration::DisqubeConfiguration::getNetworkInterface() const
 {
     return this->getConfigurationValue("Network", "INTERFACE");
@@ -185,6 +200,21 @@ unsigned short Configuration::DisqubeConfiguration::getBroadcastPort() const
     return (unsigned short)std::stoi(this->getConfigurationValue("Network", "BROADCAST_PORT"));
 }
 
+Configuration::DiscoveryMode Configuration::DisqubeConfiguration::getDiscoveryMode() const
+{
+    return (DiscoveryMode)std::stoi(this->getConfigurationValue("Network", "DISCOVERY_MODE"));
+}
+
+std::string Configuration::DisqubeConfiguration::getMulticastGroup() const
+{
+    return this->getConfigurationValue("Network", "MULTICAST_GROUP");
+}
+
+unsigned int Configuration::DisqubeConfiguration::getDiscoveryRepeat() const
+{
+    return (unsigned int)std::stoi(this->getConfigurationValue("Network", "DISCOVERY_REPEAT"));
+}
+
 std::size_t Configuration::DisqubeConfiguration::getTcpMaxCapacityQueue() const
 {
     return (std::size_t)std::stoi(this->getConfigurationValue("Network", "TCP_CAPACITY_QUEUE"));
@@ -200,9 +230,39 @@ std::size_t Configuration::DisqubeConfiguration::getUdpMaxCapacityQueue() const
     return (std::size_t)std::stoi(this->getConfigurationValue("Network", "UDP_CAPACITY_QUEUE"));
 }
 
-unsigned int Configuration::DisqubeConfiguration::getReceptionTimer_ms() const
+std::size_t Configuration::DisqubeConfiguration::getUdpBatchSize() const
+{
+    return (std::size_t)std::stoi(this->getConfigurationValue("Network", "UDP_BATCH_SIZE"));
+}
+
+bool Configuration::DisqubeConfiguration::isIoUringEnabled() const
+{
+    return std::stoi(this->getConfigurationValue("Network", "IO_URING")) == 1;
+}
+
+std::size_t Configuration::DisqubeConfiguration::getUdpListenerShards() const
+{
+    return (std::size_t)std::stoi(this->getConfigurationValue("Network", "UDP_LISTENER_SHARDS"));
+}
+
+bool Configuration::DisqubeConfiguration::isLocalTransportEnabled() const
+{
+    return std::stoi(this->getConfigurationValue("Network", "LOCAL_TRANSPORT")) == 1;
+}
+
+std::size_t Configuration::DisqubeConfiguration::getCompressionThreshold() const
+{
+    return (std::size_t)std::stoi(this->getConfigurationValue("Network", "COMPRESSION_THRESHOLD"));
+}
+
+bool Configuration::DisqubeConfiguration::isChecksumEnabled() const
+{
+    return std::stoi(this->getConfigurationValue("Network", "MESSAGE_CHECKSUM")) == 1;
+}
+
+std::size_t Configuration::DisqubeConfiguration::getZeroCopyThreshold() const
 {
-    return (unsigned int)std::stoi(this->getConfigurationValue("Operative", "RECEPTION_TIMER"));
+    return (std::size_t)std::stoi(this->getConfigurationValue("Network", "ZEROCOPY_THRESHOLD"));
 }
 
 unsigned int Configuration::DisqubeConfiguration::getOperativeTimeout_ms() const
@@ -15,6 +15,14 @@
 
 namespace Configuration
 {
+    // How the master reaches the workers during the discover
+    enum DiscoveryMode
+    {
+        UNICAST = 0,   // A Hello to each address of the subnet
+        BROADCAST = 1, // A few Hellos to the broadcast address of the interface
+        MULTICAST = 2  // A few Hellos to the multicast group
+    };
+
     class DisqubeConfiguration
     {
         private:
@@ -48,6 +56,9 @@ namespace Configuration
             std::string getQubesSubnetMask() const; 
             std::string getQubesSubnetGateway() const;
             unsigned short getQubesWorkerUdpPort() const;
+            double getDiscoverRate() const;
+            unsigned int getRosterTimeout_ms() const;
+            unsigned int getRosterMaxAge_s() const;
 
             // Network Configuration Values
             std::string getNetworkInterface() const;
@@ -56,12 +67,21 @@ namespace Configuration
             unsigned short getUdpSenderPort() const;
             unsigned short getUdpListenerPort() const;
             unsigned short getBroadcastPort() const;
+            DiscoveryMode getDiscoveryMode() const;
+            std::string getMulticastGroup() const;
+            unsigned int getDiscoveryRepeat() const;
             std::size_t getTcpMaxCapacityQueue() const;
             std::size_t getTcpMaxNumOfConnections() const;
             std::size_t getUdpMaxCapacityQueue() const;
+            std::size_t getUdpBatchSize() const;
+            bool isIoUringEnabled() const;
+            std::size_t getUdpListenerShards() const;
+            bool isLocalTransportEnabled() const;
+            std::size_t getCompressionThreshold() const;
+            bool isChecksumEnabled() const;
+            std::size_t getZeroCopyThreshold() const;
 
             // Operative configuration
-            unsigned int getReceptionTimer_ms() const;
             unsigned int getOperativeTimeout_ms() const;
             
             // Logging configuration
@@ -26,4 +26,23 @@ Qube::Logging::ProgressBar::ProgressBar(
 
     this->dperc = 100.0 / this->total;
     this->start_time = std::chrono::high_resolution_clock::now();
+    this->draw_time = this->start_time;
+}
+
+void Qube::Logging::ProgressBar::update(int completed)
+{
+    if (completed <= this->current) return;
+    this->current = std::min(completed, this->total);
+
+    auto now = std::chrono::high_resolution_clock::now();
+    auto since = std::chrono::duration_cast<std::chrono::milliseconds>(now - this->draw_time);
+    bool finished = this->current == this->total;
+    if (!finished && since.count() < PROGRESS_REFRESH_MS) return;
+
+    this->draw_time = now;
+    this->currperc = this->current * this->dperc;
+    std::chrono::duration<double> etime = now - this->start_time;
+    ProgressBar::showBar(this->current, this->total, this->currperc, this->msg, etime.count());
+
+    if (finished) std::cout << std::endl << std::endl;
 }
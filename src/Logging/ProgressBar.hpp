@@ -2,6 +2,7 @@
 #define _PROGRESSBAR_H
 
 #include <functional>
+#include <algorithm>
 #include <string>
 #include <sstream>
 #include <chrono>
@@ -9,6 +10,7 @@
 #include <iostream>
 
 #define BLOCK "\u2588" // Defines the block character used in the progress bar
+#define PROGRESS_REFRESH_MS 100 // Minimum interval between two redraws of an updated bar
 
 namespace Qube::Logging
 {
@@ -30,6 +32,7 @@ namespace Qube::Logging
             double dperc    = 0.0; // Delta percentage step
             
             time_point start_time; // Start time of the progress bar
+            time_point draw_time;  // Last time the bar has been drawn
 
             static void showBar(int completed, int total, double perc, 
                 const std::string& msg, double etime);
@@ -37,6 +40,10 @@ namespace Qube::Logging
         public:
             ProgressBar(int __start, int __stop, int __step, const std::string& __msg);
 
+            // Sets the number of completed steps, redrawing the bar at most every
+            // PROGRESS_REFRESH_MS milliseconds and once more when it completes
+            void update(int completed);
+
             template <typename _Callable, typename ..._Args>
             static void display(const int start, const int stop, const int step, 
                 const std::string& msg, _Callable&& fn, _Args&&... args)
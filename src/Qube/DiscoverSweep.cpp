@@ -0,0 +1,84 @@
+#include "DiscoverSweep.hpp"
+
+namespace net = Lib::Network;
+
+void Qube::DiscoverSweep::add(const unsigned int addr, const unsigned short port, net::Message &msg)
+{
+    msg.encode();
+
+    std::size_t offset = _data.size();
+    std::size_t size = msg.getBufferSize();
+    _data.resize(offset + size + net::Message::CHECKSUM_SIZE);
+    memcpy(_data.data() + offset, msg.getData(), size);
+
+    // The same trailer the sender would have appended
+    if (_udpitf->isChecksumEnabled()) size = net::Message::appendChecksum(_data.data() + offset, size);
+    _data.resize(offset + size);
+
+    struct net::Datagram datagram;
+    memset(&datagram.dst, 0, sizeof(struct sockaddr_in));
+    datagram.dst.sin_family = AF_INET;
+    datagram.dst.sin_port = htons(port);
+    datagram.dst.sin_addr.s_addr = htonl(addr);
+    datagram.data = nullptr;
+    datagram.size = size;
+
+    _offsets.push_back(offset);
+    _datagrams.push_back(datagram);
+}
+
+void Qube::DiscoverSweep::start()
+{
+    // The data does not move anymore, the datagrams can point into it
+    for (std::size_t idx = 0; idx < _datagrams.size(); idx++)
+        _datagrams[idx].data = _data.data() + _offsets[idx];
+
+    _running = true;
+    Thread::start();
+}
+
+void Qube::DiscoverSweep::run()
+{
+    std::size_t count = _datagrams.size();
+
+    while (!_sigstop && _nofDone < count)
+    {
+        std::size_t done = _nofDone;
+        std::size_t nofMsgs = _bucket.acquire(std::min(_batchSize, count - done));
+
+        // Datagrams refused by the kernel are not retried, as the
+        // Hello of a discover is not guaranteed to arrive anyway.
+        _nofSent += _udpitf->sendBatch(&_datagrams[done], nofMsgs);
+        _nofDone = done + nofMsgs;
+    }
+
+    _running = false;
+    if (_loop != nullptr) _loop->notify();
+}
+
+bool Qube::DiscoverSweep::isRunning() const
+{
+    return _running;
+}
+
+void Qube::DiscoverSweep::stop()
+{
+    this->_sigstop = true;
+    if (this->isJoinable())
+        this->join();
+}
+
+std::size_t Qube::DiscoverSweep::getNofDatagrams() const
+{
+    return _datagrams.size();
+}
+
+std::size_t Qube::DiscoverSweep::getNofDone() const
+{
+    return _nofDone;
+}
+
+std::size_t Qube::DiscoverSweep::getNofSent() const
+{
+    return _nofSent;
+}
@@ -0,0 +1,68 @@
+#ifndef _DISCOVERSWEEP_H
+#define _DISCOVERSWEEP_H
+
+#include <iostream>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+#include <CommonLib/Communication/Interface.hpp>
+#include <CommonLib/Communication/Message.hpp>
+#include <CommonLib/Communication/TokenBucket.hpp>
+#include <CommonLib/Concurrency/Thread.hpp>
+#include <CommonLib/Concurrency/EventLoop.hpp>
+
+namespace Qube
+{
+    /**
+     * @class Qube::DiscoverSweep
+     *
+     * Sends the Discover Hello messages of a unicast discover on its own
+     * thread, so that the responses can be handled while it is running.
+     * All the messages are encoded up front into a single buffer, and sent
+     * in sendmmsg batches paced by a token bucket of the given rate.
+     * The progress is only counted, it is up to the caller to show it.
+     */
+    class DiscoverSweep : public Lib::Concurrency::Thread
+    {
+    private:
+        Lib::Network::UdpCommunicationInterface_ptr _udpitf; // Sends the datagrams
+        Lib::Network::TokenBucket _bucket;                   // Paces the batches
+        Lib::Concurrency::EventLoop_ptr _loop;               // Notified once the last Hello has left
+        std::size_t _batchSize;                              // Datagrams of each sendmmsg
+
+        std::vector<unsigned char> _data;                      // The encoded messages, one after the other
+        std::vector<std::size_t> _offsets;                     // Where each message starts into the data
+        std::vector<struct Lib::Network::Datagram> _datagrams; // Destination and size of each message
+
+        std::atomic<std::size_t> _nofDone; // Datagrams handled so far, sent or not
+        std::atomic<std::size_t> _nofSent; // Datagrams accepted by the kernel
+        std::atomic<bool> _running;
+        std::atomic<bool> _sigstop;
+
+    public:
+        /**
+         * @param rate Packets per second, 0 for no limit
+         */
+        DiscoverSweep(const Lib::Network::UdpCommunicationInterface_ptr &udpitf, const double rate,
+                      const std::size_t batchSize, const Lib::Concurrency::EventLoop_ptr &loop = nullptr)
+            : Thread("Discover Sweep"), _udpitf(udpitf), _bucket(rate, batchSize), _loop(loop),
+              _batchSize(std::max<std::size_t>(batchSize, 1)), _nofDone(0), _nofSent(0), _running(false), _sigstop(false) {};
+
+        // Encodes the message for the destination. All of them must be added before start.
+        void add(const unsigned int addr, const unsigned short port, Lib::Network::Message &msg);
+
+        void start();
+        void run() override;
+        bool isRunning() const override;
+        void stop();
+
+        std::size_t getNofDatagrams() const;
+        std::size_t getNofDone() const;
+        std::size_t getNofSent() const;
+    };
+
+    typedef std::shared_ptr<DiscoverSweep> DiscoverSweep_ptr;
+}
+
+#endif
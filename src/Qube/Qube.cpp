@@ -29,9 +29,9 @@ void Qube::Qube::initStateMachine()
     s0->addTransition(s4, [](sm::Transition::Input_t p)
                       { return p.shutdown; });
     s0->addTransition(s1, [](sm::Transition::Input_t p)
-                      { return p.itfReady && (p.discoverFlag && p.isMaster); });
+                      { return p.itfReady && (p.discoverFlag && p.isMaster) && !p.rosterValid; });
     s0->addTransition(s2, [](sm::Transition::Input_t p)
-                      { return p.itfReady && !(p.discoverFlag && p.isMaster); });
+                      { return p.itfReady && (!(p.discoverFlag && p.isMaster) || p.rosterValid); });
     s1->addTransition(s4, [](sm::Transition::Input_t p)
                       { return p.shutdown; });
     s1->addTransition(s2, [](sm::Transition::Input_t p)
@@ -135,7 +135,7 @@ void Qube::Qube::init()
 
     // Fill the qube data
     bool discFlag = _conf->isDiscoverEnabled();
-    _qubeData = {false, discFlag, _isMaster, false, false, false};
+    _qubeData = {false, discFlag, _isMaster, false, false, false, false};
 
     // Initialize the Qube interface
     _itf = std::make_shared<QubeInterface>(_conf, _logger);
@@ -147,13 +147,16 @@ void Qube::Qube::init()
     {
         // If there are no errors we can continue to next step
         this->_logger->info("The Qube Is Ready to proceed.");
+
+        // Messages and timers wake up the qube through the same loop
+        _loop = _itf->getEventLoop();
+        _timeout = _loop->addTimer();
+
+        // The workers of the previous run skip the discover if they still answer
+        this->_qubeData.rosterValid = this->warmStart();
+        this->_qubeData.anyWorker = this->_qubeData.rosterValid;
         this->_qubeData.itfReady = true;
         this->_stateMachine->update(this->_qubeData);
-
-        // Create the timer
-        unsigned int time_us = _conf->getReceptionTimer_ms() * 1000;
-        _timer = std::make_shared<conc::WakeUpTimer>(time_us);
-        _timer->start();
         return;
     }
 
@@ -180,6 +183,11 @@ bool Qube::Qube::isMaster() const
     return _isMaster;
 }
 
+bool Qube::Qube::warmStart()
+{
+    return false;
+}
+
 bool Qube::Qube::isDiscoverEnabledAtStartup() const
 {
     return _conf->isDiscoverEnabled();
@@ -211,12 +219,29 @@ void Qube::Qube::run()
 
 void Qube::QubeManager::discover()
 {
+    // Forget the responses of the previous discover
+    this->_responders.clear();
+    this->_nofResponses = 0;
+    this->_nofDropped = 0;
+
     this->_itf->qubeDiscovering(); // Perform Qube discovering
-    this->_timer->resetTimeout();  // Reset the timeout for waiting discover responses
 
-    while (!this->_timer->checkTimeout(1000))
+    // Responses are handled while the Hellos are still being sent, and the
+    // timeout starts once the last Hello has left, as notified by the sweep.
+    // The progress of the sweep is drawn here, so that it does not mix with
+    // the output of the responses.
+    bool sent = false;
+    while (!(sent && this->_loop->isExpired(_timeout)))
     {
-        this->_timer->wait(); // Wait for the wake up signal
+        this->_itf->showDiscoverProgress();
+        if (!sent && !this->_itf->isDiscovering())
+        {
+            sent = true;
+            this->_loop->setTimer(_timeout, DISCOVER_TIMEOUT_MS);
+        }
+
+        // Wait for a message or the timeout, or the next redraw of the progress
+        this->_loop->wait(sent ? -1 : PROGRESS_REFRESH_MS);
         MessageIterator it = this->_itf->receiveAllMessage(); // Receives all messages after wake up
 
         // Process all received messages
@@ -226,24 +251,91 @@ void Qube::QubeManager::discover()
         }
     }
 
+    std::stringstream ss;
+    ss << "Discover completed: " << _nofResponses << " responses accepted, "
+       << _nofDropped << " stale or duplicate dropped" << std::endl;
+    _logger->info(ss.str());
+
+    if (!_roster->save()) _logger->warning("Cannot save the roster into " + _roster->getPath().string());
+
     this->_qubeData.shutdown = true;
     this->_stateMachine->update(this->_qubeData);
 }
 
+bool Qube::QubeManager::warmStart()
+{
+    _roster = std::make_shared<WorkerRoster>(_conf->getLogRootFolder());
+    if (!_conf->isDiscoverEnabled() || !_roster->load()) return false;
+
+    std::vector<RosterEntry> workers = _roster->getRecentEntries(_conf->getRosterMaxAge_s());
+    if (workers.empty()) return false;
+
+    this->_responders.clear();
+    this->_nofResponses = 0;
+    this->_nofDropped = 0;
+
+    // The workers answer in about a round trip, the timeout only
+    // bounds the wait for those that are gone.
+    this->_itf->probeWorkers(workers);
+    this->_loop->setTimer(_timeout, std::max<unsigned int>(_conf->getRosterTimeout_ms(), 1));
+
+    while (_nofResponses < workers.size() && !this->_loop->isExpired(_timeout))
+    {
+        this->_loop->wait(); // Wait for a message or the timeout
+        MessageIterator it = this->_itf->receiveAllMessage(); // Receives all messages after wake up
+
+        // Process all received messages
+        for (auto message : it)
+        {
+            this->processMessage(message);
+        }
+    }
+
+    this->_loop->setTimer(_timeout, 0);
+
+    std::stringstream ss;
+    ss << "Warm start: " << _nofResponses << " of " << workers.size()
+       << " workers of the roster answered" << std::endl;
+    _logger->info(ss.str());
+
+    if (!_roster->save()) _logger->warning("Cannot save the roster into " + _roster->getPath().string());
+    return _nofResponses > 0;
+}
+
 void Qube::QubeManager::operative()
 {
+    // Nothing else is scheduled yet, the qube sleeps until a message arrives
+    while (!this->_qubeData.shutdown)
+    {
+        this->_loop->wait(); // Wait for a message
+        MessageIterator it = this->_itf->receiveAllMessage(); // Receives all messages after wake up
+
+        // Process all received messages
+        for (auto message : it)
+        {
+            this->processMessage(message);
+        }
+    }
+
+    this->_stateMachine->update(this->_qubeData);
 }
 
 void Qube::QubeManager::processMessage(const net::ReceivedData &recvData)
 {
     net::ByteBuffer_ptr buffer = recvData.data;
-    struct sockaddr_in *src = recvData.src;
+    const struct sockaddr_in *src = &recvData.src;
 
-    // Needs to check the message subtype
-    switch (net::Message::fetchMessageSubType(buffer))
+    // Route the message by peeking its header, without decoding it
+    net::MessageHeaderView header(*buffer);
+    if (!header.isValid()) return;
+
+    switch (header.getMessageSubType())
     {
     case net::Message::MessageSubType::DISCOVER_RESPONSE:
-        handleDiscoverResponse(buffer);
+        if (acceptDiscoverResponse(net::DiscoverResponseView(*buffer)))
+        {
+            handleDiscoverResponse(buffer);
+        }
         break;
 
     default:
@@ -251,9 +343,48 @@ void Qube::QubeManager::processMessage(const net::ReceivedData &recvData)
     }
 }
 
+bool Qube::QubeManager::acceptDiscoverResponse(const net::DiscoverResponseView &view)
+{
+    // Responses carry the counter of the Hello plus one, any other counter
+    // belongs to an older discover. Each qube must be counted only once,
+    // even if it answers more Hellos of a broadcast or multicast discover.
+    unsigned short expected = this->_itf->getDiscoverRound() + 1;
+
+    if (!view.isValid()
+        || view.getMessageType() != net::Message::MessageType::DISCOVER
+        || view.getMessageCounter() != expected)
+    {
+        _nofDropped++;
+        return false;
+    }
+
+    std::uint64_t responder = ((std::uint64_t)view.get<net::Schema::IpAddress>() << 16)
+                            | view.get<net::Schema::UdpPort>();
+    if (!_responders.insert(responder).second)
+    {
+        _nofDropped++;
+        return false;
+    }
+
+    _nofResponses++;
+    return true;
+}
+
 void Qube::QubeManager::handleDiscoverResponse(Lib::Network::ByteBuffer_ptr &buffer)
 {
-    net::DiscoverResponseMessage m_response(*buffer); // Decode the ByteBuffer into the message
+    net::ByteBufferView view(*buffer);
+    net::DiscoverResponseMessage m_response(view); // Decode the ByteBuffer in place into the message
+
+    // Remember the worker for the next startup
+    RosterEntry entry;
+    entry.addr = m_response.getIpAddress();
+    entry.udp_port = m_response.getUdpPort();
+    entry.tcp_port = m_response.getTcpPort();
+    entry.ram_mb = m_response.getAvailableMemory_mb();
+    entry.ram_kb = m_response.getAvailableMemory_kb();
+    entry.cpu_usage = m_response.getCpuUsage();
+    entry.last_seen = WorkerRoster::now_s();
+    _roster->update(entry);
 
     // Take some informations and print them ... for now
     std::cout << "Received a Reponse from ("
@@ -267,11 +398,9 @@ void Qube::QubeManager::handleDiscoverResponse(Lib::Network::ByteBuffer_ptr &buf
 
 void Qube::QubeWorker::operative()
 {
-    this->_timer->resetTimeout();
-
     while (1)
     {
-        this->_timer->wait(); // Wait for the wake up signal
+        this->_loop->wait(); // Wait for a message
         MessageIterator it = this->_itf->receiveAllMessage(); // Receives all messages after wake up
 
         // Process all received messages
@@ -285,10 +414,13 @@ void Qube::QubeWorker::operative()
 void Qube::QubeWorker::processMessage(const net::ReceivedData &recvData)
 {
     net::ByteBuffer_ptr buffer = recvData.data;
-    struct sockaddr_in *src = recvData.src;
+    const struct sockaddr_in *src = &recvData.src;
+
+    // Route the message by peeking its header, without decoding it
+    net::MessageHeaderView header(*buffer);
+    if (!header.isValid()) return;
 
-    // Needs to check the message subtype
-    switch (net::Message::fetchMessageSubType(buffer))
+    switch (header.getMessageSubType())
     {
     case net::Message::MessageSubType::DISCOVER_HELLO:
         handleDiscoverHello(buffer);
@@ -301,7 +433,11 @@ void Qube::QubeWorker::processMessage(const net::ReceivedData &recvData)
 
 void Qube::QubeWorker::handleDiscoverHello(net::ByteBuffer_ptr &buffer)
 {
-    net::DiscoverHelloMessage dhm(*buffer);
+    // Anyone on the subnet can send to the worker, a truncated Hello is dropped
+    if (!net::DiscoverHelloView(*buffer).isValid()) return;
+
+    net::ByteBufferView view(*buffer);
+    net::DiscoverHelloMessage dhm(view); // Decode in place, without copying the buffer
 
     // Take the data contained into the bytebuffer
     m_QubeMasterInfo.udp_port = dhm.getUdpPort();
@@ -1,14 +1,18 @@
 #ifndef _QUBE_H
 #define _QUBE_H
 
-#include <CommonLib/Concurrency/WakeUpTimer.hpp>
+#include <unordered_set>
+#include <CommonLib/Concurrency/EventLoop.hpp>
 #include <CommonLib/System/Metrics.hpp>
 #include <Qube/StateManager/State.hpp>
 #include <Qube/StateManager/StateMachine.hpp>
 #include <Qube/QubeInterface.hpp>
+#include <Qube/WorkerRoster.hpp>
 #include <Configuration/Configuration.hpp>
 #include <Logging/DisqubeLogger.hpp>
 
+#define DISCOVER_TIMEOUT_MS 1000 // Responses are waited this long after the last Hello
+
 namespace Qube
 {
     class Qube
@@ -27,7 +31,8 @@ namespace Qube
         StateManager::Transition::Input_t _qubeData;   // Some informations for state machine
         Configuration::DisqubeConfiguration_ptr _conf; // General configuration
         Logging::DisqubeLogger_ptr _logger;            // A single prompt/file Logger
-        Lib::Concurrency::WakeUpTimer_ptr _timer;      // The wake up timer
+        Lib::Concurrency::EventLoop_ptr _loop;         // Wakes up on messages and timers
+        int _timeout;                                  // Bounds the wait for the responses
 
         bool _shutdownFlag;    // A shutdown flag
         std::string _confFile; // The configuration file path
@@ -41,12 +46,14 @@ namespace Qube
         void init();     // The initial method (INIT State of State Machine)
         void shutdown(); // The shutdown state
 
+        // Probes the workers of the previous run, returns true if any answered
+        virtual bool warmStart();
         virtual void discover() = 0;
         virtual void operative() = 0;
         virtual void processMessage(const Lib::Network::ReceivedData &recvData) = 0;
 
     public:
-        Qube(const std::string &confFile) : _confFile(confFile), _shutdownFlag(false)
+        Qube(const std::string &confFile) : _timeout(-1), _shutdownFlag(false), _confFile(confFile)
         {
             memset(&this->_error, 0, sizeof(this->_error));
             this->initStateMachine();
@@ -61,14 +68,22 @@ namespace Qube
     class QubeManager : public Qube
     {
     private:
+        std::unordered_set<std::uint64_t> _responders; // Address and port of the qubes answered in this discover
+        unsigned int _nofResponses;                    // Number of accepted responses in this discover
+        unsigned int _nofDropped;                      // Number of stale or duplicate responses dropped
+        std::shared_ptr<WorkerRoster> _roster;         // The workers found so far, persisted
+
+        bool warmStart() override; // Probes the workers of the roster (INIT State of the State Machine)
         void discover() override;  // The discover state (DISCOVERING State of the State Machine)
         void operative() override; // The operative state
 
         void processMessage(const Lib::Network::ReceivedData &recvData) override;
+        bool acceptDiscoverResponse(const Lib::Network::DiscoverResponseView &view);
         void handleDiscoverResponse(Lib::Network::ByteBuffer_ptr& buffer);
 
     public:
-        QubeManager(const std::string &confFile) : Qube(confFile)
+        QubeManager(const std::string &confFile)
+            : Qube(confFile), _nofResponses(0), _nofDropped(0)
         {
             setMasterFlag(true);
         };
@@ -2,41 +2,47 @@
 
 namespace net = Lib::Network;
 namespace sys = Lib::System;
+namespace conc = Lib::Concurrency;
 
 using namespace Qube;
 
-void QubeMessageReceiver::getFromUdpInterface()
+void QubeMessageReceiver::dispatch(struct net::ReceivedData &data)
 {
-    try
-    {
-        struct net::ReceivedData data = this->_udpitf->getReceivedElement();
-        this->_queue->push(data);
-    }
-    catch (const std::runtime_error &re)
-    {
-        return;
-    }
+    data.dispatcher_ns = Lib::System::getRealTime_ns();
+    this->_queue->push(data);
 }
 
-void QubeMessageReceiver::getFromTcpInterface()
+bool QubeMessageReceiver::getFromUdpInterface()
 {
-    try
-    {
-        struct net::ReceivedData data = this->_tcpitf->getReceivedElement();
-        this->_queue->push(data);
-    }
-    catch (const std::runtime_error &re)
-    {
-        return;
-    }
+    struct net::ReceivedData data;
+    if (!this->_udpitf->tryGetReceivedElement(data)) return false;
+
+    this->dispatch(data);
+    return true;
+}
+
+bool QubeMessageReceiver::getFromTcpInterface()
+{
+    struct net::ReceivedData data;
+    if (!this->_tcpitf->tryGetReceivedElement(data)) return false;
+
+    this->dispatch(data);
+    return true;
 }
 
 void QubeMessageReceiver::run()
 {
     while (this->isRunning())
     {
-        this->getFromUdpInterface();
-        this->getFromTcpInterface();
+        this->_events->wait(); // Wait for a message on either interface
+
+        // The interfaces are drained in turn, so that none starves the other
+        bool any = true;
+        while (any && this->isRunning())
+        {
+            any = this->getFromUdpInterface();
+            any = this->getFromTcpInterface() || any;
+        }
     }
 }
 
@@ -48,13 +54,22 @@ bool QubeMessageReceiver::isRunning() const
 void QubeMessageReceiver::stop()
 {
     this->_sigstop = true;
+    this->_events->notify();
     if (this->isJoinable())
         this->join();
 }
 
 net::ReceivedData QubeMessageReceiver::getReceivedData()
 {
-    return this->_queue->pop();
+    net::ReceivedData data = this->_queue->pop();
+    data.handler_ns = Lib::System::getRealTime_ns();
+
+    _latencies.socket.record(data.kernel_ns, data.receiver_ns);
+    _latencies.listener.record(data.receiver_ns, data.dispatcher_ns);
+    _latencies.dispatcher.record(data.dispatcher_ns, data.handler_ns);
+    _latencies.total.record(data.kernel_ns != 0 ? data.kernel_ns : data.receiver_ns, data.handler_ns);
+
+    return data;
 }
 
 const std::size_t QubeMessageReceiver::getCurrentQueueSize() const
@@ -62,10 +77,29 @@ const std::size_t QubeMessageReceiver::getCurrentQueueSize() const
     return this->_queue->getNofElements();
 }
 
+const MessageLatencies &QubeMessageReceiver::getLatencies() const
+{
+    return this->_latencies;
+}
+
 void QubeInterface::initUdpInterface(const std::string &ip)
 {
     _udpitf = std::make_shared<net::UdpCommunicationInterface>(
-        ip, _conf->getUdpSenderPort(), _conf->getUdpListenerPort(), _conf->getUdpMaxCapacityQueue());
+        ip, _conf->getUdpSenderPort(), _conf->getUdpListenerPort(), _conf->getUdpMaxCapacityQueue(),
+        _conf->getUdpBatchSize(), _conf->isIoUringEnabled(), _conf->getUdpListenerShards());
+    _udpitf->enableCompression(_conf->getCompressionThreshold());
+    _udpitf->enableChecksum(_conf->isChecksumEnabled());
+    _udpitf->enableZeroCopy(_conf->getZeroCopyThreshold());
+    if (_conf->isLocalTransportEnabled()) _udpitf->enableLocalTransport();
+
+    // Without the unicast sweep the hellos come through the broadcast port
+    Configuration::DiscoveryMode mode = _conf->getDiscoveryMode();
+    if (mode != Configuration::DiscoveryMode::UNICAST)
+    {
+        std::string group = (mode == Configuration::DiscoveryMode::MULTICAST) ? _conf->getMulticastGroup() : "";
+        _udpitf->enableDiscoverySender();
+        _udpitf->enableDiscoveryListener(_conf->getBroadcastPort(), group);
+    }
 }
 
 void QubeInterface::initTcpInterface(const std::string &ip)
@@ -73,6 +107,9 @@ void QubeInterface::initTcpInterface(const std::string &ip)
     _tcpitf = std::make_shared<net::TcpCommunicationInterface>(
         ip, _conf->getTcpSenderPort(), _conf->getTcpListenerPort(),
         _conf->getTcpMaxNumOfConnections(), _conf->getTcpMaxCapacityQueue(), 200, 0);
+    _tcpitf->enableCompression(_conf->getCompressionThreshold());
+    _tcpitf->enableChecksum(_conf->isChecksumEnabled());
+    _tcpitf->enableZeroCopy(_conf->getZeroCopyThreshold());
 }
 
 void QubeInterface::logInit()
@@ -90,6 +127,11 @@ void QubeInterface::logInit()
     udp_ss << "\tNETWORK INTERFACE: " << itf;
     udp_ss << " SEND PORT: " << udp_sport;
     udp_ss << " LISTENING PORT: " << udp_lport;
+    udp_ss << " LISTENER SHARDS: " << _udpitf->getNofShards();
+    udp_ss << " LOCAL TRANSPORT: " << (_udpitf->isUsingLocalTransport() ? "ON" : "OFF");
+    udp_ss << " DISCOVERY PORT: ";
+    if (_udpitf->isUsingDiscoveryListener()) udp_ss << _conf->getBroadcastPort();
+    else udp_ss << "OFF";
 
     _logger->info(udp_ss.str());
 
@@ -113,7 +155,8 @@ void QubeInterface::init()
     initTcpInterface(ip); // Create Tcp Communication Interface
 
     // Creates the message receiver with the tcp and udp inteface
-    this->_receiver = std::make_shared<QubeMessageReceiver>(_udpitf, _tcpitf);
+    this->_loop = std::make_shared<conc::EventLoop>();
+    this->_receiver = std::make_shared<QubeMessageReceiver>(_udpitf, _tcpitf, _loop);
 
     // Logging initialization
     logInit();
@@ -136,8 +179,21 @@ void QubeInterface::start()
     this->_receiver->start();
 }
 
+void QubeInterface::logLatencies()
+{
+    const MessageLatencies &latencies = this->_receiver->getLatencies();
+    this->_logger->info("Latency SOCKET BUFFER:  " + latencies.socket.toString());
+    this->_logger->info("Latency LISTENER QUEUE: " + latencies.listener.toString());
+    this->_logger->info("Latency MESSAGE QUEUE:  " + latencies.dispatcher.toString());
+    this->_logger->info("Latency TOTAL:          " + latencies.total.toString());
+}
+
 void QubeInterface::stop()
 {
+    if (this->_sweep != nullptr) this->_sweep->stop();
+    if (this->_neighbours != nullptr) this->_neighbours->stop();
+    this->logLatencies();
+
     this->_logger->info("Shutting down UDP Communication Interface");
     this->_udpitf->close();
 
@@ -148,8 +204,52 @@ void QubeInterface::stop()
     this->_receiver->stop();
 }
 
+void QubeInterface::fillDiscoverHello(net::DiscoverHelloMessage &msg, const unsigned int ipaddr)
+{
+    msg.setUdpPort(_udpitf->getListenerPort());
+    msg.setTcpPort(_tcpitf->getListenerPort());
+    msg.setIpAddress(ipaddr);
+    msg.setMessageProtocol(net::Message::MessageProto::UDP);
+}
+
+void QubeInterface::groupDiscovering(const unsigned short round, const unsigned int ipaddr)
+{
+    // A single Hello reaches all the workers, it is repeated in case it gets lost
+    std::string addr = _conf->getMulticastGroup();
+    if (_conf->getDiscoveryMode() == Configuration::DiscoveryMode::BROADCAST)
+        addr = net::Socket::getBroadcastIp(_conf->getNetworkInterface());
+
+    unsigned short port = _conf->getBroadcastPort();
+    unsigned int repeat = std::max<unsigned int>(_conf->getDiscoveryRepeat(), 1);
+
+    std::stringstream ss;
+    ss << "Initializing Discover Mode: " << addr << ":" << port;
+    ss << " Repeat " << repeat << std::endl;
+    _logger->info(ss.str());
+
+    for (unsigned int idx = 0; idx < repeat; idx++)
+    {
+        if (idx > 0) std::this_thread::sleep_for(std::chrono::milliseconds(DISCOVER_REPEAT_INTERVAL_MS));
+        net::DiscoverHelloMessage m_discover(idx, round);
+        fillDiscoverHello(m_discover, ipaddr);
+        _udpitf->sendTo(addr, port, m_discover);
+    }
+}
+
 void QubeInterface::qubeDiscovering()
 {
+    // Each discover has its own counter, so responses to older ones can be told apart
+    unsigned short round = ++_discoverRound;
+
+    std::string ip = net::Socket::getInterfaceIp(_conf->getNetworkInterface());
+    unsigned int ipaddr = net::Socket::addressStringToNumber(ip);
+
+    if (_conf->getDiscoveryMode() != Configuration::DiscoveryMode::UNICAST)
+    {
+        groupDiscovering(round, ipaddr);
+        return;
+    }
+
     // Take the subnet configuration of the workers
     std::string subnetAddr = _conf->getQubesSubnetAddress();
     std::string subnetMask = _conf->getQubesSubnetMask();
@@ -168,29 +268,104 @@ void QubeInterface::qubeDiscovering()
     ss << "/" << sysNofBits << " Gateway " << subnetGtwy << std::endl;
     _logger->info(ss.str());
 
+    // A previous sweep still running is replaced by the new one
+    if (_sweep != nullptr) _sweep->stop();
+    _sweep = std::make_shared<DiscoverSweep>(_udpitf, _conf->getDiscoverRate(), _conf->getUdpBatchSize(), _loop);
+
+    // The neighbours known to be alive are probed first, so that the workers
+    // among them answer in about a round trip, then the rest of the subnet.
+    if (_neighbours == nullptr)
+    {
+        _neighbours = std::make_shared<net::NeighbourCache>(_conf->getNetworkInterface());
+        _neighbours->refresh();
+        _neighbours->start();
+    }
+
+    std::vector<unsigned int> addresses;
+    std::unordered_set<unsigned int> known;
+    for (unsigned int addr : _neighbours->getNeighbours())
+    {
+        if (addr < info.first || addr > info.last || addr == gatewayNum) continue;
+        if (known.insert(addr).second) addresses.push_back(addr);
+    }
+
+    std::size_t nofKnown = addresses.size();
+    // A 64 bits counter, so that the loop ends even if the last address is the highest one
+    for (std::uint64_t next = info.first; next <= info.last; next++)
+    {
+        // Skip the gateway address and the neighbours already probed
+        unsigned int addr = (unsigned int)next;
+        if (addr == gatewayNum || known.find(addr) != known.end()) continue;
+        addresses.push_back(addr);
+    }
+
+    std::stringstream known_ss;
+    known_ss << "Probing " << nofKnown << " known neighbours first" << std::endl;
+    _logger->info(known_ss.str());
+
+    // All the Hellos are prepared before sending the first one
     unsigned short messageId = 0;
+    for (unsigned int addr : addresses)
+    {
+        net::DiscoverHelloMessage m_discover(messageId++, round);
+        fillDiscoverHello(m_discover, ipaddr);
+        _sweep->add(addr, workerPort, m_discover);
+    }
+
+    _sweep->start();
+    _progress = std::make_unique<Logging::ProgressBar>(
+        0, std::max<std::size_t>(_sweep->getNofDatagrams(), 1), 1, "Sending Discover Hello Msg");
+}
+
+void QubeInterface::showDiscoverProgress()
+{
+    if (_progress == nullptr) return;
+
+    // Once the sweep is over the bar is completed, and not shown anymore
+    if (_sweep->isRunning())
+    {
+        _progress->update(_sweep->getNofDone());
+        return;
+    }
+
+    _progress->update(std::max<std::size_t>(_sweep->getNofDatagrams(), 1));
+    _progress.reset();
+}
+
+void QubeInterface::probeWorkers(const std::vector<RosterEntry> &workers)
+{
+    // A new round, so that only the answers to these Hellos are accepted
+    unsigned short round = ++_discoverRound;
 
     std::string ip = net::Socket::getInterfaceIp(_conf->getNetworkInterface());
     unsigned int ipaddr = net::Socket::addressStringToNumber(ip);
 
-    auto discover_fn = [&](int x)
+    std::stringstream ss;
+    ss << "Probing " << workers.size() << " workers of the roster" << std::endl;
+    _logger->info(ss.str());
+
+    unsigned short messageId = 0;
+    for (const RosterEntry &worker : workers)
     {
-        if (x == gatewayNum)
-            return; // Skip the gateway address
-        std::string addr_s = net::Socket::addressNumberToString(x, false);
-
-        // Send the UDP Discover message to the currrent ip address
-        net::DiscoverHelloMessage m_discover(messageId++, 0);
-        m_discover.setUdpPort(_udpitf->getListenerPort());
-        m_discover.setTcpPort(_tcpitf->getListenerPort());
-        m_discover.setIpAddress(ipaddr);
-        m_discover.setMessageProtocol(net::Message::MessageProto::UDP);
-
-        _udpitf->sendTo(addr_s, workerPort, m_discover);
-        std::this_thread::sleep_for(std::chrono::milliseconds(5));
-    };
-
-    Logging::ProgressBar::display(info.first, info.last + 1, 1, "Seding Discover Hello Msg", discover_fn);
+        net::DiscoverHelloMessage m_discover(messageId++, round);
+        fillDiscoverHello(m_discover, ipaddr);
+        _udpitf->sendTo(net::Socket::addressNumberToString(worker.addr, false), worker.udp_port, m_discover);
+    }
+}
+
+bool QubeInterface::isDiscovering() const
+{
+    return _sweep != nullptr && _sweep->isRunning();
+}
+
+unsigned short QubeInterface::getDiscoverRound() const
+{
+    return _discoverRound;
+}
+
+conc::EventLoop_ptr &QubeInterface::getEventLoop()
+{
+    return _loop;
 }
 
 void QubeInterface::interfaceDiagnosticCheck()
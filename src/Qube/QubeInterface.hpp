@@ -4,40 +4,71 @@
 #include <iostream>
 #include <string>
 #include <memory>
+#include <unordered_set>
 #include <CommonLib/Communication/Interface.hpp>
 #include <CommonLib/Communication/Message.hpp>
+#include <CommonLib/Communication/MessageView.hpp>
+#include <CommonLib/Communication/NeighbourCache.hpp>
+#include <CommonLib/Concurrency/EventLoop.hpp>
 #include <CommonLib/System/Metrics.hpp>
+#include <CommonLib/System/Latency.hpp>
 #include <Configuration/Configuration.hpp>
 #include <Logging/DisqubeLogger.hpp>
 #include <Logging/ProgressBar.hpp>
+#include <Qube/DiscoverSweep.hpp>
+#include <Qube/WorkerRoster.hpp>
+
+#define DISCOVER_REPEAT_INTERVAL_MS 50 // Between the Hellos of a broadcast or multicast discover
 
 namespace Qube
 {
+    // The latencies of the received messages through each stage
+    struct MessageLatencies
+    {
+        Lib::System::LatencyHistogram socket;     // From the kernel to the receiver
+        Lib::System::LatencyHistogram listener;   // From the receiver to the dispatcher
+        Lib::System::LatencyHistogram dispatcher; // From the dispatcher to the handler
+        Lib::System::LatencyHistogram total;      // From the kernel, or the receiver, to the handler
+    };
+
     class QubeMessageReceiver : public Lib::Concurrency::Thread
     {
     private:
         Lib::Concurrency::Queue_ptr<Lib::Network::ReceivedData> _queue; // The queue with all the messages
         Lib::Network::UdpCommunicationInterface_ptr _udpitf;            // Udp Communication Interface
         Lib::Network::TcpCommunicationInterface_ptr _tcpitf;            // Tcp Communication Interface
+        Lib::Concurrency::EventLoop_ptr _events;                        // Notified by the queues of both interfaces
+        MessageLatencies _latencies;                                    // Latencies of the taken messages
         bool _sigstop = false;
 
-        void getFromUdpInterface(); // Receives a message from the UDP interface
-        void getFromTcpInterface(); // Receives a message from the TCP interface
+        // Moves a message of the interface into the queue, if any. Returns false if there is none.
+        bool getFromUdpInterface();
+        bool getFromTcpInterface();
+        void dispatch(struct Lib::Network::ReceivedData &data);
 
     public:
         QubeMessageReceiver(const Lib::Network::UdpCommunicationInterface_ptr &udpitf,
-                            const Lib::Network::TcpCommunicationInterface_ptr &tcpitf)
+                            const Lib::Network::TcpCommunicationInterface_ptr &tcpitf,
+                            const Lib::Concurrency::EventLoop_ptr &loop)
             : Thread("Queue Message Dispatcher"), _udpitf(udpitf), _tcpitf(tcpitf)
         {
+            // Both the dispatcher and the qube sleep until there is a message for them
             _queue = std::make_shared<Lib::Concurrency::Queue<Lib::Network::ReceivedData>>(100);
+            _queue->setEventLoop(loop);
+
+            _events = std::make_shared<Lib::Concurrency::EventLoop>();
+            _udpitf->setEventLoop(_events);
+            _tcpitf->setEventLoop(_events);
         }
 
         void run() override;
         bool isRunning() const override;
         void stop();
 
+        // Takes the next message, recording its latencies through the stages
         Lib::Network::ReceivedData getReceivedData();
         const std::size_t getCurrentQueueSize() const;
+        const MessageLatencies &getLatencies() const;
     };
 
     typedef std::shared_ptr<QubeMessageReceiver> QubeMessageReceiver_ptr;
@@ -111,11 +142,18 @@ namespace Qube
         Lib::Network::UdpCommunicationInterface_ptr _udpitf; // Udp Communication Interface
         Lib::Network::TcpCommunicationInterface_ptr _tcpitf; // Tcp Communication Interface
         QubeMessageReceiver_ptr _receiver;                   // Qube message receiver
+        Lib::Concurrency::EventLoop_ptr _loop;               // Wakes up the qube on messages and timers
+        DiscoverSweep_ptr _sweep;                            // Sends the Hellos of the unicast discover
+        std::unique_ptr<Logging::ProgressBar> _progress;     // Progress of the sweep, while it is shown
+        Lib::Network::NeighbourCache_ptr _neighbours;        // Addresses probed first by the unicast discover
         Logging::DisqubeLogger_ptr _logger;                  // Generic logging class
         bool _isMaster;                                      // Master Qube interface or not.
+        unsigned short _discoverRound = 0;                   // Number of discover performed
 
         void initUdpInterface(const std::string &ip);
         void initTcpInterface(const std::string &ip);
+        void fillDiscoverHello(Lib::Network::DiscoverHelloMessage &msg, const unsigned int ipaddr);
+        void groupDiscovering(const unsigned short round, const unsigned int ipaddr); // Through broadcast or multicast
         void logInit();
         void init();
 
@@ -130,8 +168,18 @@ namespace Qube
         bool isMaster();                 // Check if the current interface is for a Master Qube
         void start();                    // Starts both UDP and TCP communication interface
         void stop();                     // Stops both UDP and TCP communication interface
-        void qubeDiscovering();          // Performs the Discover protocol
+        void qubeDiscovering();          // Starts the Discover protocol
+        void probeWorkers(const std::vector<RosterEntry> &workers); // Sends a Hello to each known worker
+        bool isDiscovering() const;      // If the Hellos of the discover are still being sent
+        void showDiscoverProgress();     // Draws the progress of the sweep, from the thread handling the responses
         void interfaceDiagnosticCheck(); // Performs a check on TCP and UDP Interface
+        void logLatencies();             // Logs the latencies of the received messages
+
+        // The counter carried by the Hello messages of the last discover
+        unsigned short getDiscoverRound() const;
+
+        // The loop notified whenever a message can be taken with receiveAllMessage
+        Lib::Concurrency::EventLoop_ptr &getEventLoop();
 
         Lib::Network::DiagnosticCheckResult *getUdpDiagnosticResult(); // Obtain result from UDP
         Lib::Network::DiagnosticCheckResult *getTcpDiagnosticResult(); // Obtain result from TCP
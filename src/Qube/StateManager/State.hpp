@@ -29,6 +29,7 @@ namespace Qube::StateManager
             bool anyWorker;    // If any worker is still alive
             bool maintenance;  // If is the time to go in maintenance
             bool shutdown;     // Shutdown flag
+            bool rosterValid;  // Some workers of the roster answered at startup
         };
 
         typedef std::function<bool(struct Input_t &)> _Condition_t;
@@ -0,0 +1,120 @@
+#include "WorkerRoster.hpp"
+
+namespace net = Lib::Network;
+
+bool Qube::WorkerRoster::load()
+{
+    _entries.clear();
+
+    std::ifstream file(_path, std::ios::binary);
+    if (!file.is_open()) return false;
+
+    std::vector<unsigned char> content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (content.size() < HEADER_SIZE) return false;
+
+    net::ByteBuffer buffer(content.data(), content.size());
+    buffer.position(0);
+
+    unsigned int magic = buffer.getInt();
+    unsigned short version = buffer.getShort();
+    unsigned int nofRecords = buffer.getInt();
+    if (magic != ROSTER_MAGIC || version != ROSTER_VERSION) return false;
+    if (content.size() != HEADER_SIZE + (std::size_t)nofRecords * RECORD_SIZE) return false;
+
+    _entries.resize(nofRecords);
+    for (RosterEntry &entry : _entries)
+    {
+        entry.addr = buffer.getInt();
+        entry.udp_port = buffer.getShort();
+        entry.tcp_port = buffer.getShort();
+        entry.ram_mb = buffer.getInt();
+        entry.ram_kb = buffer.getInt();
+        entry.cpu_usage = buffer.get();
+        entry.last_seen = buffer.getLong();
+    }
+
+    return true;
+}
+
+bool Qube::WorkerRoster::save() const
+{
+    std::error_code error;
+    std::filesystem::create_directories(_path.parent_path(), error);
+    if (error) return false;
+
+    net::ByteBuffer buffer(HEADER_SIZE + _entries.size() * RECORD_SIZE);
+    buffer.put((unsigned int)ROSTER_MAGIC);
+    buffer.put((unsigned short)ROSTER_VERSION);
+    buffer.put((unsigned int)_entries.size());
+
+    for (const RosterEntry &entry : _entries)
+    {
+        buffer.put(entry.addr);
+        buffer.put(entry.udp_port);
+        buffer.put(entry.tcp_port);
+        buffer.put(entry.ram_mb);
+        buffer.put(entry.ram_kb);
+        buffer.put(entry.cpu_usage);
+        buffer.put((uint64_t)entry.last_seen);
+    }
+
+    // Written apart and renamed, so that a crash never leaves half a roster
+    std::filesystem::path tmp = _path;
+    tmp += ".tmp";
+    {
+        std::ofstream file(tmp, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) return false;
+        file.write((const char*)buffer.getData(), buffer.getBufferSize());
+        if (!file.good()) return false;
+    }
+
+    std::filesystem::rename(tmp, _path, error);
+    return !error;
+}
+
+void Qube::WorkerRoster::update(const RosterEntry &entry)
+{
+    for (RosterEntry &known : _entries)
+    {
+        if (known.addr == entry.addr && known.udp_port == entry.udp_port)
+        {
+            known = entry;
+            return;
+        }
+    }
+
+    _entries.push_back(entry);
+}
+
+void Qube::WorkerRoster::clear()
+{
+    _entries.clear();
+}
+
+std::vector<Qube::RosterEntry> Qube::WorkerRoster::getRecentEntries(const std::uint64_t maxAge_s) const
+{
+    std::uint64_t now = now_s();
+    std::vector<RosterEntry> recent;
+    for (const RosterEntry &entry : _entries)
+    {
+        if (entry.last_seen + maxAge_s >= now) recent.push_back(entry);
+    }
+
+    return recent;
+}
+
+const std::vector<Qube::RosterEntry> &Qube::WorkerRoster::getEntries() const
+{
+    return _entries;
+}
+
+const std::filesystem::path &Qube::WorkerRoster::getPath() const
+{
+    return _path;
+}
+
+std::uint64_t Qube::WorkerRoster::now_s()
+{
+    return std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
@@ -0,0 +1,73 @@
+#ifndef _WORKERROSTER_H
+#define _WORKERROSTER_H
+
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <CommonLib/Communication/ByteBuffer.hpp>
+
+#define ROSTER_MAGIC 0x44515253 // "DQRS", the first bytes of a roster file
+#define ROSTER_VERSION 1        // Version of the layout of the records
+#define ROSTER_FOLDER "state"   // Folder of the roster, under the logging folder
+#define ROSTER_FILE "roster.bin"
+
+namespace Qube
+{
+    // A worker found by a discover, with the content of its last response
+    struct RosterEntry
+    {
+        unsigned int   addr;      // The IP address number of the worker
+        unsigned short udp_port;  // The UDP Port of the worker
+        unsigned short tcp_port;  // The TCP Port of the worker
+        unsigned int   ram_mb;    // Free RAM in its last response, MB part
+        unsigned int   ram_kb;    // Free RAM in its last response, KB part
+        unsigned char  cpu_usage; // CPU usage in its last response
+        std::uint64_t  last_seen; // Seconds since the epoch of its last response
+    };
+
+    /**
+     * @class Qube::WorkerRoster
+     *
+     * The workers found by the previous discovers, persisted into a binary
+     * file so that a restarted master can probe them directly instead of
+     * sweeping the whole subnet. The file is a header (magic, version and
+     * number of records) followed by fixed size big-endian records.
+     */
+    class WorkerRoster
+    {
+    private:
+        std::filesystem::path _path;       // The roster file
+        std::vector<RosterEntry> _entries; // The known workers
+
+    public:
+        const static std::size_t HEADER_SIZE = 10; // Magic, version and number of records
+        const static std::size_t RECORD_SIZE = 25; // Size of a single RosterEntry
+
+        WorkerRoster(const std::string &folder)
+            : _path(std::filesystem::path(folder) / ROSTER_FOLDER / ROSTER_FILE) {};
+
+        // Reads the roster file, returns false if it is missing or invalid,
+        // in which case the roster is left empty
+        bool load();
+
+        // Writes the roster file, replacing the previous one at once
+        bool save() const;
+
+        // Adds the worker, or replaces the one with the same address and port
+        void update(const RosterEntry &entry);
+        void clear();
+
+        // The workers seen in the last maxAge_s seconds
+        std::vector<RosterEntry> getRecentEntries(const std::uint64_t maxAge_s) const;
+        const std::vector<RosterEntry> &getEntries() const;
+        const std::filesystem::path &getPath() const;
+
+        static std::uint64_t now_s(); // Seconds since the epoch
+    };
+}
+
+#endif
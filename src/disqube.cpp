@@ -1,9 +1,9 @@
 #include <iostream>
+#include <csignal>
 #include <CommonLib/CLI/ArgumentParser.hpp>
 #include <Qube/Qube.hpp>
 
 namespace cli = Lib::CLI;
-namespace conc = Lib::Concurrency;
 
 Qube::Qube* qube = nullptr;
 
@@ -24,8 +24,6 @@ int main(int argc, const char* argv[])
     bool masterFlag = argparse.getBoolean("master");
     std::string confFile = argparse.getString("config");
 
-    conc::AbstractTimerable::prepareSignals();
-
     if (masterFlag)
     {
         qube = new Qube::QubeManager(confFile);
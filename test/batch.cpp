@@ -0,0 +1,172 @@
+#include <iostream>
+#include <CommonLib/Communication/Interface.hpp>
+#include <CommonLib/Communication/MessageView.hpp>
+#include "Test.hpp"
+
+using ByteBufferView = Lib::Network::ByteBufferView;
+using Message = Lib::Network::Message;
+using SimpleMessage = Lib::Network::SimpleMessage;
+using DiscoverHelloMessage = Lib::Network::DiscoverHelloMessage;
+using BatchMessage = Lib::Network::BatchMessage;
+using BatchMessageView = Lib::Network::BatchMessageView;
+using BatchingSender = Lib::Network::BatchingSender;
+using UdpSender = Lib::Network::UdpSender;
+using UdpCommunicationInterface = Lib::Network::UdpCommunicationInterface;
+using ReceivedData = Lib::Network::ReceivedData;
+
+using namespace Test;
+
+// A sender that counts the datagrams it sends
+class CountingSender : public UdpSender
+{
+public:
+    int nofSends = 0;
+
+    CountingSender(const std::string &ip, unsigned short port) : UdpSender(ip, port) {};
+
+    bool sendTo(const std::string &ip, const unsigned short port, unsigned char *buff, const std::size_t n)
+    {
+        nofSends++;
+        return UdpSender::sendTo(ip, port, buff, n);
+    }
+
+    using UdpSender::sendTo;
+};
+
+void test_batch_message()
+{
+    std::cout << "[TEST 1/4] Batch Encode/Decode: ";
+    BatchMessage batch(1, 0);
+
+    for (int idx = 0; idx < 5; idx++)
+    {
+        DiscoverHelloMessage hello(idx, 0);
+        hello.setUdpPort(1000 + idx);
+        hello.setMessageProtocol(Message::MessageProto::UDP);
+        assert_eq<bool>(batch.add(hello), true);
+    }
+
+    batch.encode();
+    assert_eq<std::size_t>(batch.getBufferSize(), batch.getEncodedSize());
+
+    // Both the decoded batch and the view give back the same messages
+    BatchMessage decoded(ByteBufferView(batch.getData(), batch.getBufferSize()));
+    BatchMessageView view(batch);
+    assert_eq<bool>(view.isValid(), true);
+    assert_eq<std::size_t>(decoded.getNofMessages(), 5);
+    assert_eq<std::size_t>(view.getNofMessages(), 5);
+
+    for (std::size_t idx = 0; idx < 5; idx++)
+    {
+        DiscoverHelloMessage fromBatch(decoded.getMessage(idx));
+        DiscoverHelloMessage fromView(view.getMessage(idx));
+        assert_eq<unsigned short>(fromBatch.getUdpPort(), 1000 + idx);
+        assert_eq<unsigned short>(fromView.getUdpPort(), 1000 + idx);
+        assert_eq<unsigned short>(fromView.getMessageId(), idx);
+    }
+
+    // A batch never grows beyond its capacity
+    BatchMessage small(2, 0, BatchMessage::getEncodedSize(1, DiscoverHelloMessage::WIRE_SIZE));
+    DiscoverHelloMessage hello(0, 0);
+    assert_eq<bool>(small.add(hello), true);
+    assert_eq<bool>(small.add(hello), false);
+    std::cout << "Passed" << std::endl;
+}
+
+void test_invalid_batch()
+{
+    std::cout << "[TEST 2/4] Invalid Batches are rejected: ";
+    BatchMessage batch(1, 0);
+    DiscoverHelloMessage hello(0, 0);
+    batch.add(hello);
+    batch.add(hello);
+    batch.encode();
+
+    // Truncated messages and other message types are not batches
+    assert_eq<bool>(BatchMessageView(batch.getData(), batch.getBufferSize() - 1).isValid(), false);
+    assert_eq<bool>(BatchMessageView(hello).isValid(), false);
+
+    // Offsets going backward are not accepted
+    unsigned char raw[256];
+    memcpy(raw, batch.getData(), batch.getBufferSize());
+    raw[BatchMessage::WIRE_SIZE + 2] = 0;
+    raw[BatchMessage::WIRE_SIZE + 3] = 0;
+    assert_eq<bool>(BatchMessageView(raw, batch.getBufferSize()).isValid(), false);
+    assert_eq<std::size_t>(BatchMessage(ByteBufferView(raw, batch.getBufferSize())).getNofMessages(), 0);
+
+    // Neither are bytes past the last message
+    memcpy(raw, batch.getData(), batch.getBufferSize());
+    assert_eq<bool>(BatchMessageView(raw, batch.getBufferSize() + 1).isValid(), false);
+    assert_eq<std::size_t>(BatchMessage(ByteBufferView(raw, batch.getBufferSize() + 1)).getNofMessages(), 0);
+    std::cout << "Passed" << std::endl;
+}
+
+void test_batching_sender()
+{
+    UdpCommunicationInterface receiver("127.0.0.1", 1410, 1411, 64);
+    receiver.start();
+
+    std::shared_ptr<CountingSender> counting = std::make_shared<CountingSender>("127.0.0.1", 1412);
+    std::string text = "heartbeat";
+
+    std::cout << "[TEST 3/4] Flush on size threshold: ";
+    {
+        BatchingSender batcher(counting, 160, 1000000);
+        batcher.start();
+
+        // 12 + 2 + 9 * (2 + 21) = 221 bytes, hence two batches
+        for (int idx = 0; idx < 9; idx++)
+        {
+            SimpleMessage msg(idx, 0, text);
+            batcher.sendTo("127.0.0.1", 1411, msg);
+        }
+
+        assert_eq<int>(counting->nofSends, 1);
+        batcher.stop();
+        assert_eq<int>(counting->nofSends, 2);
+    }
+
+    // The receiver unpacks the batches transparently
+    for (int idx = 0; idx < 9; idx++)
+    {
+        ReceivedData data = receiver.getReceivedElement();
+        SimpleMessage recv(*data.data);
+        assert_eq<unsigned short>(recv.getMessageId(), idx);
+        assert_eq<std::string>(recv.getMessage(), text);
+    }
+
+    std::cout << "Passed" << std::endl;
+
+    std::cout << "[TEST 4/4] Flush on time threshold: ";
+    {
+        BatchingSender batcher(counting, 1400, 20000);
+        batcher.start();
+
+        for (int idx = 0; idx < 3; idx++)
+        {
+            SimpleMessage msg(idx, 0, text);
+            batcher.sendTo("127.0.0.1", 1411, msg);
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        assert_eq<int>(counting->nofSends, 3);
+    }
+
+    for (int idx = 0; idx < 3; idx++)
+    {
+        ReceivedData data = receiver.getReceivedElement();
+        SimpleMessage recv(*data.data);
+        assert_eq<unsigned short>(recv.getMessageId(), idx);
+    }
+
+    receiver.close();
+    std::cout << "Passed" << std::endl;
+}
+
+int main()
+{
+    test_batch_message();
+    test_invalid_batch();
+    test_batching_sender();
+    return 0;
+}
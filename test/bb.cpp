@@ -38,7 +38,7 @@ void test_values(ByteBuffer& bb)
 
 void test_be(ByteBuffer& bb)
 {
-    std::cout << "[TEST 1/3] Testing BigEndian Byte Order" << std::endl;
+    std::cout << "[TEST 1/6] Testing BigEndian Byte Order" << std::endl;
     bb.clear();
     bb.setByteOrder(ByteOrder::BigEndian);
     set_fields(bb);
@@ -47,7 +47,7 @@ void test_be(ByteBuffer& bb)
 
 void test_le(ByteBuffer& bb)
 {
-    std::cout << "[TEST 2/3] Testing LittleEndian Byte Order" << std::endl;
+    std::cout << "[TEST 2/6] Testing LittleEndian Byte Order" << std::endl;
     bb.clear();
     bb.setByteOrder(ByteOrder::LittleEndian);
     set_fields(bb);
@@ -56,7 +56,7 @@ void test_le(ByteBuffer& bb)
 
 void test_copy_constr(ByteBuffer& bb)
 {
-    std::cout << "[TEST 3/3] Testing Copy Constructor" << std::endl;
+    std::cout << "[TEST 3/6] Testing Copy Constructor" << std::endl;
     bb.position(0);
 
     ByteBuffer bb_c(bb);
@@ -74,12 +74,122 @@ void test_copy_constr(ByteBuffer& bb)
     assert_neq<unsigned char>(bb_c.get(), bb.get());
 }
 
+void test_wire_layout()
+{
+    std::cout << "[TEST 4/6] Testing Wire Layout" << std::endl;
+    ByteBuffer bb(16);
+    bb.put((unsigned short)0x1234);
+    bb.put((unsigned int)0x11223344);
+
+    // The encoding on the wire must never change between versions
+    const unsigned char expected[] = {0x34, 0x12, 0x33, 0x44, 0x11, 0x22};
+    for (std::size_t idx = 0; idx < sizeof(expected); idx++)
+    {
+        assert_eq<unsigned int>(bb.getData()[idx], expected[idx]);
+    }
+}
+
+void test_bulk(ByteOrder order)
+{
+    const std::size_t count = 37; // Not a multiple of any SIMD block
+    uint16_t shorts[count];
+    uint32_t ints[count];
+    uint64_t longs[count];
+
+    for (std::size_t idx = 0; idx < count; idx++)
+    {
+        shorts[idx] = 0x0102 * (idx + 1);
+        ints[idx] = 0x01020304 * (idx + 1);
+        longs[idx] = 0x0102030405060708ULL * (idx + 1);
+    }
+
+    const std::size_t nofBytes = count * (2 + 4 + 8);
+    ByteBuffer bulk(nofBytes);
+    ByteBuffer scalar(nofBytes);
+    bulk.setByteOrder(order);
+    scalar.setByteOrder(order);
+
+    bulk.put(shorts, count);
+    bulk.put(ints, count);
+    bulk.put(longs, count);
+
+    for (std::size_t idx = 0; idx < count; idx++) scalar.put((unsigned short)shorts[idx]);
+    for (std::size_t idx = 0; idx < count; idx++) scalar.put((unsigned int)ints[idx]);
+    for (std::size_t idx = 0; idx < count; idx++) scalar.put(longs[idx]);
+
+    // Bulk and scalar put must produce the very same bytes
+    assert_eq<std::size_t>(bulk.getBufferSize(), scalar.getBufferSize());
+    assert_eq<int>(memcmp(bulk.getData(), scalar.getData(), nofBytes), 0);
+
+    uint16_t shorts_out[count];
+    uint32_t ints_out[count];
+    uint64_t longs_out[count];
+
+    bulk.position(0);
+    bulk.getShorts(shorts_out, count);
+    bulk.getInts(ints_out, count);
+    bulk.getLongs(longs_out, count);
+
+    for (std::size_t idx = 0; idx < count; idx++)
+    {
+        assert_eq<uint16_t>(shorts_out[idx], shorts[idx]);
+        assert_eq<uint32_t>(ints_out[idx], ints[idx]);
+        assert_eq<uint64_t>(longs_out[idx], longs[idx]);
+    }
+
+    // Single values must be readable from the bulk encoded buffer
+    bulk.position(0);
+    assert_eq<unsigned short>(bulk.getShort(), shorts[0]);
+    bulk.position(count * 2);
+    assert_eq<unsigned int>(bulk.getInt(), ints[0]);
+    bulk.position(count * 6);
+    assert_eq<uint64_t>(bulk.getLong(), longs[0]);
+}
+
+void test_bulk_orders()
+{
+    std::cout << "[TEST 5/6] Testing Bulk Put/Get" << std::endl;
+    test_bulk(ByteOrder::BigEndian);
+    test_bulk(ByteOrder::LittleEndian);
+}
+
+void test_storage()
+{
+    std::cout << "[TEST 6/6] Testing Inline and Heap Storage" << std::endl;
+    ByteBuffer bb(1024);
+    const unsigned char *inlineData = bb.getData();
+
+    // Small contents never leave the inline storage
+    for (unsigned int idx = 0; idx < ByteBuffer::INLINE_CAPACITY / 4; idx++) bb.put(idx);
+    assert_eq<const unsigned char*>(bb.getData(), inlineData);
+
+    // Going past it moves the content to the heap
+    for (unsigned int idx = 0; idx < 64; idx++) bb.put(idx + 1000);
+    assert_neq<const unsigned char*>(bb.getData(), inlineData);
+    assert_eq<std::size_t>(bb.getBufferSize(), ByteBuffer::INLINE_CAPACITY + 256);
+
+    bb.position(0);
+    for (unsigned int idx = 0; idx < ByteBuffer::INLINE_CAPACITY / 4; idx++)
+    {
+        assert_eq<unsigned int>(bb.getInt(), idx);
+    }
+
+    for (unsigned int idx = 0; idx < 64; idx++) assert_eq<unsigned int>(bb.getInt(), idx + 1000);
+
+    // The copy of a large buffer holds the very same content
+    ByteBuffer copy(bb);
+    assert_eq<int>(memcmp(copy.getData(), bb.getData(), bb.getBufferSize()), 0);
+}
+
 int main()
 {
     ByteBuffer bb(16);
     test_be(bb);
     test_le(bb);
     test_copy_constr(bb);
+    test_wire_layout();
+    test_bulk_orders();
+    test_storage();
 
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,88 @@
+#include <iostream>
+#include <string>
+#include <string.h>
+
+#include <CommonLib/Communication/ByteBuffer.hpp>
+#include <CommonLib/Communication/ByteBufferView.hpp>
+#include <CommonLib/Communication/Message.hpp>
+#include "Test.hpp"
+
+using ByteBuffer = Lib::Network::ByteBuffer;
+using ByteBufferView = Lib::Network::ByteBufferView;
+using ByteOrder = Lib::Network::ByteBuffer::ByteOrder;
+using Message = Lib::Network::Message;
+using DiscoverHelloMessage = Lib::Network::DiscoverHelloMessage;
+
+using namespace Test;
+
+void test_values(ByteOrder order)
+{
+    ByteBuffer bb(16);
+    bb.setByteOrder(order);
+    bb.put((unsigned char)1);
+    bb.put((unsigned short)0x1234);
+    bb.put((unsigned int)0x1234abcd);
+
+    std::string msg = "Ciao";
+    bb.put((unsigned char*)msg.c_str(), msg.length());
+
+    // The view must read exactly what the ByteBuffer has written
+    ByteBufferView view(bb);
+    assert_eq<unsigned char>(view.get(), 1);
+    assert_eq<unsigned short>(view.getShort(), 0x1234);
+    assert_eq<unsigned int>(view.getInt(), 0x1234abcd);
+
+    char out[5];
+    memset(out, 0, sizeof(out));
+    view.getBuffer((unsigned char*)out, 4);
+    assert_eq_str(out, "Ciao", 5);
+    assert_eq<std::size_t>(view.getRemainingSize(), 0);
+
+    // The view does not own the data, it points to the buffer content
+    assert_eq<const unsigned char*>(view.getData(), bb.getData());
+}
+
+void test_be()
+{
+    std::cout << "[TEST 1/3] Testing BigEndian Byte Order: ";
+    test_values(ByteOrder::BigEndian);
+    std::cout << "Passed" << std::endl;
+}
+
+void test_le()
+{
+    std::cout << "[TEST 2/3] Testing LittleEndian Byte Order: ";
+    test_values(ByteOrder::LittleEndian);
+    std::cout << "Passed" << std::endl;
+}
+
+void test_message_decode()
+{
+    std::cout << "[TEST 3/3] Decoding a Message from a raw view: ";
+    DiscoverHelloMessage hello(7, 3);
+    hello.setUdpPort(1234);
+    hello.setTcpPort(4321);
+    hello.setIpAddress(0x0a000001);
+    hello.setMessageProtocol(Message::MessageProto::UDP);
+    hello.encode();
+
+    ByteBufferView view(hello.getData(), hello.getBufferSize());
+    assert_eq<int>((int)Message::fetchMessageSubType(view), (int)Message::MessageSubType::DISCOVER_HELLO);
+
+    DiscoverHelloMessage decoded(view);
+    assert_eq<unsigned short>(decoded.getMessageId(), 7);
+    assert_eq<unsigned short>(decoded.getMessageCounter(), 3);
+    assert_eq<unsigned short>(decoded.getUdpPort(), 1234);
+    assert_eq<unsigned short>(decoded.getTcpPort(), 4321);
+    assert_eq<unsigned int>(decoded.getIpAddress(), 0x0a000001);
+    std::cout << "Passed" << std::endl;
+}
+
+int main()
+{
+    test_be();
+    test_le();
+    test_message_decode();
+
+    return 0;
+}
@@ -0,0 +1,156 @@
+#include <iostream>
+#include <random>
+#include <CommonLib/Communication/Interface.hpp>
+#include <CommonLib/Communication/MessageView.hpp>
+#include "Test.hpp"
+
+using ByteBuffer = Lib::Network::ByteBuffer;
+using LZCompressor = Lib::Network::LZCompressor;
+using Message = Lib::Network::Message;
+using MessageHeaderView = Lib::Network::MessageHeaderView;
+using SimpleMessage = Lib::Network::SimpleMessage;
+using UdpCommunicationInterface = Lib::Network::UdpCommunicationInterface;
+using ReceivedData = Lib::Network::ReceivedData;
+namespace Schema = Lib::Network::Schema;
+
+using namespace Test;
+
+// Text-like content, that repeats a small vocabulary
+std::string makeText(const std::size_t nofBytes)
+{
+    const char *words[] = {"job ", "input ", "result ", "qube ", "worker ", "master ", "task-", "42 "};
+    std::mt19937 gen(7);
+    std::string text;
+    while (text.size() < nofBytes) text += words[gen() % 8];
+    text.resize(nofBytes);
+    return text;
+}
+
+void test_round_trip()
+{
+    std::cout << "[TEST 1/4] Compress/Decompress: ";
+    std::mt19937 gen(11);
+    std::vector<unsigned char> random(5000);
+    for (auto &byte : random) byte = gen() & 0xFF;
+
+    std::string text = makeText(20000);
+    std::string run(3000, 'a');
+    std::vector<std::pair<const unsigned char*, std::size_t>> inputs = {
+        {(const unsigned char*)text.data(), text.size()},
+        {(const unsigned char*)run.data(), run.size()},
+        {random.data(), random.size()},
+        {(const unsigned char*)"tiny", 4}
+    };
+
+    for (auto &input : inputs)
+    {
+        std::vector<unsigned char> compressed(LZCompressor::getMaxCompressedSize(input.second));
+        std::size_t size = LZCompressor::compress(input.first, input.second, compressed.data(), compressed.size());
+        assert_neq<std::size_t>(size, 0);
+
+        std::vector<unsigned char> output(input.second);
+        assert_eq<bool>(LZCompressor::decompress(compressed.data(), size, output.data(), output.size()), true);
+        assert_eq<bool>(memcmp(output.data(), input.first, input.second) == 0, true);
+    }
+
+    // Repetitive content shrinks a lot, random content does not fit a smaller output
+    std::vector<unsigned char> compressed(text.size());
+    std::size_t size = LZCompressor::compress((const unsigned char*)text.data(), text.size(), compressed.data(), text.size());
+    assert_eq<bool>(size * 2 < text.size(), true);
+    assert_eq<std::size_t>(LZCompressor::compress(random.data(), random.size(), compressed.data(), random.size() - 1), 0);
+    std::cout << "Passed" << std::endl;
+}
+
+void test_corrupted()
+{
+    std::cout << "[TEST 2/4] Corrupted blocks are rejected: ";
+    std::string text = makeText(4000);
+    std::vector<unsigned char> compressed(text.size());
+    std::size_t size = LZCompressor::compress((const unsigned char*)text.data(), text.size(), compressed.data(), text.size());
+    std::vector<unsigned char> output(text.size());
+
+    // Truncated block, wrong size and garbage never write out of bounds
+    assert_eq<bool>(LZCompressor::decompress(compressed.data(), size - 3, output.data(), output.size()), false);
+    assert_eq<bool>(LZCompressor::decompress(compressed.data(), size, output.data(), output.size() - 1), false);
+
+    std::mt19937 gen(3);
+    for (int round = 0; round < 1000; round++)
+    {
+        std::vector<unsigned char> garbage(compressed.begin(), compressed.begin() + size);
+        garbage[gen() % size] ^= 1 + gen() % 255;
+        LZCompressor::decompress(garbage.data(), garbage.size(), output.data(), output.size());
+    }
+
+    std::cout << "Passed" << std::endl;
+}
+
+void test_message()
+{
+    std::cout << "[TEST 3/4] Compressed Messages: ";
+    std::string text = makeText(3000);
+    SimpleMessage msg(5, 9, text);
+    msg.setMessageProtocol(Message::MessageProto::UDP);
+    msg.encode();
+
+    std::vector<unsigned char> compressed(msg.getBufferSize());
+    std::size_t size = Message::compress(msg.getData(), msg.getBufferSize(), compressed.data(), compressed.size());
+    assert_neq<std::size_t>(size, 0);
+
+    // The header is still readable, and tells that the body is compressed
+    MessageHeaderView header(compressed.data(), size);
+    assert_eq<bool>(header.isCompressed(), true);
+    assert_eq<unsigned short>(header.getMessageId(), 5);
+    assert_eq<uint32_t>(header.getMessageLength(), size);
+    assert_eq<bool>(header.getMessageProtocol() == Message::MessageProto::UDP, true);
+
+    // The size claimed by the message is bounded by the transport
+    assert_eq<std::size_t>(Message::getDecompressedSize(compressed.data(), size), msg.getBufferSize());
+    assert_eq<std::size_t>(Message::getDecompressedSize(compressed.data(), size, msg.getBufferSize() - 1), 0);
+
+    std::vector<unsigned char> forged(compressed.begin(), compressed.begin() + size);
+    Schema::Compressed::Record claim;
+    Schema::Compressed::decode(forged.data() + Message::NUM_HEAD_BYTES, claim, true);
+    claim.set<Schema::BodyLength>(8 * 1024 * 1024);
+    Schema::Compressed::encode(forged.data() + Message::NUM_HEAD_BYTES, claim, true);
+    assert_eq<std::size_t>(Message::getDecompressedSize(forged.data(), size, Lib::Network::MAX_MESSAGE_CAPACITY), 0);
+
+    ByteBuffer restored(msg.getBufferSize());
+    assert_eq<bool>(Message::decompress(compressed.data(), size, restored), true);
+    assert_eq<bool>(memcmp(restored.getData(), msg.getData(), msg.getBufferSize()) == 0, true);
+    assert_eq<std::string>(SimpleMessage(restored).getMessage(), text);
+    std::cout << "Passed" << std::endl;
+}
+
+void test_interface()
+{
+    std::cout << "[TEST 4/4] Compression between two interfaces: ";
+    UdpCommunicationInterface udp_int_1("127.0.0.1", 1430, 1431, 4);
+    UdpCommunicationInterface udp_int_2("127.0.0.1", 1432, 1433, 4);
+    udp_int_1.enableCompression(256);
+    udp_int_1.start();
+    udp_int_2.start();
+
+    // Larger than a receive buffer before compression
+    std::string text = makeText(6000), small = "small";
+    SimpleMessage large(1, 1, text), tiny(1, 2, small);
+    udp_int_1.sendTo("127.0.0.1", 1433, large);
+    udp_int_1.sendTo("127.0.0.1", 1433, tiny);
+
+    ReceivedData data1 = udp_int_2.getReceivedElement();
+    assert_eq<std::string>(SimpleMessage(*data1.data).getMessage(), text);
+    ReceivedData data2 = udp_int_2.getReceivedElement();
+    assert_eq<std::string>(SimpleMessage(*data2.data).getMessage(), small);
+
+    udp_int_1.close();
+    udp_int_2.close();
+    std::cout << "Passed" << std::endl;
+}
+
+int main()
+{
+    test_round_trip();
+    test_corrupted();
+    test_message();
+    test_interface();
+    return 0;
+}
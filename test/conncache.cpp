@@ -0,0 +1,173 @@
+#include <iostream>
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include <CommonLib/Communication/Sender.hpp>
+#include <CommonLib/Communication/Listener.hpp>
+#include "Test.hpp"
+
+using TcpSender = Lib::Network::TcpSender;
+using TcpListener = Lib::Network::TcpListener;
+using TcpSocket = Lib::Network::TcpSocket;
+using Message = Lib::Network::Message;
+using SimpleMessage = Lib::Network::SimpleMessage;
+using DisconnectMessage = Lib::Network::DisconnectMessage;
+using ReceivedData = Lib::Network::ReceivedData;
+
+using namespace Test;
+
+// Waits until the listener has the expected number of clients
+bool waitForClients(const TcpListener &listener, std::size_t expected)
+{
+    for (int attempt = 0; attempt < 100 && listener.getNofClients() != expected; attempt++)
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    return listener.getNofClients() == expected;
+}
+
+bool sendText(TcpSender &sender, unsigned short port, unsigned short id)
+{
+    std::string content = "message " + std::to_string(id);
+    SimpleMessage msg(id, 0, content);
+    msg.setMessageProtocol(Message::MessageProto::TCP);
+    return sender.sendTo("127.0.0.1", port, msg);
+}
+
+void test_warm_connection()
+{
+    std::cout << "[TEST 1/4] Repeated sends share a connection: ";
+    TcpListener listener("127.0.0.1", 0, 32, 4);
+    TcpSender sender("127.0.0.1", 0);
+    unsigned short port = listener.getSocket().getPortNumber();
+    listener.start();
+
+    for (int idx = 0; idx < 20; idx++) assert_eq<bool>(sendText(sender, port, idx), true);
+
+    for (int idx = 0; idx < 20; idx++)
+    {
+        ReceivedData data = listener.getElement();
+        assert_eq<std::string>(SimpleMessage(*data.data).getMessage(), "message " + std::to_string(idx));
+    }
+
+    assert_eq<std::size_t>(sender.getNofConnections(), 1);
+    assert_eq<bool>(waitForClients(listener, 1), true);
+
+    sender.closeSocket();
+    assert_eq<std::size_t>(sender.getNofConnections(), 0);
+    assert_eq<bool>(sendText(sender, port, 0), false);
+
+    listener.stop();
+    listener.join();
+    std::cout << "Passed" << std::endl;
+}
+
+void test_eviction()
+{
+    std::cout << "[TEST 2/4] Least recently used connection is closed: ";
+    TcpListener listener_1("127.0.0.1", 0, 8, 2);
+    TcpListener listener_2("127.0.0.1", 0, 8, 2);
+    TcpListener listener_3("127.0.0.1", 0, 8, 2);
+    TcpSender sender("127.0.0.1", 0, 2);
+    unsigned short port_1 = listener_1.getSocket().getPortNumber();
+    unsigned short port_2 = listener_2.getSocket().getPortNumber();
+    unsigned short port_3 = listener_3.getSocket().getPortNumber();
+    listener_1.start();
+    listener_2.start();
+    listener_3.start();
+
+    assert_eq<bool>(sendText(sender, port_1, 1), true);
+    assert_eq<bool>(sendText(sender, port_2, 2), true);
+    assert_eq<bool>(sendText(sender, port_1, 3), true);
+    assert_eq<bool>(sendText(sender, port_3, 4), true);
+
+    // The second destination was the least recently used one
+    assert_eq<std::size_t>(sender.getNofConnections(), 2);
+    assert_eq<bool>(sender.isConnectedTo("127.0.0.1", port_1), true);
+    assert_eq<bool>(sender.isConnectedTo("127.0.0.1", port_2), false);
+    assert_eq<bool>(sender.isConnectedTo("127.0.0.1", port_3), true);
+    assert_eq<bool>(waitForClients(listener_2, 0), true);
+
+    // All messages have been delivered anyway
+    assert_eq<unsigned short>(SimpleMessage(*listener_1.getElement().data).getMessageId(), 1);
+    assert_eq<unsigned short>(SimpleMessage(*listener_2.getElement().data).getMessageId(), 2);
+    assert_eq<unsigned short>(SimpleMessage(*listener_1.getElement().data).getMessageId(), 3);
+    assert_eq<unsigned short>(SimpleMessage(*listener_3.getElement().data).getMessageId(), 4);
+
+    sender.closeSocket();
+    listener_1.stop();
+    listener_2.stop();
+    listener_3.stop();
+    listener_1.join();
+    listener_2.join();
+    listener_3.join();
+    std::cout << "Passed" << std::endl;
+}
+
+void test_reconnect()
+{
+    std::cout << "[TEST 3/4] Connections closed by the receiver are replaced: ";
+    TcpListener listener("127.0.0.1", 0, 8, 2);
+    TcpSender sender("127.0.0.1", 0);
+    unsigned short port = listener.getSocket().getPortNumber();
+    listener.start();
+
+    assert_eq<bool>(sendText(sender, port, 1), true);
+    assert_eq<bool>(waitForClients(listener, 1), true);
+
+    // The receiver closes the connection after a disconnect message
+    DisconnectMessage bye(0, 0);
+    bye.setMessageProtocol(Message::MessageProto::TCP);
+    assert_eq<bool>(sender.sendTo("127.0.0.1", port, bye), true);
+    assert_eq<bool>(waitForClients(listener, 0), true);
+
+    assert_eq<bool>(sendText(sender, port, 2), true);
+    assert_eq<bool>(waitForClients(listener, 1), true);
+    assert_eq<std::size_t>(sender.getNofConnections(), 1);
+
+    assert_eq<std::string>(SimpleMessage(*listener.getElement().data).getMessage(), "message 1");
+    assert_eq<std::string>(SimpleMessage(*listener.getElement().data).getMessage(), "message 2");
+
+    sender.closeSocket();
+    listener.stop();
+    listener.join();
+    std::cout << "Passed" << std::endl;
+}
+
+void test_slow_destination()
+{
+    std::cout << "[TEST 4/4] A slow destination does not hold the others: ";
+    TcpListener listener("127.0.0.1", 0, 8, 2);
+    TcpSocket refusing("127.0.0.1", 0); // Bound but not listening, each connect is refused
+    TcpSender sender("127.0.0.1", 0);
+    unsigned short port = listener.getSocket().getPortNumber();
+    listener.start();
+
+    // The connection to the refusing destination retries for a while
+    std::atomic<bool> done(false);
+    std::thread slow([&]() {
+        assert_eq<bool>(sendText(sender, refusing.getPortNumber(), 0), false);
+        done = true;
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    assert_eq<bool>(sendText(sender, port, 1), true);
+    assert_eq<std::string>(SimpleMessage(*listener.getElement().data).getMessage(), "message 1");
+    assert_eq<bool>(done, false);
+
+    slow.join();
+    assert_eq<std::size_t>(sender.getNofConnections(), 1);
+
+    sender.closeSocket();
+    listener.stop();
+    listener.join();
+    std::cout << "Passed" << std::endl;
+}
+
+int main()
+{
+    test_warm_connection();
+    test_eviction();
+    test_reconnect();
+    test_slow_destination();
+    return 0;
+}
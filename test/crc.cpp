@@ -0,0 +1,128 @@
+#include <iostream>
+#include <random>
+#include <CommonLib/Communication/Interface.hpp>
+#include <CommonLib/Communication/MessageView.hpp>
+#include "Test.hpp"
+
+using CRC32C = Lib::Network::CRC32C;
+using Message = Lib::Network::Message;
+using MessageHeaderView = Lib::Network::MessageHeaderView;
+using SimpleMessage = Lib::Network::SimpleMessage;
+using UdpCommunicationInterface = Lib::Network::UdpCommunicationInterface;
+using UdpSender = Lib::Network::UdpSender;
+using ReceivedData = Lib::Network::ReceivedData;
+
+using namespace Test;
+
+void test_known_values()
+{
+    std::cout << "[TEST 1/4] CRC32C Known Values: ";
+    const unsigned char *digits = (const unsigned char*)"123456789";
+    assert_eq<uint32_t>(CRC32C::compute(digits, 9), 0xE3069283);
+    assert_eq<uint32_t>(CRC32C::extendSoftware(0, digits, 9), 0xE3069283);
+
+    // The checksum can be computed in many steps
+    assert_eq<uint32_t>(CRC32C::extend(CRC32C::compute(digits, 4), digits + 4, 5), 0xE3069283);
+
+    unsigned char zeros[32] = {0};
+    assert_eq<uint32_t>(CRC32C::compute(zeros, sizeof(zeros)), 0x8A9136AA);
+    std::cout << "Passed" << std::endl;
+}
+
+void test_implementations()
+{
+    std::cout << "[TEST 2/4] Hardware and Software agree: ";
+    std::mt19937 gen(5);
+    std::vector<unsigned char> data(4096 + 16);
+    for (auto &byte : data) byte = gen() & 0xFF;
+
+    // Every alignment and every tail length
+    for (std::size_t offset = 0; offset < 16; offset++)
+        for (std::size_t size : {0, 1, 7, 8, 9, 63, 64, 65, 1000, 4096})
+            assert_eq<uint32_t>(CRC32C::compute(data.data() + offset, size),
+                                CRC32C::extendSoftware(0, data.data() + offset, size));
+
+    std::cout << "Passed" << std::endl;
+}
+
+void test_trailer()
+{
+    std::cout << "[TEST 3/4] Checksum Trailer: ";
+    std::string text = "some job input";
+    SimpleMessage msg(3, 4, text);
+    msg.setMessageProtocol(Message::MessageProto::TCP);
+    msg.encode();
+
+    std::size_t size = msg.getBufferSize();
+    std::vector<unsigned char> wire(msg.getData(), msg.getData() + size);
+    wire.resize(size + Message::CHECKSUM_SIZE);
+    assert_eq<std::size_t>(Message::appendChecksum(wire.data(), size), size + Message::CHECKSUM_SIZE);
+
+    MessageHeaderView header(wire.data(), wire.size());
+    assert_eq<bool>(header.hasChecksum(), true);
+    assert_eq<uint32_t>(header.getMessageLength(), wire.size());
+    assert_eq<bool>(header.getMessageProtocol() == Message::MessageProto::TCP, true);
+
+    // Every single flipped bit is detected
+    for (std::size_t bit = 0; bit < wire.size() * 8; bit++)
+    {
+        std::vector<unsigned char> corrupted(wire);
+        corrupted[bit / 8] ^= 1 << (bit % 8);
+        assert_eq<std::size_t>(Message::removeChecksum(corrupted.data(), corrupted.size()), 0);
+    }
+
+    // The verified message goes back to its original bytes
+    assert_eq<std::size_t>(Message::removeChecksum(wire.data(), wire.size()), size);
+    assert_eq<bool>(memcmp(wire.data(), msg.getData(), size) == 0, true);
+    std::cout << "Passed" << std::endl;
+}
+
+void test_interface()
+{
+    std::cout << "[TEST 4/4] Corrupted Messages are dropped: ";
+    UdpCommunicationInterface udp_int_1("127.0.0.1", 1440, 1441, 4);
+    UdpCommunicationInterface udp_int_2("127.0.0.1", 1442, 1443, 4);
+    udp_int_1.enableChecksum(true);
+    udp_int_1.enableCompression(64);
+    udp_int_2.start();
+
+    // A message with a checksum that does not match
+    std::string text = "corrupted";
+    SimpleMessage bad(1, 1, text);
+    bad.encode();
+    std::vector<unsigned char> wire(bad.getData(), bad.getData() + bad.getBufferSize());
+    wire.resize(wire.size() + Message::CHECKSUM_SIZE);
+    Message::appendChecksum(wire.data(), bad.getBufferSize());
+    wire[Message::NUM_HEAD_BYTES] ^= 0xFF;
+
+    UdpSender raw("127.0.0.1", 1444);
+    raw.sendTo("127.0.0.1", 1443, wire.data(), wire.size());
+
+    // Then a plain and a compressed message, both with the checksum
+    std::string small = "small", large(2000, 'z');
+    SimpleMessage m1(1, 2, small), m2(1, 3, large);
+    udp_int_1.sendTo("127.0.0.1", 1443, m1);
+    udp_int_1.sendTo("127.0.0.1", 1443, m2);
+
+    ReceivedData data1 = udp_int_2.getReceivedElement();
+    SimpleMessage recv1(*data1.data);
+    assert_eq<unsigned short>(recv1.getMessageCounter(), 2);
+    assert_eq<std::string>(recv1.getMessage(), small);
+
+    ReceivedData data2 = udp_int_2.getReceivedElement();
+    assert_eq<std::string>(SimpleMessage(*data2.data).getMessage(), large);
+
+    raw.closeSocket();
+    udp_int_1.close();
+    udp_int_2.close();
+    std::cout << "Passed" << std::endl;
+}
+
+int main()
+{
+    test_known_values();
+    test_implementations();
+    test_trailer();
+    test_interface();
+    return 0;
+}
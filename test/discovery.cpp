@@ -0,0 +1,66 @@
+#include <iostream>
+#include <CommonLib/Communication/Interface.hpp>
+#include "Test.hpp"
+
+using Message = Lib::Network::Message;
+using SimpleMessage = Lib::Network::SimpleMessage;
+using UdpCommunicationInterface = Lib::Network::UdpCommunicationInterface;
+using ReceivedData = Lib::Network::ReceivedData;
+
+using namespace Test;
+
+// Sends a single message to the group address and checks both the qubes get it
+void check_discovery(const std::string &addr, const unsigned short port, const std::string &group,
+                     const unsigned short first)
+{
+    UdpCommunicationInterface master("127.0.0.1", first, first + 1, 8);
+    UdpCommunicationInterface worker_1("127.0.0.1", first + 2, first + 3, 8);
+    UdpCommunicationInterface worker_2("127.0.0.1", first + 4, first + 5, 8);
+
+    assert_eq<bool>(master.enableDiscoverySender(), true);
+    assert_eq<bool>(worker_1.enableDiscoveryListener(port, group), true);
+    assert_eq<bool>(worker_2.enableDiscoveryListener(port, group), true);
+    assert_eq<bool>(worker_1.isUsingDiscoveryListener(), true);
+    assert_eq<bool>(master.isUsingDiscoveryListener(), false);
+    master.start();
+    worker_1.start();
+    worker_2.start();
+
+    std::string content = "hello";
+    SimpleMessage msg(1, 0, content);
+    msg.setMessageProtocol(Message::MessageProto::UDP);
+    master.sendTo(addr, port, msg);
+
+    // Each qube sharing the port gets its own copy, from the master sender
+    ReceivedData data_1 = worker_1.getReceivedElement();
+    ReceivedData data_2 = worker_2.getReceivedElement();
+    assert_eq<std::string>(SimpleMessage(*data_1.data).getMessage(), content);
+    assert_eq<std::string>(SimpleMessage(*data_2.data).getMessage(), content);
+    assert_eq<unsigned short>(ntohs(data_1.src.sin_port), first);
+    assert_eq<unsigned short>(ntohs(data_2.src.sin_port), first);
+
+    master.close();
+    worker_1.close();
+    worker_2.close();
+}
+
+void test_broadcast()
+{
+    std::cout << "[TEST 1/2] Discovery hellos through broadcast: ";
+    check_discovery("127.255.255.255", 1522, "", 1524);
+    std::cout << "Passed" << std::endl;
+}
+
+void test_multicast()
+{
+    std::cout << "[TEST 2/2] Discovery hellos through multicast: ";
+    check_discovery("239.255.32.120", 1523, "239.255.32.120", 1530);
+    std::cout << "Passed" << std::endl;
+}
+
+int main()
+{
+    test_broadcast();
+    test_multicast();
+    return 0;
+}
@@ -0,0 +1,161 @@
+#include <iostream>
+#include <thread>
+#include <chrono>
+#include <CommonLib/Concurrency/EventLoop.hpp>
+#include <CommonLib/Concurrency/Queue.hpp>
+#include <CommonLib/Communication/Interface.hpp>
+#include "Test.hpp"
+
+namespace conc = Lib::Concurrency;
+namespace net = Lib::Network;
+
+using namespace Test;
+
+long int elapsed_ms(const std::chrono::steady_clock::time_point &start)
+{
+    auto duration = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration_cast<std::chrono::milliseconds>(duration).count();
+}
+
+void test_notify()
+{
+    std::cout << "[TEST 1/4] Notification from another thread: ";
+    conc::EventLoop loop;
+
+    // Nothing happens, the wait returns on its own timeout
+    assert_eq<bool>(loop.wait(20), true);
+    assert_eq<bool>(loop.isNotified(), false);
+
+    auto start = std::chrono::steady_clock::now();
+    std::thread notifier([&loop]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        loop.notify();
+        loop.notify();
+    });
+
+    assert_eq<bool>(loop.wait(), true);
+    notifier.join();
+    assert_eq<bool>(loop.isNotified(), true);
+    assert_eq<bool>(elapsed_ms(start) < 1000, true);
+
+    // Both notifications are consumed by the same wait, unless the
+    // second one arrived after it
+    loop.wait(0);
+    loop.wait(0);
+    assert_eq<bool>(loop.isNotified(), false);
+
+    // A notification before the wait is not lost
+    loop.notify();
+    assert_eq<bool>(loop.wait(0), true);
+    assert_eq<bool>(loop.isNotified(), true);
+    std::cout << "Passed" << std::endl;
+}
+
+void test_timers()
+{
+    std::cout << "[TEST 2/4] One shot and periodic timers: ";
+    conc::EventLoop loop;
+    int oneshot = loop.addTimer();
+    int periodic = loop.addTimer();
+    assert_eq<bool>(oneshot != periodic, true);
+
+    auto start = std::chrono::steady_clock::now();
+    assert_eq<bool>(loop.setTimer(oneshot, 30), true);
+    while (!loop.isExpired(oneshot)) loop.wait();
+    assert_eq<bool>(elapsed_ms(start) >= 29, true);
+    assert_eq<bool>(loop.isExpired(periodic), false);
+
+    // The one shot timer does not expire again
+    assert_eq<bool>(loop.wait(60), true);
+    assert_eq<bool>(loop.isExpired(oneshot), false);
+
+    int nofExpired = 0;
+    loop.setTimer(periodic, 10, 10);
+    while (nofExpired < 3)
+    {
+        loop.wait();
+        if (loop.isExpired(periodic)) nofExpired++;
+    }
+
+    assert_eq<bool>(loop.setTimer(periodic, 0), true);
+    assert_eq<bool>(loop.wait(40), true);
+    assert_eq<bool>(loop.isExpired(periodic), false);
+    assert_eq<bool>(loop.setTimer(5, 10), false);
+    std::cout << "Passed" << std::endl;
+}
+
+void test_timer_and_notify()
+{
+    std::cout << "[TEST 3/4] Notifications do not disturb the timers: ";
+    conc::EventLoop loop;
+    int timer = loop.addTimer();
+    loop.setTimer(timer, 50);
+
+    std::thread notifier([&loop]() {
+        for (int idx = 0; idx < 5; idx++)
+        {
+            loop.notify();
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+    });
+
+    int nofNotified = 0;
+    while (!loop.isExpired(timer))
+    {
+        loop.wait();
+        if (loop.isNotified()) nofNotified++;
+    }
+
+    notifier.join();
+    assert_eq<bool>(nofNotified > 0, true);
+    std::cout << "Passed" << std::endl;
+}
+
+void test_queues()
+{
+    std::cout << "[TEST 4/4] Queues and interfaces notify the loop: ";
+    conc::EventLoop_ptr loop = std::make_shared<conc::EventLoop>();
+
+    conc::Queue<int> queue(4);
+    queue.setEventLoop(loop);
+    queue.push(7);
+    assert_eq<bool>(loop->wait(1000), true);
+    assert_eq<bool>(loop->isNotified(), true);
+
+    int value = 0;
+    assert_eq<bool>(queue.tryPop(value), true);
+    assert_eq<int>(value, 7);
+    assert_eq<bool>(queue.tryPop(value), false);
+
+    // Four shards, the datagram can land on any of them
+    net::UdpCommunicationInterface sender("127.0.0.1", 1540, 1541, 4);
+    net::UdpCommunicationInterface receiver("127.0.0.1", 1542, 1543, 4, UDP_BATCH_SIZE, false, 4);
+    receiver.setEventLoop(loop);
+    sender.start();
+    receiver.start();
+
+    net::ReceivedData data;
+    assert_eq<bool>(receiver.tryGetReceivedElement(data), false);
+
+    std::string content = "wake up";
+    net::SimpleMessage msg(1, 1, content);
+    sender.sendTo("127.0.0.1", 1543, msg);
+
+    auto start = std::chrono::steady_clock::now();
+    while (!receiver.tryGetReceivedElement(data) && elapsed_ms(start) < 1000)
+        loop->wait(1000);
+
+    assert_eq<std::string>(net::SimpleMessage(*data.data).getMessage(), content);
+    sender.close();
+    receiver.close();
+    std::cout << "Passed" << std::endl;
+}
+
+int main()
+{
+    test_notify();
+    test_timers();
+    test_timer_and_notify();
+    test_queues();
+    return 0;
+}
@@ -0,0 +1,103 @@
+#include <iostream>
+#include <CommonLib/Communication/Interface.hpp>
+#include "Test.hpp"
+
+using Socket = Lib::Network::Socket;
+using Message = Lib::Network::Message;
+using SimpleMessage = Lib::Network::SimpleMessage;
+using UdpSender = Lib::Network::UdpSender;
+using LocalListener = Lib::Network::LocalListener;
+using UdpCommunicationInterface = Lib::Network::UdpCommunicationInterface;
+using ReceivedData = Lib::Network::ReceivedData;
+
+using namespace Test;
+
+void test_local_address()
+{
+    std::cout << "[TEST 1/3] Local names of the IPv4 addresses: ";
+    struct sockaddr_in addr, back;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(33333);
+    inet_pton(AF_INET, "10.0.0.42", &addr.sin_addr);
+
+    struct sockaddr_un local;
+    socklen_t len = Socket::toLocalAddress(addr, local);
+    assert_eq<bool>(Socket::fromLocalAddress(local, len, back), true);
+    assert_eq<unsigned int>(back.sin_addr.s_addr, addr.sin_addr.s_addr);
+    assert_eq<unsigned short>(back.sin_port, addr.sin_port);
+
+    // Names of other applications are not translated
+    local.sun_path[1] = 'x';
+    assert_eq<bool>(Socket::fromLocalAddress(local, len, back), false);
+
+    inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+    assert_eq<bool>(Socket::isLocalAddress(addr.sin_addr), true);
+    inet_pton(AF_INET, "192.0.2.1", &addr.sin_addr);
+    assert_eq<bool>(Socket::isLocalAddress(addr.sin_addr), false);
+    std::cout << "Passed" << std::endl;
+}
+
+void test_local_sender()
+{
+    std::cout << "[TEST 2/3] Datagrams to local peers through AF_UNIX: ";
+    LocalListener listener("127.0.0.1", 1506, std::make_shared<Lib::Concurrency::Queue<ReceivedData>>(8));
+    UdpSender sender("127.0.0.1", 1507);
+    sender.setLocalTransport(true);
+    assert_eq<bool>(sender.isLocalTransportEnabled(), true);
+    listener.start();
+
+    std::string content = "hello";
+    SimpleMessage msg(1, 0, content);
+    msg.setMessageProtocol(Message::MessageProto::UDP);
+    assert_eq<bool>(sender.sendTo("127.0.0.1", 1506, msg), true);
+
+    // The source is the address the sending socket stands for
+    ReceivedData data = listener.getElement();
+    assert_eq<std::string>(SimpleMessage(*data.data).getMessage(), content);
+    assert_eq<unsigned short>(ntohs(data.src.sin_port), 1507);
+    assert_eq<std::string>(Socket::addressNumberToString(data.src.sin_addr.s_addr, true), "127.0.0.1");
+
+    listener.stop();
+    listener.join();
+    sender.closeSocket();
+    std::cout << "Passed" << std::endl;
+}
+
+void test_interfaces()
+{
+    std::cout << "[TEST 3/3] Interfaces with and without the local transport: ";
+    UdpCommunicationInterface udp_int_1("127.0.0.1", 1508, 1509, 8);
+    UdpCommunicationInterface udp_int_2("127.0.0.1", 1510, 1511, 8);
+    assert_eq<bool>(udp_int_1.enableLocalTransport(), true);
+    assert_eq<bool>(udp_int_1.isUsingLocalTransport(), true);
+    assert_eq<bool>(udp_int_2.isUsingLocalTransport(), false);
+    udp_int_1.enableChecksum(true);
+    udp_int_1.start();
+    udp_int_2.start();
+
+    // The second interface has no local socket, the first falls back to IP
+    std::string first = "first", second = "second";
+    SimpleMessage msg_1(1, 0, first), msg_2(2, 0, second);
+    udp_int_1.sendTo("127.0.0.1", 1511, msg_1);
+    udp_int_2.sendTo("127.0.0.1", 1509, msg_2);
+
+    ReceivedData data_1 = udp_int_2.getReceivedElement();
+    assert_eq<std::string>(SimpleMessage(*data_1.data).getMessage(), first);
+    assert_eq<unsigned short>(ntohs(data_1.src.sin_port), 1508);
+    ReceivedData data_2 = udp_int_1.getReceivedElement();
+    assert_eq<std::string>(SimpleMessage(*data_2.data).getMessage(), second);
+    assert_eq<unsigned short>(ntohs(data_2.src.sin_port), 1510);
+
+    udp_int_1.close();
+    udp_int_2.close();
+    std::cout << "Passed" << std::endl;
+}
+
+int main()
+{
+    test_local_address();
+    test_local_sender();
+    test_interfaces();
+    return 0;
+}
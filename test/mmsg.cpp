@@ -0,0 +1,147 @@
+#include <iostream>
+#include <thread>
+#include <chrono>
+#include <arpa/inet.h>
+#include <CommonLib/Communication/Interface.hpp>
+#include "Test.hpp"
+
+using Message = Lib::Network::Message;
+using SimpleMessage = Lib::Network::SimpleMessage;
+using Datagram = Lib::Network::Datagram;
+using UdpSender = Lib::Network::UdpSender;
+using UdpListener = Lib::Network::UdpListener;
+using UdpCommunicationInterface = Lib::Network::UdpCommunicationInterface;
+using ReceivedData = Lib::Network::ReceivedData;
+
+using namespace Test;
+
+struct sockaddr_in makeAddress(const std::string &ip, unsigned short port)
+{
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    inet_pton(AF_INET, ip.c_str(), &addr.sin_addr);
+    return addr;
+}
+
+void test_batch_size()
+{
+    std::cout << "[TEST 1/4] Batch size is bounded: ";
+    UdpSender sender("127.0.0.1", 1460);
+    assert_eq<std::size_t>(sender.getBatchSize(), UDP_BATCH_SIZE);
+    sender.setBatchSize(0);
+    assert_eq<std::size_t>(sender.getBatchSize(), 1);
+    sender.setBatchSize(5000);
+    assert_eq<std::size_t>(sender.getBatchSize(), UDP_MAX_BATCH_SIZE);
+    sender.closeSocket();
+    std::cout << "Passed" << std::endl;
+}
+
+void test_burst()
+{
+    std::cout << "[TEST 2/4] Burst of datagrams in few syscalls: ";
+    const std::size_t nofMsgs = 200;
+    UdpListener listener("127.0.0.1", 1461, nofMsgs, 16);
+    UdpSender sender("127.0.0.1", 1462);
+    sender.setBatchSize(16);
+    listener.start();
+
+    // More datagrams than a batch, both sides need several syscalls
+    std::vector<SimpleMessage> msgs;
+    std::vector<Datagram> datagrams(nofMsgs);
+    msgs.reserve(nofMsgs);
+
+    for (std::size_t idx = 0; idx < nofMsgs; idx++)
+    {
+        std::string content = "message " + std::to_string(idx);
+        msgs.emplace_back(idx, 0, content);
+        msgs.back().setMessageProtocol(Message::MessageProto::UDP);
+        msgs.back().encode();
+        datagrams[idx] = {makeAddress("127.0.0.1", 1461), msgs.back().getData(), msgs.back().getBufferSize()};
+    }
+
+    assert_eq<std::size_t>(sender.sendBatch(datagrams.data(), nofMsgs), nofMsgs);
+
+    // Loopback keeps the order of the datagrams
+    for (std::size_t idx = 0; idx < nofMsgs; idx++)
+    {
+        ReceivedData data = listener.getElement();
+        SimpleMessage msg(*data.data);
+        assert_eq<unsigned short>(msg.getMessageId(), idx);
+        assert_eq<std::string>(msg.getMessage(), "message " + std::to_string(idx));
+    }
+
+    listener.stop();
+    listener.join();
+    sender.closeSocket();
+    std::cout << "Passed" << std::endl;
+}
+
+void test_interface()
+{
+    std::cout << "[TEST 3/4] Batched datagrams between two interfaces: ";
+    UdpCommunicationInterface udp_int_1("127.0.0.1", 1463, 1464, 8, 4);
+    UdpCommunicationInterface udp_int_2("127.0.0.1", 1465, 1466, 8, 4);
+    udp_int_1.start();
+    udp_int_2.start();
+
+    for (int idx = 0; idx < 6; idx++)
+    {
+        std::string content = "hello";
+        SimpleMessage msg(idx, 0, content);
+        udp_int_1.sendTo("127.0.0.1", 1466, msg);
+    }
+
+    for (int idx = 0; idx < 6; idx++)
+    {
+        ReceivedData data = udp_int_2.getReceivedElement();
+        assert_eq<unsigned short>(SimpleMessage(*data.data).getMessageId(), idx);
+    }
+
+    udp_int_1.close();
+    udp_int_2.close();
+    std::cout << "Passed" << std::endl;
+}
+
+void test_sources()
+{
+    std::cout << "[TEST 4/4] Queued datagrams keep their own source: ";
+    const std::size_t nofMsgs = 20;
+    UdpListener listener("127.0.0.1", 0, nofMsgs, 4);
+    UdpSender sender_1("127.0.0.1", 0), sender_2("127.0.0.1", 0);
+    unsigned short port = listener.getSocket().getPortNumber();
+    listener.start();
+
+    for (std::size_t idx = 0; idx < nofMsgs; idx++)
+    {
+        std::string content = "source";
+        SimpleMessage msg(idx, 0, content);
+        msg.setMessageProtocol(Message::MessageProto::UDP);
+        assert_eq<bool>(((idx % 2) ? sender_2 : sender_1).sendTo("127.0.0.1", port, msg), true);
+    }
+
+    // All of them are received in several batches before the first is taken
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    for (std::size_t idx = 0; idx < nofMsgs; idx++)
+    {
+        ReceivedData data = listener.getElement();
+        UdpSender &sender = (SimpleMessage(*data.data).getMessageId() % 2) ? sender_2 : sender_1;
+        assert_eq<unsigned short>(ntohs(data.src.sin_port), sender.getSocket().getPortNumber());
+    }
+
+    listener.stop();
+    listener.join();
+    sender_1.closeSocket();
+    sender_2.closeSocket();
+    std::cout << "Passed" << std::endl;
+}
+
+int main()
+{
+    test_batch_size();
+    test_burst();
+    test_interface();
+    test_sources();
+    return 0;
+}
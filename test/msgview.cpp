@@ -0,0 +1,81 @@
+#include <iostream>
+#include <CommonLib/Communication/MessageView.hpp>
+#include "Test.hpp"
+
+using ByteBuffer = Lib::Network::ByteBuffer;
+using Message = Lib::Network::Message;
+using DiscoverResponseMessage = Lib::Network::DiscoverResponseMessage;
+using MessageHeaderView = Lib::Network::MessageHeaderView;
+using DiscoverResponseView = Lib::Network::DiscoverResponseView;
+
+namespace Schema = Lib::Network::Schema;
+
+using namespace Test;
+
+DiscoverResponseMessage make_response(Message::MessageProto proto)
+{
+    DiscoverResponseMessage msg(12, 4);
+    msg.setMessageProtocol(proto);
+    msg.setUdpPort(1234);
+    msg.setTcpPort(4321);
+    msg.setIpAddress(0x0a000002);
+    msg.setAvailableMemory_mb(512);
+    msg.setAvailableMemory_kb(256);
+    msg.setCpuUsage(7);
+    msg.encode();
+    return msg;
+}
+
+void test_header_view()
+{
+    std::cout << "[TEST 1/3] Reading the Header in place: ";
+    for (auto proto : {Message::MessageProto::TCP, Message::MessageProto::UDP})
+    {
+        DiscoverResponseMessage msg = make_response(proto);
+        MessageHeaderView header(msg);
+
+        assert_eq<bool>(header.isValid(), true);
+        assert_eq<unsigned short>(header.getMessageCounter(), 4);
+        assert_eq<unsigned short>(header.getMessageId(), 12);
+        assert_eq<int>((int)header.getMessageType(), (int)Message::MessageType::DISCOVER);
+        assert_eq<int>((int)header.getMessageSubType(), (int)Message::MessageSubType::DISCOVER_RESPONSE);
+        assert_eq<int>((int)header.getMessageProtocol(), (int)proto);
+    }
+
+    std::cout << "Passed" << std::endl;
+}
+
+void test_message_view()
+{
+    std::cout << "[TEST 2/3] Reading the Body in place: ";
+    DiscoverResponseMessage msg = make_response(Message::MessageProto::UDP);
+    DiscoverResponseView view(msg);
+
+    assert_eq<bool>(view.isValid(), true);
+    assert_eq<uint16_t>(view.get<Schema::UdpPort>(), 1234);
+    assert_eq<uint16_t>(view.get<Schema::TcpPort>(), 4321);
+    assert_eq<uint32_t>(view.get<Schema::IpAddress>(), 0x0a000002);
+    assert_eq<uint32_t>(view.get<Schema::FreeRamMb>(), 512);
+    assert_eq<uint32_t>(view.get<Schema::FreeRamKb>(), 256);
+    assert_eq<uint8_t>(view.get<Schema::CpuUsage>(), 7);
+    std::cout << "Passed" << std::endl;
+}
+
+void test_truncated()
+{
+    std::cout << "[TEST 3/3] Truncated messages are not valid: ";
+    DiscoverResponseMessage msg = make_response(Message::MessageProto::UDP);
+
+    assert_eq<bool>(MessageHeaderView(msg.getData(), Message::NUM_HEAD_BYTES - 1).isValid(), false);
+    assert_eq<bool>(MessageHeaderView(msg.getData(), Message::NUM_HEAD_BYTES).isValid(), true);
+    assert_eq<bool>(DiscoverResponseView(msg.getData(), DiscoverResponseMessage::WIRE_SIZE - 1).isValid(), false);
+    std::cout << "Passed" << std::endl;
+}
+
+int main()
+{
+    test_header_view();
+    test_message_view();
+    test_truncated();
+    return 0;
+}
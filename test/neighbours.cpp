@@ -0,0 +1,68 @@
+#include <iostream>
+#include <fstream>
+#include <CommonLib/Communication/NeighbourCache.hpp>
+#include "Test.hpp"
+
+using NeighbourCache = Lib::Network::NeighbourCache;
+
+using namespace Test;
+
+const std::string TABLE_PATH = "/tmp/disqube-neighbours-test";
+
+void write_table(const std::string &entries)
+{
+    std::ofstream table(TABLE_PATH, std::ios::trunc);
+    table << "IP address       HW type     Flags       HW address            Mask     Device" << std::endl;
+    table << entries;
+}
+
+void test_read_table()
+{
+    std::cout << "[TEST 1/2] Complete entries of the neighbour table: ";
+    write_table(
+        "10.0.0.1         0x1         0x2         02:00:00:00:00:01     *        eth0\n"
+        "10.0.0.2         0x1         0x0         00:00:00:00:00:00     *        eth0\n"
+        "10.0.1.3         0x1         0x6         02:00:00:00:00:03     *        eth1\n");
+
+    std::vector<unsigned int> all = NeighbourCache::readTable(TABLE_PATH, "");
+    assert_eq<std::size_t>(all.size(), 2);
+    assert_eq<unsigned int>(all[0], 0x0A000001);
+    assert_eq<unsigned int>(all[1], 0x0A000103);
+
+    std::vector<unsigned int> eth0 = NeighbourCache::readTable(TABLE_PATH, "eth0");
+    assert_eq<std::size_t>(eth0.size(), 1);
+    assert_eq<unsigned int>(eth0[0], 0x0A000001);
+
+    assert_eq<std::size_t>(NeighbourCache::readTable("/nonexistent/arp", "").size(), 0);
+    std::cout << "Passed" << std::endl;
+}
+
+void test_refresh()
+{
+    std::cout << "[TEST 2/2] Refresh of the neighbour cache: ";
+    write_table("10.0.0.1         0x1         0x2         02:00:00:00:00:01     *        eth0\n");
+
+    NeighbourCache cache("eth0", TABLE_PATH);
+    assert_eq<std::size_t>(cache.getNeighbours().size(), 0);
+    cache.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    assert_eq<std::size_t>(cache.getNeighbours().size(), 1);
+
+    write_table(
+        "10.0.0.1         0x1         0x2         02:00:00:00:00:01     *        eth0\n"
+        "10.0.0.4         0x1         0x2         02:00:00:00:00:04     *        eth0\n");
+    cache.refresh();
+    assert_eq<std::size_t>(cache.getNeighbours().size(), 2);
+
+    cache.stop();
+    assert_eq<bool>(cache.isRunning(), false);
+    std::remove(TABLE_PATH.c_str());
+    std::cout << "Passed" << std::endl;
+}
+
+int main()
+{
+    test_read_table();
+    test_refresh();
+    return 0;
+}
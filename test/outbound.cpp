@@ -0,0 +1,147 @@
+#include <iostream>
+#include <thread>
+#include <chrono>
+#include <unistd.h>
+#include <CommonLib/Communication/Interface.hpp>
+#include <CommonLib/Communication/OutboundQueue.hpp>
+#include "Test.hpp"
+
+using OutboundQueue = Lib::Network::OutboundQueue;
+using OutboundStats = Lib::Network::OutboundStats;
+using SimpleMessage = Lib::Network::SimpleMessage;
+using UdpSender = Lib::Network::UdpSender;
+using UdpListener = Lib::Network::UdpListener;
+using ReceivedData = Lib::Network::ReceivedData;
+
+using namespace Test;
+
+void test_direct_send()
+{
+    std::cout << "[TEST 1/4] Datagrams leave without waiting: ";
+    UdpListener listener("127.0.0.1", 1467, 64);
+    UdpSender sender("127.0.0.1", 1468);
+    listener.start();
+
+    for (int idx = 0; idx < 50; idx++)
+    {
+        std::string content = "direct";
+        SimpleMessage msg(idx, 0, content);
+        assert_eq<bool>(sender.sendTo("127.0.0.1", 1467, msg), true);
+    }
+
+    for (int idx = 0; idx < 50; idx++)
+    {
+        ReceivedData data = listener.getElement();
+        assert_eq<unsigned short>(SimpleMessage(*data.data).getMessageId(), idx);
+    }
+
+    // The socket never filled up, nothing has been queued
+    OutboundStats stats = sender.getOutboundStats();
+    assert_eq<std::size_t>(stats.sent, 50);
+    assert_eq<std::size_t>(stats.queued, 0);
+    assert_eq<std::size_t>(stats.dropped, 0);
+    assert_eq<std::size_t>(stats.pending, 0);
+    assert_eq<bool>(sender.flush(0), true);
+
+    listener.stop();
+    listener.join();
+    sender.closeSocket();
+    std::cout << "Passed" << std::endl;
+}
+
+void test_send_error()
+{
+    std::cout << "[TEST 2/4] Failed datagrams are dropped: ";
+    OutboundQueue queue(4);
+    assert_eq<std::size_t>(queue.getCapacity(), 4);
+
+    struct sockaddr_in dst;
+    memset(&dst, 0, sizeof(dst));
+    dst.sin_family = AF_INET;
+    dst.sin_port = htons(1469);
+    inet_pton(AF_INET, "127.0.0.1", &dst.sin_addr);
+
+    // An invalid descriptor is not a full socket, the datagram is not queued
+    unsigned char content[] = "lost";
+    assert_eq<bool>(queue.send(-1, content, sizeof(content), &dst), false);
+    assert_eq<bool>(queue.isEmpty(), true);
+
+    OutboundStats stats = queue.getStats();
+    assert_eq<std::size_t>(stats.dropped, 1);
+    assert_eq<std::size_t>(stats.sent, 0);
+    assert_eq<bool>(queue.drain(-1), true);
+    std::cout << "Passed" << std::endl;
+}
+
+void test_closed_socket()
+{
+    std::cout << "[TEST 3/4] Closed sockets do not send: ";
+    UdpSender sender("127.0.0.1", 1469);
+    sender.closeSocket();
+
+    std::string content = "closed";
+    SimpleMessage msg(1, 0, content);
+    assert_eq<bool>(sender.sendTo("127.0.0.1", 1467, msg), false);
+    assert_eq<std::size_t>(sender.getOutboundStats().sent, 0);
+    std::cout << "Passed" << std::endl;
+}
+
+void test_background_drain()
+{
+    std::cout << "[TEST 4/4] Queued datagrams leave once the socket is writable: ";
+    OutboundQueue queue(4096);
+
+    // A loopback connection whose peer does not read stands for a full socket,
+    // the destination address is ignored by TCP
+    int server = socket(AF_INET, SOCK_STREAM, 0), client = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in addr;
+    socklen_t addrlen = sizeof(addr);
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+    assert_eq<int>(bind(server, (struct sockaddr*)&addr, sizeof(addr)), 0);
+    assert_eq<int>(listen(server, 1), 0);
+    getsockname(server, (struct sockaddr*)&addr, &addrlen);
+    assert_eq<int>(connect(client, (struct sockaddr*)&addr, sizeof(addr)), 0);
+    int peer = accept(server, nullptr, nullptr);
+
+    unsigned char content[100] = {0};
+    std::size_t nofSent = 0;
+    while (queue.getStats().queued < 16 && nofSent < 1000000)
+    {
+        assert_eq<bool>(queue.send(client, content, sizeof(content), &addr), true);
+        nofSent++;
+    }
+
+    assert_eq<std::size_t>(queue.getStats().queued, 16);
+
+    // Once the peer reads, the queue drains with no other send nor flush
+    std::thread reader([peer]() {
+        char buff[4096];
+        while (recv(peer, buff, sizeof(buff), 0) > 0);
+    });
+
+    for (int attempt = 0; attempt < 200 && !queue.isEmpty(); attempt++)
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    OutboundStats stats = queue.getStats();
+    assert_eq<std::size_t>(stats.pending, 0);
+    assert_eq<std::size_t>(stats.dropped, 0);
+    assert_eq<std::size_t>(stats.sent, nofSent);
+
+    queue.close();
+    close(client);
+    reader.join();
+    close(peer);
+    close(server);
+    std::cout << "Passed" << std::endl;
+}
+
+int main()
+{
+    test_direct_send();
+    test_send_error();
+    test_closed_socket();
+    test_background_drain();
+    return 0;
+}
@@ -0,0 +1,112 @@
+#include <iostream>
+#include <vector>
+#include <CommonLib/Communication/ByteBufferPool.hpp>
+#include <CommonLib/Concurrency/Thread.hpp>
+#include "Test.hpp"
+
+using ByteBuffer = Lib::Network::ByteBuffer;
+using ByteBufferPool = Lib::Network::ByteBufferPool;
+using ByteBufferPool_ptr = Lib::Network::ByteBufferPool_ptr;
+using ByteBuffer_ptr = Lib::Network::ByteBuffer_ptr;
+using PoolStats = Lib::Network::PoolStats;
+using Thread = Lib::Concurrency::Thread;
+
+using namespace Test;
+
+void test_recycle()
+{
+    std::cout << "[TEST 1/4] Buffers are recycled: ";
+    ByteBufferPool_ptr pool = std::make_shared<ByteBufferPool>(4, 64);
+
+    ByteBuffer* first;
+    {
+        ByteBuffer_ptr buffer = pool->acquire();
+        buffer->put((unsigned int)0xdeadbeef);
+        first = buffer.get();
+        assert_eq<std::size_t>(pool->getStats().inUse, 1);
+    }
+
+    // The released buffer is given back empty and to the same thread
+    ByteBuffer_ptr buffer = pool->acquire();
+    assert_eq<ByteBuffer*>(buffer.get(), first);
+    assert_eq<std::size_t>(buffer->getBufferSize(), 0);
+    assert_eq<std::size_t>(buffer->getBufferCapacity(), 64);
+
+    PoolStats stats = pool->getStats();
+    assert_eq<std::size_t>(stats.hits, 2);
+    assert_eq<std::size_t>(stats.misses, 0);
+    std::cout << "Passed" << std::endl;
+}
+
+void test_exhaustion()
+{
+    std::cout << "[TEST 2/4] Misses and High-Water mark: ";
+    ByteBufferPool_ptr pool = std::make_shared<ByteBufferPool>(4, 64);
+
+    {
+        std::vector<ByteBuffer_ptr> buffers;
+        for (int idx = 0; idx < 6; idx++) buffers.push_back(pool->acquire());
+
+        // Oversized requests are always served from the heap
+        ByteBuffer_ptr large = pool->acquire(128);
+        assert_eq<std::size_t>(large->getBufferCapacity(), 128);
+    }
+
+    PoolStats stats = pool->getStats();
+    assert_eq<std::size_t>(stats.hits, 4);
+    assert_eq<std::size_t>(stats.misses, 3);
+    assert_eq<std::size_t>(stats.highWater, 4);
+    assert_eq<std::size_t>(stats.inUse, 0);
+    std::cout << "Passed" << std::endl;
+}
+
+void test_cross_thread()
+{
+    std::cout << "[TEST 3/4] Producer/Consumer on different threads: ";
+    ByteBufferPool_ptr pool = std::make_shared<ByteBufferPool>(32, 64);
+    std::vector<ByteBuffer_ptr> produced;
+
+    // Buffers acquired on one thread and released on another
+    for (int round = 0; round < 100; round++)
+    {
+        std::thread prod = Thread::start([&pool, &produced]()
+        {
+            for (int idx = 0; idx < 8; idx++) produced.push_back(pool->acquire());
+        }, false);
+        prod.join();
+
+        produced.clear();
+    }
+
+    PoolStats stats = pool->getStats();
+    assert_eq<std::size_t>(stats.misses, 0);
+    assert_eq<std::size_t>(stats.inUse, 0);
+    std::cout << "Passed" << std::endl;
+}
+
+void test_lifetime()
+{
+    std::cout << "[TEST 4/4] Buffers outlive the pool handle: ";
+    ByteBuffer_ptr buffer;
+
+    {
+        ByteBufferPool_ptr pool = std::make_shared<ByteBufferPool>(2, 64);
+        buffer = pool->acquire();
+    }
+
+    // The buffer keeps the pool alive, so it can still be used
+    buffer->put((unsigned short)0x1234);
+    buffer->position(0);
+    assert_eq<unsigned short>(buffer->getShort(), 0x1234);
+    buffer.reset();
+    std::cout << "Passed" << std::endl;
+}
+
+int main()
+{
+    test_recycle();
+    test_exhaustion();
+    test_cross_thread();
+    test_lifetime();
+    return 0;
+}
@@ -0,0 +1,126 @@
+#include <iostream>
+#include <thread>
+#include <chrono>
+#include <vector>
+#include <arpa/inet.h>
+#include <CommonLib/Communication/Listener.hpp>
+#include "Test.hpp"
+
+using TcpListener = Lib::Network::TcpListener;
+using SimpleMessage = Lib::Network::SimpleMessage;
+using ReceivedData = Lib::Network::ReceivedData;
+
+using namespace Test;
+
+// Connects a plain socket to the given local port, waiting for the listener
+int connectTo(unsigned short port)
+{
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+
+    for (int attempt = 0; attempt < 50; attempt++)
+    {
+        int fd = socket(AF_INET, SOCK_STREAM, 0);
+        if (connect(fd, (struct sockaddr*)&addr, sizeof(addr)) == 0) return fd;
+
+        close(fd);
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+
+    return -1;
+}
+
+// Waits until the listener has the expected number of clients
+bool waitForClients(const TcpListener &listener, std::size_t expected)
+{
+    for (int attempt = 0; attempt < 100 && listener.getNofClients() != expected; attempt++)
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    return listener.getNofClients() == expected;
+}
+
+void test_many_clients()
+{
+    std::cout << "[TEST 1/2] Many clients on a single thread: ";
+    const int NOF_CLIENTS = 200;
+    TcpListener listener("127.0.0.1", 0, NOF_CLIENTS, NOF_CLIENTS);
+    unsigned short port = listener.getSocket().getPortNumber(); // Chosen by the OS
+    listener.start();
+
+    std::vector<int> clients;
+    for (int idx = 0; idx < NOF_CLIENTS; idx++)
+    {
+        clients.push_back(connectTo(port));
+        assert_neq<int>(clients.back(), -1);
+    }
+
+    assert_eq<bool>(waitForClients(listener, NOF_CLIENTS), true);
+
+    // Each client sends one message, in reverse order
+    std::vector<bool> received(NOF_CLIENTS, false);
+    for (int idx = NOF_CLIENTS - 1; idx >= 0; idx--)
+    {
+        std::string text = "client " + std::to_string(idx);
+        SimpleMessage msg(idx, 0, text);
+        msg.encode();
+        send(clients[idx], msg.getData(), msg.getBufferSize(), MSG_NOSIGNAL);
+    }
+
+    for (int idx = 0; idx < NOF_CLIENTS; idx++)
+    {
+        ReceivedData data = listener.getElement();
+        SimpleMessage recv(*data.data);
+        assert_eq<std::string>(recv.getMessage(), "client " + std::to_string(recv.getMessageId()));
+        received[recv.getMessageId()] = true;
+    }
+
+    assert_eq<long>(std::count(received.begin(), received.end(), true), NOF_CLIENTS);
+
+    // Closed connections are removed from the reactor
+    for (int fd : clients) close(fd);
+    assert_eq<bool>(waitForClients(listener, 0), true);
+
+    listener.stop();
+    listener.join();
+    std::cout << "Passed" << std::endl;
+}
+
+void test_limit()
+{
+    std::cout << "[TEST 2/2] Connections over the limit are refused: ";
+    TcpListener listener("127.0.0.1", 0, 4, 2);
+    unsigned short port = listener.getSocket().getPortNumber(); // Chosen by the OS
+    listener.start();
+
+    int first = connectTo(port), second = connectTo(port);
+    assert_eq<bool>(waitForClients(listener, 2), true);
+
+    // The third client is accepted by the kernel, then closed by the listener
+    int third = connectTo(port);
+    char byte;
+    assert_eq<long>(recv(third, &byte, 1, 0), 0);
+    assert_eq<std::size_t>(listener.getNofClients(), 2);
+
+    // Once a client leaves, there is room for another one
+    close(first);
+    assert_eq<bool>(waitForClients(listener, 1), true);
+    int fourth = connectTo(port);
+    assert_eq<bool>(waitForClients(listener, 2), true);
+
+    close(second);
+    close(third);
+    close(fourth);
+    listener.stop();
+    listener.join();
+    std::cout << "Passed" << std::endl;
+}
+
+int main()
+{
+    test_many_clients();
+    test_limit();
+    return 0;
+}
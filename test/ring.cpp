@@ -0,0 +1,152 @@
+#include <iostream>
+#include <thread>
+#include <chrono>
+#include <arpa/inet.h>
+#include <CommonLib/Communication/Interface.hpp>
+#include <CommonLib/Communication/RingBuffer.hpp>
+#include "Test.hpp"
+
+using ByteBuffer = Lib::Network::ByteBuffer;
+using RingBuffer = Lib::Network::RingBuffer;
+using SimpleMessage = Lib::Network::SimpleMessage;
+using TcpCommunicationInterface = Lib::Network::TcpCommunicationInterface;
+using ReceivedData = Lib::Network::ReceivedData;
+
+using namespace Test;
+
+void test_wrap_around()
+{
+    std::cout << "[TEST 1/4] Ring Buffer Wrap-Around: ";
+    RingBuffer ring(10);
+    assert_eq<std::size_t>(ring.getCapacity(), 16);
+
+    unsigned char in[12], out[12];
+    for (int idx = 0; idx < 12; idx++) in[idx] = idx;
+
+    // Moves the head close to the end, so that the next write wraps around
+    assert_eq<bool>(ring.write(in, 12), true);
+    ring.consume(12);
+    assert_eq<bool>(ring.write(in, 12), true);
+    assert_eq<bool>(ring.write(in, 5), false);
+    assert_eq<std::size_t>(ring.getContiguousFreeSpace(), 4);
+
+    ring.peek(out, 12);
+    for (int idx = 0; idx < 12; idx++) assert_eq<unsigned int>(out[idx], idx);
+
+    ByteBuffer buffer(12);
+    ring.read(buffer, 12);
+    assert_eq<bool>(ring.isEmpty(), true);
+    assert_eq<std::size_t>(buffer.getBufferSize(), 12);
+    for (int idx = 0; idx < 12; idx++) assert_eq<unsigned int>(buffer.getData()[idx], idx);
+    std::cout << "Passed" << std::endl;
+}
+
+void test_reserve()
+{
+    std::cout << "[TEST 2/4] Ring Buffer Growth: ";
+    RingBuffer ring(16);
+
+    unsigned char in[12], out[20];
+    for (int idx = 0; idx < 12; idx++) in[idx] = idx;
+
+    ring.write(in, 12);
+    ring.consume(8);
+    ring.write(in, 12); // Wraps around
+    ring.reserve(20);
+    assert_eq<std::size_t>(ring.getCapacity(), 32);
+    assert_eq<std::size_t>(ring.getSize(), 16);
+
+    // The content survives the growth, in the same order
+    ring.read(out, 16);
+    for (int idx = 0; idx < 4; idx++) assert_eq<unsigned int>(out[idx], idx + 8);
+    for (int idx = 0; idx < 12; idx++) assert_eq<unsigned int>(out[idx + 4], idx);
+    std::cout << "Passed" << std::endl;
+}
+
+// Connects a plain socket to the given local port, waiting for the listener
+int connectTo(unsigned short port)
+{
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+
+    for (int attempt = 0; attempt < 50; attempt++)
+    {
+        int fd = socket(AF_INET, SOCK_STREAM, 0);
+        if (connect(fd, (struct sockaddr*)&addr, sizeof(addr)) == 0) return fd;
+
+        close(fd);
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+
+    return -1;
+}
+
+void test_stream_framing()
+{
+    std::cout << "[TEST 3/4] Coalesced and Split Messages: ";
+    TcpCommunicationInterface tcp_int("127.0.0.1", 1420, 1421, 2, 8, 1, 0);
+    tcp_int.start();
+
+    std::string first = "first", second = "second", third = "third";
+    SimpleMessage m1(1, 1, first), m2(1, 2, second), m3(1, 3, third);
+    m1.encode(); m2.encode(); m3.encode();
+
+    // Two messages in a single write, then a message in two pieces
+    ByteBuffer stream(m1.getBufferSize() + m2.getBufferSize() + m3.getBufferSize());
+    stream.put(m1.getData(), m1.getBufferSize());
+    stream.put(m2.getData(), m2.getBufferSize());
+    stream.put(m3.getData(), m3.getBufferSize());
+
+    int fd = connectTo(1421);
+    assert_neq<int>(fd, -1);
+    std::size_t split = m1.getBufferSize() + m2.getBufferSize() + 5;
+    send(fd, stream.getData(), split, MSG_NOSIGNAL);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    send(fd, stream.getData() + split, stream.getBufferSize() - split, MSG_NOSIGNAL);
+
+    for (const std::string &expected : {first, second, third})
+    {
+        ReceivedData data = tcp_int.getReceivedElement();
+        SimpleMessage recv(*data.data);
+        assert_eq<std::string>(recv.getMessage(), expected);
+    }
+
+    close(fd);
+    tcp_int.close();
+    std::cout << "Passed" << std::endl;
+}
+
+void test_large_message()
+{
+    std::cout << "[TEST 4/4] Message larger than the ring buffer: ";
+    TcpCommunicationInterface tcp_int_1("127.0.0.1", 1422, 1423, 2, 8, 1, 0);
+    TcpCommunicationInterface tcp_int_2("127.0.0.1", 1424, 1425, 2, 8, 1, 0);
+    tcp_int_1.start();
+    tcp_int_2.start();
+
+    std::string content(4 * 1024 * 1024, 'x');
+    for (std::size_t idx = 0; idx < content.size(); idx += 4096) content[idx] = 'a' + (idx / 4096) % 26;
+    SimpleMessage large(1, 1, content);
+    tcp_int_1.sendTo("127.0.0.1", 1425, large);
+
+    ReceivedData data = tcp_int_2.getReceivedElement();
+    SimpleMessage recv(*data.data);
+    assert_eq<std::size_t>(recv.getMessage().size(), content.size());
+    assert_eq<bool>(recv.getMessage() == content, true);
+
+    tcp_int_1.close();
+    tcp_int_2.close();
+    std::cout << "Passed" << std::endl;
+}
+
+int main()
+{
+    test_wrap_around();
+    test_reserve();
+    test_stream_framing();
+    test_large_message();
+    return 0;
+}
@@ -0,0 +1,93 @@
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <Qube/WorkerRoster.hpp>
+#include "Test.hpp"
+
+using WorkerRoster = Qube::WorkerRoster;
+using RosterEntry = Qube::RosterEntry;
+
+using namespace Test;
+
+const std::string ROSTER_PATH = "/tmp/disqube-roster-test";
+
+RosterEntry make_entry(unsigned int addr, unsigned short port, std::uint64_t last_seen)
+{
+    return {addr, port, (unsigned short)(port + 1), 2048, 512, 37, last_seen};
+}
+
+void test_save_load()
+{
+    std::cout << "[TEST 1/3] Save and load of the roster: ";
+    std::filesystem::remove_all(ROSTER_PATH);
+
+    WorkerRoster roster(ROSTER_PATH);
+    assert_eq<bool>(roster.load(), false);
+
+    roster.update(make_entry(0xAC1E0A01, 33333, 1000));
+    roster.update(make_entry(0xAC1E0A02, 33333, 2000));
+    assert_eq<bool>(roster.save(), true);
+    assert_eq<std::uintmax_t>(std::filesystem::file_size(roster.getPath()),
+        WorkerRoster::HEADER_SIZE + 2 * WorkerRoster::RECORD_SIZE);
+
+    WorkerRoster loaded(ROSTER_PATH);
+    assert_eq<bool>(loaded.load(), true);
+    assert_eq<std::size_t>(loaded.getEntries().size(), 2);
+
+    const RosterEntry &entry = loaded.getEntries()[1];
+    assert_eq<unsigned int>(entry.addr, 0xAC1E0A02);
+    assert_eq<unsigned short>(entry.udp_port, 33333);
+    assert_eq<unsigned short>(entry.tcp_port, 33334);
+    assert_eq<unsigned int>(entry.ram_mb, 2048);
+    assert_eq<unsigned int>(entry.ram_kb, 512);
+    assert_eq<unsigned int>(entry.cpu_usage, 37);
+    assert_eq<std::uint64_t>(entry.last_seen, 2000);
+    std::cout << "Passed" << std::endl;
+}
+
+void test_invalid_file()
+{
+    std::cout << "[TEST 2/3] Truncated or foreign roster files: ";
+    WorkerRoster roster(ROSTER_PATH);
+
+    // Drop the last byte of the last record
+    std::filesystem::resize_file(roster.getPath(), std::filesystem::file_size(roster.getPath()) - 1);
+    assert_eq<bool>(roster.load(), false);
+    assert_eq<std::size_t>(roster.getEntries().size(), 0);
+
+    std::ofstream file(roster.getPath(), std::ios::binary | std::ios::trunc);
+    file << "not a roster at all";
+    file.close();
+    assert_eq<bool>(roster.load(), false);
+    std::cout << "Passed" << std::endl;
+}
+
+void test_update_recent()
+{
+    std::cout << "[TEST 3/3] Update and age of the workers: ";
+    std::uint64_t now = WorkerRoster::now_s();
+
+    WorkerRoster roster(ROSTER_PATH);
+    roster.update(make_entry(0xAC1E0A01, 33333, now - 7200));
+    roster.update(make_entry(0xAC1E0A02, 33333, now));
+    roster.update(make_entry(0xAC1E0A02, 33335, now));
+    roster.update(make_entry(0xAC1E0A01, 33333, now - 10));
+    assert_eq<std::size_t>(roster.getEntries().size(), 3);
+    assert_eq<std::uint64_t>(roster.getEntries()[0].last_seen, now - 10);
+
+    roster.update(make_entry(0xAC1E0A01, 33333, now - 7200));
+    std::vector<RosterEntry> recent = roster.getRecentEntries(3600);
+    assert_eq<std::size_t>(recent.size(), 2);
+    assert_eq<unsigned int>(recent[0].addr, 0xAC1E0A02);
+
+    std::filesystem::remove_all(ROSTER_PATH);
+    std::cout << "Passed" << std::endl;
+}
+
+int main()
+{
+    test_save_load();
+    test_invalid_file();
+    test_update_recent();
+    return 0;
+}
@@ -0,0 +1,123 @@
+#include <iostream>
+#include <CommonLib/Communication/Message.hpp>
+#include "Test.hpp"
+
+using ByteBuffer = Lib::Network::ByteBuffer;
+using ByteBufferView = Lib::Network::ByteBufferView;
+using Message = Lib::Network::Message;
+using DiscoverHelloMessage = Lib::Network::DiscoverHelloMessage;
+using DiscoverResponseMessage = Lib::Network::DiscoverResponseMessage;
+
+namespace Schema = Lib::Network::Schema;
+
+using namespace Test;
+
+// A layout with all the kinds of fields, as a new message would declare it
+struct Small : Schema::Field<uint8_t> {};
+struct Medium : Schema::Field<uint16_t> {};
+struct Large : Schema::Field<uint32_t> {};
+struct Huge : Schema::Field<uint64_t> {};
+
+using Custom = Schema::Layout<Small, Schema::Padding<1>, Medium, Large, Huge>;
+
+static_assert(Custom::SIZE == 16, "Wrong layout size");
+static_assert(Custom::OFFSET<Medium> == 2 && Custom::OFFSET<Huge> == 8, "Wrong field offsets");
+static_assert(Message::MSG_SUBTYPE_OFFSET == 5 && Message::MSG_PROTO_FLAG_OFFSET == 6 &&
+              Message::MSG_LENGTH_OFFSET == 8, "Wrong header offsets");
+static_assert(DiscoverHelloMessage::WIRE_SIZE == 20, "Wrong DiscoverHello size");
+static_assert(DiscoverResponseMessage::WIRE_SIZE == 32, "Wrong DiscoverResponse size");
+
+void test_layout()
+{
+    std::cout << "[TEST 1/3] Layout Encode/Decode: ";
+    Custom::Record in;
+    in.set<Small>(0xab);
+    in.set<Medium>(0x1234);
+    in.set<Large>(0x11223344);
+    in.set<Huge>(0x0102030405060708ULL);
+
+    for (bool bigEndian : {true, false})
+    {
+        unsigned char wire[Custom::SIZE];
+        memset(wire, 0xff, sizeof(wire));
+        Custom::encode(wire, in, bigEndian);
+        assert_eq<unsigned int>(wire[1], 0); // Padding is zeroed
+
+        Custom::Record out;
+        Custom::decode(wire, out, bigEndian);
+        assert_eq<uint8_t>(out.get<Small>(), 0xab);
+        assert_eq<uint16_t>(out.get<Medium>(), 0x1234);
+        assert_eq<uint32_t>(out.get<Large>(), 0x11223344);
+        assert_eq<uint64_t>(out.get<Huge>(), 0x0102030405060708ULL);
+    }
+
+    std::cout << "Passed" << std::endl;
+}
+
+void test_wire_compatibility()
+{
+    std::cout << "[TEST 2/3] Same bytes of the hand-written encoder: ";
+    DiscoverResponseMessage msg(7, 3);
+    msg.setMessageProtocol(Message::MessageProto::UDP);
+    msg.setUdpPort(1234);
+    msg.setTcpPort(4321);
+    msg.setIpAddress(0x0a000001);
+    msg.setAvailableMemory_mb(2048);
+    msg.setAvailableMemory_kb(512);
+    msg.setCpuUsage(42);
+    msg.encode();
+
+    // The put sequence of the encoder before the schema
+    ByteBuffer expected(DiscoverResponseMessage::WIRE_SIZE);
+    expected.put((unsigned short)3);
+    expected.put((unsigned short)7);
+    expected.put((unsigned char)Message::MessageType::DISCOVER);
+    expected.put((unsigned char)Message::MessageSubType::DISCOVER_RESPONSE);
+    expected.put((unsigned char)msg.getMessageProtoFlags());
+    expected.spare();
+    expected.put((unsigned int)DiscoverResponseMessage::WIRE_SIZE);
+    expected.put((unsigned short)1234);
+    expected.put((unsigned short)4321);
+    expected.put((unsigned int)0x0a000001);
+    expected.put((unsigned int)2048);
+    expected.put((unsigned int)512);
+    expected.put((unsigned char)42);
+    for (int idx = 0; idx < 3; idx++) expected.spare();
+
+    assert_eq<std::size_t>(msg.getBufferSize(), expected.getBufferSize());
+    assert_eq<int>(memcmp(msg.getData(), expected.getData(), expected.getBufferSize()), 0);
+    std::cout << "Passed" << std::endl;
+}
+
+void test_round_trip()
+{
+    std::cout << "[TEST 3/3] Message Round Trip: ";
+    DiscoverHelloMessage hello(9, 1);
+    hello.setMessageProtocol(Message::MessageProto::TCP);
+    hello.setUdpPort(5000);
+    hello.setTcpPort(5001);
+    hello.setIpAddress(0xc0a80001);
+    hello.encode();
+
+    DiscoverHelloMessage decoded(static_cast<const ByteBuffer&>(hello));
+    assert_eq<unsigned short>(decoded.getMessageId(), 9);
+    assert_eq<unsigned short>(decoded.getMessageCounter(), 1);
+    assert_eq<int>((int)decoded.getMessageProtocol(), (int)Message::MessageProto::TCP);
+    assert_eq<unsigned short>(decoded.getUdpPort(), 5000);
+    assert_eq<unsigned short>(decoded.getTcpPort(), 5001);
+    assert_eq<unsigned int>(decoded.getIpAddress(), 0xc0a80001);
+
+    // Views decode with the same code, without copying the bytes
+    ByteBufferView view(hello);
+    DiscoverHelloMessage viewed(view);
+    assert_eq<unsigned int>(viewed.getIpAddress(), 0xc0a80001);
+    std::cout << "Passed" << std::endl;
+}
+
+int main()
+{
+    test_layout();
+    test_wire_compatibility();
+    test_round_trip();
+    return 0;
+}
@@ -0,0 +1,79 @@
+#include <iostream>
+#include <set>
+#include <CommonLib/Communication/Interface.hpp>
+#include "Test.hpp"
+
+using Queue = Lib::Concurrency::Queue<int>;
+using Message = Lib::Network::Message;
+using SimpleMessage = Lib::Network::SimpleMessage;
+using UdpSender = Lib::Network::UdpSender;
+using UdpCommunicationInterface = Lib::Network::UdpCommunicationInterface;
+using ReceivedData = Lib::Network::ReceivedData;
+
+using namespace Test;
+
+void test_try_pop()
+{
+    std::cout << "[TEST 1/2] Non blocking pop from the queue: ";
+    Queue queue(4);
+    int element = -1;
+    assert_eq<bool>(queue.tryPop(element), false);
+    assert_eq<bool>(queue.tryPop(element, 20), false);
+    assert_eq<int>(element, -1);
+
+    queue.push(1);
+    queue.push(2);
+    assert_eq<bool>(queue.tryPop(element), true);
+    assert_eq<int>(element, 1);
+    assert_eq<bool>(queue.tryPop(element, 20), true);
+    assert_eq<int>(element, 2);
+    assert_eq<bool>(queue.isEmpty(), true);
+    std::cout << "Passed" << std::endl;
+}
+
+void test_sharded_interface()
+{
+    std::cout << "[TEST 2/2] Datagrams from many sources through the shards: ";
+    const std::size_t nofSenders = 16, nofMsgs = 8;
+    UdpCommunicationInterface udp_int("127.0.0.1", 0, 0, 128, UDP_BATCH_SIZE, false, 4);
+    unsigned short port = udp_int.getListenerPort(); // Chosen by the OS, shared by the shards
+    assert_eq<std::size_t>(udp_int.getNofShards(), 4);
+    udp_int.start();
+
+    // Each source port is hashed to one of the shards by the kernel
+    std::vector<std::unique_ptr<UdpSender>> senders;
+    for (std::size_t idx = 0; idx < nofSenders; idx++)
+        senders.push_back(std::make_unique<UdpSender>("127.0.0.1", 0));
+
+    for (std::size_t msg = 0; msg < nofMsgs; msg++)
+    {
+        for (std::size_t idx = 0; idx < nofSenders; idx++)
+        {
+            std::string content = "message " + std::to_string(msg);
+            SimpleMessage simple(idx, 0, content);
+            simple.setMessageProtocol(Message::MessageProto::UDP);
+            assert_eq<bool>(senders[idx]->sendTo("127.0.0.1", port, simple), true);
+        }
+    }
+
+    // All the datagrams arrive, and those of one source keep their order
+    std::vector<std::size_t> next(nofSenders, 0);
+    for (std::size_t count = 0; count < nofSenders * nofMsgs; count++)
+    {
+        ReceivedData data = udp_int.getReceivedElement();
+        SimpleMessage simple(*data.data);
+        unsigned short id = simple.getMessageId();
+        assert_eq<std::string>(simple.getMessage(), "message " + std::to_string(next[id]++));
+    }
+
+    for (auto &sender : senders) sender->closeSocket();
+    udp_int.close();
+    std::cout << "Passed" << std::endl;
+}
+
+int main()
+{
+    test_try_pop();
+    test_sharded_interface();
+    return 0;
+}
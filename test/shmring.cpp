@@ -0,0 +1,158 @@
+#include <iostream>
+#include <sys/wait.h>
+#include <CommonLib/Communication/Interface.hpp>
+#include "Test.hpp"
+
+using SharedRing = Lib::Network::SharedRing;
+using Message = Lib::Network::Message;
+using SimpleMessage = Lib::Network::SimpleMessage;
+using SharedMemoryCommunicationInterface = Lib::Network::SharedMemoryCommunicationInterface;
+using ReceivedData = Lib::Network::ReceivedData;
+
+using namespace Test;
+
+bool pushText(SharedRing &ring, const std::string &text)
+{
+    struct iovec iov;
+    iov.iov_base = const_cast<char*>(text.data());
+    iov.iov_len = text.size();
+    return ring.push(&iov, 1);
+}
+
+std::string popText(SharedRing &ring)
+{
+    std::size_t nofBytes;
+    const unsigned char *msg = ring.front(nofBytes);
+    if (msg == nullptr) return "";
+
+    std::string text((const char*)msg, nofBytes);
+    ring.pop();
+    return text;
+}
+
+void test_ring()
+{
+    std::cout << "[TEST 1/3] Messages through the shared ring: ";
+    SharedRing producer(256);
+
+    // The consumer maps the same memory through its own descriptors
+    SharedRing consumer(dup(producer.getMemoryFileDescriptor()), dup(producer.getEventFileDescriptor()));
+    assert_eq<std::size_t>(consumer.getCapacity(), 256);
+    assert_eq<bool>(consumer.isEmpty(), true);
+
+    // Records that do not fit before the end skip to the start
+    for (int round = 0; round < 20; round++)
+    {
+        std::string first(50 + round, 'a' + round % 26), second(30, 'z');
+        assert_eq<bool>(pushText(producer, first), true);
+        assert_eq<bool>(pushText(producer, second), true);
+        assert_eq<std::string>(popText(consumer), first);
+        assert_eq<std::string>(popText(consumer), second);
+    }
+
+    // No room left, until the consumer frees it
+    std::string large(100, 'x');
+    int pushed = 0;
+    while (pushText(producer, large)) pushed++;
+    assert_eq<bool>(pushed >= 1 && pushed <= 2, true);
+    assert_eq<bool>(pushText(producer, std::string(200, 'y')), false);
+    for (int idx = 0; idx < pushed; idx++) assert_eq<std::string>(popText(consumer), large);
+    assert_eq<bool>(consumer.isEmpty(), true);
+    assert_eq<bool>(pushText(producer, large), true);
+
+    // An idle consumer is woken up, a busy one is not
+    assert_eq<bool>(consumer.prepareWait(), false);
+    assert_eq<std::string>(popText(consumer), large);
+    assert_eq<bool>(consumer.prepareWait(), true);
+    pushText(producer, large);
+    std::uint64_t count = 0;
+    assert_eq<bool>(read(consumer.getEventFileDescriptor(), &count, sizeof(count)) == sizeof(count), true);
+    std::cout << "Passed" << std::endl;
+}
+
+void test_interfaces()
+{
+    std::cout << "[TEST 2/3] Interfaces in the same process: ";
+    SharedMemoryCommunicationInterface shm_1("127.0.0.1", 1512, 16, 1 << 16);
+    SharedMemoryCommunicationInterface shm_2("127.0.0.1", 1513, 16, 1 << 16);
+    shm_1.enableChecksum(true);
+    shm_1.start();
+    shm_2.start();
+
+    std::string small = "hello", large(20000, 'q');
+    SimpleMessage msg_1(1, 0, small), msg_2(2, 0, large), msg_3(3, 0, small);
+    shm_1.sendTo("127.0.0.1", 1513, msg_1);
+    shm_1.sendTo("127.0.0.1", 1513, msg_2);
+    shm_2.sendTo("127.0.0.1", 1512, msg_3);
+
+    ReceivedData data_1 = shm_2.getReceivedElement();
+    assert_eq<std::string>(SimpleMessage(*data_1.data).getMessage(), small);
+    assert_eq<unsigned short>(ntohs(data_1.src.sin_port), 1512);
+    ReceivedData data_2 = shm_2.getReceivedElement();
+    assert_eq<std::string>(SimpleMessage(*data_2.data).getMessage(), large);
+
+    // The answer goes back through the rings created by the first interface
+    ReceivedData data_3 = shm_1.getReceivedElement();
+    assert_eq<unsigned short>(SimpleMessage(*data_3.data).getMessageId(), 3);
+    assert_eq<std::size_t>(shm_1.getNofChannels(), 1);
+    assert_eq<std::size_t>(shm_2.getNofChannels(), 1);
+
+    shm_1.close();
+    shm_2.close();
+    std::cout << "Passed" << std::endl;
+}
+
+void test_processes()
+{
+    std::cout << "[TEST 3/3] Interfaces in different processes: ";
+    const int nofMsgs = 1000;
+    SharedMemoryCommunicationInterface shm_1("127.0.0.1", 1514, 64, 1 << 16);
+    shm_1.start();
+
+    pid_t child = fork();
+    if (child == 0)
+    {
+        // The child sends and waits for the acknowledgement. Its rings, created
+        // on the first send, hold all the messages, so none is dropped when the
+        // parent is slow to drain them on a loaded machine.
+        SharedMemoryCommunicationInterface shm_2("127.0.0.1", 1515, 16, 1 << 16);
+        shm_2.start();
+
+        std::string content(1000, 'c');
+        for (int idx = 0; idx < nofMsgs; idx++)
+        {
+            SimpleMessage msg(idx, 0, content);
+            shm_2.sendTo("127.0.0.1", 1514, msg);
+        }
+
+        ReceivedData ack = shm_2.getReceivedElement();
+        int code = SimpleMessage(*ack.data).getMessageId() == nofMsgs ? 0 : 1;
+        shm_2.close();
+        _exit(code);
+    }
+
+    for (int idx = 0; idx < nofMsgs; idx++)
+    {
+        ReceivedData data = shm_1.getReceivedElement();
+        assert_eq<unsigned short>(SimpleMessage(*data.data).getMessageId(), idx);
+    }
+
+    std::string content = "ack";
+    SimpleMessage ack(nofMsgs, 0, content);
+    shm_1.sendTo("127.0.0.1", 1515, ack);
+
+    int status;
+    waitpid(child, &status, 0);
+    assert_eq<int>(WEXITSTATUS(status), 0);
+
+    shm_1.close();
+    std::cout << "Passed" << std::endl;
+}
+
+int main()
+{
+    test_ring();
+    test_interfaces();
+    test_processes();
+    return 0;
+}
@@ -36,8 +36,8 @@ class TestStateMachine
             State_ptr s3 = std::make_shared<State>(StateType::QUBE_MAINTENANCE, 2);
             State_ptr s4 = std::make_shared<State>(StateType::QUBE_SHUTDOWN, 1);
 
-            s0->addTransition(s1, [](Input_t p){return p.itfReady && p.discoverFlag;});
-            s0->addTransition(s2, [](Input_t p){return p.itfReady && !p.discoverFlag;});
+            s0->addTransition(s1, [](Input_t p){return p.itfReady && p.discoverFlag && !p.rosterValid;});
+            s0->addTransition(s2, [](Input_t p){return p.itfReady && (!p.discoverFlag || p.rosterValid);});
             s1->addTransition(s4, [](Input_t p){return p.shutdown;});
             s1->addTransition(s2, [](Input_t p){return p.anyWorker;});
             s2->addTransition(s4, [](Input_t p){return p.shutdown;});
@@ -49,9 +49,9 @@ class TestStateMachine
             sm = std::make_shared<StateMachine>(s0);
         }
 
-        TestStateMachine(bool disc)
+        TestStateMachine(bool disc, bool roster = false)
         {
-            param = {true, disc, false, false, false};
+            param = {true, disc, false, false, false, false, roster};
             initStateMachine();
         }
 
@@ -99,7 +99,7 @@ class TestStateMachine
                 param.shutdown = true;
             }
 
-            if (!param.discoverFlag) param.anyWorker = true;
+            if (!param.discoverFlag || param.rosterValid) param.anyWorker = true;
 
             int cnt = 0;
             while (sm->checkCurrentState(param))
@@ -223,9 +223,36 @@ void test_discovering()
 }
 
 
+void test_warm_start()
+{
+    // The workers of the roster answered, the discover is skipped
+    TestStateMachine tsm(true, true);
+    tsm.run();
+
+    std::vector<StateType> expected = 
+    {
+        StateType::QUBE_INIT,
+        StateType::QUBE_OPERATIVE,
+        StateType::QUBE_MAINTENANCE,
+        StateType::QUBE_OPERATIVE,
+        StateType::QUBE_MAINTENANCE,
+        StateType::QUBE_OPERATIVE,
+        StateType::QUBE_MAINTENANCE,
+        StateType::QUBE_OPERATIVE,
+        StateType::QUBE_DISCOVERING
+    };
+
+    for (std::size_t i = 0; i < expected.size(); i++)
+    {
+        assert_eq<StateType>(expected[i], tsm.visited[i]);
+    }
+}
+
+
 int main()
 {
     test_without_discovering();
     test_discovering();
+    test_warm_start();
     return 0;
 }
\ No newline at end of file
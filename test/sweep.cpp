@@ -0,0 +1,84 @@
+#include <iostream>
+#include <CommonLib/Communication/Interface.hpp>
+#include <CommonLib/Communication/TokenBucket.hpp>
+#include <Qube/DiscoverSweep.hpp>
+#include "Test.hpp"
+
+using Message = Lib::Network::Message;
+using SimpleMessage = Lib::Network::SimpleMessage;
+using TokenBucket = Lib::Network::TokenBucket;
+using UdpCommunicationInterface = Lib::Network::UdpCommunicationInterface;
+using ReceivedData = Lib::Network::ReceivedData;
+using DiscoverSweep = Qube::DiscoverSweep;
+
+using namespace Test;
+
+void test_token_bucket()
+{
+    std::cout << "[TEST 1/2] Token bucket pacing: ";
+    TokenBucket unlimited(0, 1);
+    assert_eq<std::size_t>(unlimited.acquire(1000), 1000);
+
+    // The burst is available right away, then 1 token each millisecond
+    TokenBucket bucket(1000, 10);
+    assert_eq<std::size_t>(bucket.tryAcquire(100), 10);
+    assert_eq<std::size_t>(bucket.tryAcquire(100), 0);
+
+    auto start = std::chrono::steady_clock::now();
+    std::size_t taken = 0;
+    while (taken < 100) taken += bucket.acquire(100 - taken);
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    assert_eq<bool>(elapsed.count() >= 90, true);
+    std::cout << "Passed" << std::endl;
+}
+
+void test_sweep()
+{
+    std::cout << "[TEST 2/2] Paced sweep of encoded datagrams: ";
+    auto sender = std::make_shared<UdpCommunicationInterface>("127.0.0.1", 1536, 1537, 8);
+    UdpCommunicationInterface receiver("127.0.0.1", 1538, 1539, 1024);
+    sender->enableChecksum(true);
+    receiver.start();
+
+    // At 2000 packets per second the sweep takes about 100 ms
+    const std::size_t nofMsgs = 200;
+    DiscoverSweep sweep(sender, 2000, 16);
+    for (std::size_t idx = 0; idx < nofMsgs; idx++)
+    {
+        std::string content = "hello " + std::to_string(idx);
+        SimpleMessage msg(idx, 0, content);
+        msg.setMessageProtocol(Message::MessageProto::UDP);
+        sweep.add(0x7F000001, 1539, msg);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    sweep.start();
+
+    // Messages are received while the sweep is still running
+    ReceivedData first = receiver.getReceivedElement();
+    assert_eq<std::string>(SimpleMessage(*first.data).getMessage(), "hello 0");
+    assert_eq<bool>(sweep.isRunning(), true);
+
+    for (std::size_t idx = 1; idx < nofMsgs; idx++)
+    {
+        ReceivedData data = receiver.getReceivedElement();
+        assert_eq<std::string>(SimpleMessage(*data.data).getMessage(), "hello " + std::to_string(idx));
+    }
+
+    sweep.join();
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    assert_eq<bool>(sweep.isRunning(), false);
+    assert_eq<std::size_t>(sweep.getNofSent(), nofMsgs);
+    assert_eq<bool>(elapsed.count() >= 80, true);
+
+    receiver.close();
+    sender->close();
+    std::cout << "Passed" << std::endl;
+}
+
+int main()
+{
+    test_token_bucket();
+    test_sweep();
+    return 0;
+}
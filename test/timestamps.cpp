@@ -0,0 +1,118 @@
+#include <iostream>
+#include <CommonLib/Communication/Interface.hpp>
+#include <CommonLib/Communication/IoUring.hpp>
+#include <CommonLib/System/Latency.hpp>
+#include "Test.hpp"
+
+using IoUring = Lib::Network::IoUring;
+using Listener = Lib::Network::Listener;
+using Message = Lib::Network::Message;
+using SimpleMessage = Lib::Network::SimpleMessage;
+using UdpSender = Lib::Network::UdpSender;
+using UdpListener = Lib::Network::UdpListener;
+using UringUdpListener = Lib::Network::UringUdpListener;
+using LocalListener = Lib::Network::LocalListener;
+using ReceivedData = Lib::Network::ReceivedData;
+using LatencyHistogram = Lib::System::LatencyHistogram;
+
+using namespace Test;
+
+void test_histogram()
+{
+    std::cout << "[TEST 1/3] Latency histogram buckets and percentiles: ";
+    LatencyHistogram histogram;
+    assert_eq<std::uint64_t>(histogram.getPercentile_us(50), 0);
+
+    // 90 latencies of 3us and 10 of 1000us
+    for (int idx = 0; idx < 90; idx++) histogram.record(1000000, 1003000);
+    for (int idx = 0; idx < 10; idx++) histogram.record(1000000, 2000000);
+
+    // Missing or unordered timestamps are not recorded
+    histogram.record(0, 1000);
+    histogram.record(2000, 1000);
+
+    assert_eq<std::uint64_t>(histogram.getCount(), 100);
+    assert_eq<std::uint64_t>(histogram.getBucket(2), 90);
+    assert_eq<std::uint64_t>(histogram.getBucket(10), 10);
+    assert_eq<std::uint64_t>(histogram.getMax_us(), 1000);
+    assert_eq<std::uint64_t>(histogram.getMean_us(), (90 * 3 + 10 * 1000) / 100);
+    assert_eq<std::uint64_t>(histogram.getPercentile_us(50), 3);
+    assert_eq<std::uint64_t>(histogram.getPercentile_us(99), 1000);
+
+    histogram.reset();
+    assert_eq<std::uint64_t>(histogram.getCount(), 0);
+    std::cout << "Passed" << std::endl;
+}
+
+// Sends a message to the listener and checks the stamps of the received one
+void check_timestamps(Listener &listener, const unsigned short port, const bool local)
+{
+    UdpSender sender("127.0.0.1", port + 1);
+    if (local) sender.setLocalTransport(true);
+
+    std::string content = "stamped";
+    SimpleMessage msg(1, 0, content);
+    msg.setMessageProtocol(Message::MessageProto::UDP);
+
+    // The kernel turns on the stamping of the receive path asynchronously,
+    // hence the very first datagrams can arrive without a timestamp.
+    ReceivedData data;
+    std::uint64_t before;
+    for (int attempt = 0; attempt < 10; attempt++)
+    {
+        before = Lib::System::getRealTime_ns();
+        assert_eq<bool>(sender.sendTo("127.0.0.1", port, msg), true);
+
+        data = listener.getElement();
+        assert_eq<std::string>(SimpleMessage(*data.data).getMessage(), content);
+        if (data.kernel_ns != 0) break;
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    assert_eq<bool>(data.kernel_ns >= before, true);
+    assert_eq<bool>(data.receiver_ns >= data.kernel_ns, true);
+    assert_eq<std::uint64_t>(data.dispatcher_ns, 0);
+    assert_eq<std::uint64_t>(data.handler_ns, 0);
+
+    sender.closeSocket();
+}
+
+void test_udp_timestamps()
+{
+    std::cout << "[TEST 2/3] Kernel receive timestamps of UDP datagrams: ";
+    UdpListener listener("127.0.0.1", 1516, std::make_shared<Lib::Concurrency::Queue<ReceivedData>>(8));
+    listener.start();
+    check_timestamps(listener, 1516, false);
+    listener.stop();
+    listener.join();
+
+    if (IoUring::isSupported())
+    {
+        UringUdpListener uring("127.0.0.1", 1518, 8);
+        uring.start();
+        check_timestamps(uring, 1518, false);
+        uring.stop();
+        uring.join();
+    }
+
+    std::cout << "Passed" << std::endl;
+}
+
+void test_local_timestamps()
+{
+    std::cout << "[TEST 3/3] Kernel receive timestamps of local datagrams: ";
+    LocalListener listener("127.0.0.1", 1520, std::make_shared<Lib::Concurrency::Queue<ReceivedData>>(8));
+    listener.start();
+    check_timestamps(listener, 1520, true);
+    listener.stop();
+    listener.join();
+    std::cout << "Passed" << std::endl;
+}
+
+int main()
+{
+    test_histogram();
+    test_udp_timestamps();
+    test_local_timestamps();
+    return 0;
+}
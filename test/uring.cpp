@@ -0,0 +1,149 @@
+#include <iostream>
+#include <thread>
+#include <chrono>
+#include <arpa/inet.h>
+#include <CommonLib/Communication/Interface.hpp>
+#include <CommonLib/Communication/IoUring.hpp>
+#include "Test.hpp"
+
+using IoUring = Lib::Network::IoUring;
+using Message = Lib::Network::Message;
+using SimpleMessage = Lib::Network::SimpleMessage;
+using Datagram = Lib::Network::Datagram;
+using UdpSender = Lib::Network::UdpSender;
+using UringUdpListener = Lib::Network::UringUdpListener;
+using UdpCommunicationInterface = Lib::Network::UdpCommunicationInterface;
+using ReceivedData = Lib::Network::ReceivedData;
+
+using namespace Test;
+
+void test_burst()
+{
+    std::cout << "[TEST 1/3] Burst of datagrams through io_uring: ";
+    if (!IoUring::isSupported())
+    {
+        std::cout << "Skipped (not supported by the kernel)" << std::endl;
+        return;
+    }
+
+    // More datagrams than registered buffers, they must be recycled
+    const std::size_t nofMsgs = IOURING_RECV_BUFFERS + 100;
+    UringUdpListener listener("127.0.0.1", 1478, nofMsgs);
+    UdpSender sender("127.0.0.1", 1479);
+    listener.start();
+
+    struct sockaddr_in dst;
+    memset(&dst, 0, sizeof(dst));
+    dst.sin_family = AF_INET;
+    dst.sin_port = htons(1478);
+    inet_pton(AF_INET, "127.0.0.1", &dst.sin_addr);
+
+    std::vector<SimpleMessage> msgs;
+    std::vector<Datagram> datagrams(nofMsgs);
+    msgs.reserve(nofMsgs);
+
+    for (std::size_t idx = 0; idx < nofMsgs; idx++)
+    {
+        std::string content = "message " + std::to_string(idx);
+        msgs.emplace_back(idx, 0, content);
+        msgs.back().setMessageProtocol(Message::MessageProto::UDP);
+        msgs.back().encode();
+        datagrams[idx] = {dst, msgs.back().getData(), msgs.back().getBufferSize()};
+    }
+
+    // Sent in a few rounds, not to overflow the socket buffer
+    for (std::size_t idx = 0; idx < nofMsgs; idx += 64)
+    {
+        std::size_t count = std::min<std::size_t>(64, nofMsgs - idx);
+        assert_eq<std::size_t>(sender.sendBatch(datagrams.data() + idx, count), count);
+        for (std::size_t msg = idx; msg < idx + count; msg++)
+        {
+            ReceivedData data = listener.getElement();
+            assert_eq<std::string>(SimpleMessage(*data.data).getMessage(), "message " + std::to_string(msg));
+            assert_eq<unsigned short>(ntohs(data.src.sin_port), 1479);
+        }
+    }
+
+    listener.stop();
+    listener.join();
+    assert_eq<bool>(listener.hasStoppedWithErrors(), false);
+    sender.closeSocket();
+    std::cout << "Passed" << std::endl;
+}
+
+void test_interface()
+{
+    std::cout << "[TEST 2/3] Interfaces with and without io_uring: ";
+    UdpCommunicationInterface udp_int_1("127.0.0.1", 1480, 1481, 8, UDP_BATCH_SIZE, true);
+    UdpCommunicationInterface udp_int_2("127.0.0.1", 1482, 1483, 8, UDP_BATCH_SIZE, false);
+    assert_eq<bool>(udp_int_1.isUsingIoUring(), IoUring::isSupported());
+    assert_eq<bool>(udp_int_2.isUsingIoUring(), false);
+
+    // Checksums and compression are handled by both the listeners
+    udp_int_1.enableChecksum(true);
+    udp_int_2.enableChecksum(true);
+    udp_int_2.enableCompression(64);
+    udp_int_1.start();
+    udp_int_2.start();
+
+    std::string small = "hello", large(1000, 'a');
+    SimpleMessage msg_1(1, 0, small), msg_2(2, 0, large);
+    udp_int_1.sendTo("127.0.0.1", 1483, msg_1);
+    udp_int_2.sendTo("127.0.0.1", 1481, msg_2);
+
+    ReceivedData data_1 = udp_int_2.getReceivedElement();
+    assert_eq<std::string>(SimpleMessage(*data_1.data).getMessage(), small);
+    ReceivedData data_2 = udp_int_1.getReceivedElement();
+    assert_eq<std::string>(SimpleMessage(*data_2.data).getMessage(), large);
+
+    udp_int_1.close();
+    udp_int_2.close();
+    std::cout << "Passed" << std::endl;
+}
+
+void test_sources()
+{
+    std::cout << "[TEST 3/3] Queued datagrams keep their own source: ";
+    if (!IoUring::isSupported())
+    {
+        std::cout << "Skipped (not supported by the kernel)" << std::endl;
+        return;
+    }
+
+    const std::size_t nofMsgs = 20;
+    UringUdpListener listener("127.0.0.1", 0, nofMsgs);
+    UdpSender sender_1("127.0.0.1", 0), sender_2("127.0.0.1", 0);
+    unsigned short port = listener.getSocket().getPortNumber();
+    listener.start();
+
+    for (std::size_t idx = 0; idx < nofMsgs; idx++)
+    {
+        std::string content = "source";
+        SimpleMessage msg(idx, 0, content);
+        msg.setMessageProtocol(Message::MessageProto::UDP);
+        assert_eq<bool>(((idx % 2) ? sender_2 : sender_1).sendTo("127.0.0.1", port, msg), true);
+    }
+
+    // All the completions are handled before the first message is taken
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    for (std::size_t idx = 0; idx < nofMsgs; idx++)
+    {
+        ReceivedData data = listener.getElement();
+        UdpSender &sender = (SimpleMessage(*data.data).getMessageId() % 2) ? sender_2 : sender_1;
+        assert_eq<unsigned short>(ntohs(data.src.sin_port), sender.getSocket().getPortNumber());
+    }
+
+    listener.stop();
+    listener.join();
+    sender_1.closeSocket();
+    sender_2.closeSocket();
+    std::cout << "Passed" << std::endl;
+}
+
+int main()
+{
+    test_burst();
+    test_interface();
+    test_sources();
+    return 0;
+}
@@ -0,0 +1,132 @@
+#include <iostream>
+#include <vector>
+#include <memory>
+#include <CommonLib/Communication/Sender.hpp>
+#include <CommonLib/Communication/Listener.hpp>
+#include "Test.hpp"
+
+using Message = Lib::Network::Message;
+using SimpleMessage = Lib::Network::SimpleMessage;
+using UdpSender = Lib::Network::UdpSender;
+using UdpListener = Lib::Network::UdpListener;
+using TcpSender = Lib::Network::TcpSender;
+using TcpListener = Lib::Network::TcpListener;
+using ReceivedData = Lib::Network::ReceivedData;
+using ZeroCopyStats = Lib::Network::ZeroCopyStats;
+
+using namespace Test;
+
+void test_prepare_checksum()
+{
+    std::cout << "[TEST 1/3] Separate header and trailer match the appended checksum: ";
+    std::string content(500, 'x');
+    SimpleMessage msg(7, 0, content);
+    msg.setMessageProtocol(Message::MessageProto::UDP);
+    msg.encode();
+
+    std::size_t n = msg.getBufferSize();
+    std::vector<unsigned char> appended(msg.getData(), msg.getData() + n);
+    appended.resize(n + Message::CHECKSUM_SIZE);
+    assert_eq<std::size_t>(Message::appendChecksum(appended.data(), n), n + Message::CHECKSUM_SIZE);
+
+    unsigned char header[Message::NUM_HEAD_BYTES];
+    unsigned char trailer[Message::CHECKSUM_SIZE];
+    Message::prepareChecksum(msg.getData(), n, header, trailer);
+
+    // The original message is left untouched
+    assert_eq<int>(memcmp(header, appended.data(), Message::NUM_HEAD_BYTES), 0);
+    assert_eq<int>(memcmp(msg.getData() + Message::NUM_HEAD_BYTES, appended.data() + Message::NUM_HEAD_BYTES,
+                          n - Message::NUM_HEAD_BYTES), 0);
+    assert_eq<int>(memcmp(trailer, appended.data() + n, Message::CHECKSUM_SIZE), 0);
+    std::cout << "Passed" << std::endl;
+}
+
+void test_udp_sends()
+{
+    std::cout << "[TEST 2/3] UDP scatter-gather and zero-copy sends: ";
+    UdpListener listener("127.0.0.1", 1484, 8);
+    UdpSender sender("127.0.0.1", 1485);
+    sender.setChecksumEnabled(true);
+    listener.start();
+
+    std::string small = "hello", large(4000, 'z');
+    SimpleMessage msg_1(1, 0, small), msg_2(2, 0, large);
+    auto msg_3 = std::make_shared<SimpleMessage>(3, 0, large);
+    msg_1.setMessageProtocol(Message::MessageProto::UDP);
+    msg_2.setMessageProtocol(Message::MessageProto::UDP);
+    msg_3->setMessageProtocol(Message::MessageProto::UDP);
+
+    // Only the larger messages go above the threshold, and only
+    // the shared one can be kept alive by the sender
+    sender.setZeroCopyThreshold(1024);
+    assert_eq<bool>(sender.sendTo("127.0.0.1", 1484, msg_1), true);
+    assert_eq<bool>(sender.sendTo("127.0.0.1", 1484, msg_2), true);
+    assert_eq<std::uint32_t>(sender.getSocket().getZeroCopyStats().sent, 0);
+    assert_eq<bool>(sender.sendTo("127.0.0.1", 1484, std::shared_ptr<Message>(msg_3)), true);
+    assert_eq<std::string>(SimpleMessage(*listener.getElement().data).getMessage(), small);
+    assert_eq<std::string>(SimpleMessage(*listener.getElement().data).getMessage(), large);
+    assert_eq<std::string>(SimpleMessage(*listener.getElement().data).getMessage(), large);
+
+    // The send does not wait for the completion, the message stays
+    // pinned until it arrives. Kernels without SO_ZEROCOPY fall back
+    // to plain sends, that do not pin anything.
+    std::weak_ptr<SimpleMessage> pinned = msg_3;
+    msg_3 = nullptr;
+    ZeroCopyStats stats = sender.getSocket().getZeroCopyStats();
+    assert_eq<bool>(stats.sent <= 1, true);
+    assert_eq<bool>(pinned.expired(), stats.pending == 0);
+
+    assert_eq<bool>(sender.getSocket().waitZeroCopy(ZEROCOPY_WAIT_MS), true);
+    stats = sender.getSocket().getZeroCopyStats();
+    assert_eq<std::uint32_t>(stats.completed, stats.sent);
+    assert_eq<std::uint32_t>(stats.pending, 0);
+    assert_eq<bool>(pinned.expired(), true);
+
+    listener.stop();
+    listener.join();
+    sender.closeSocket();
+    std::cout << "Passed" << std::endl;
+}
+
+void test_tcp_sends()
+{
+    std::cout << "[TEST 3/3] TCP scatter-gather and zero-copy sends: ";
+    TcpListener listener("127.0.0.1", 1486, 8, 2);
+    TcpSender sender("127.0.0.1", 1487);
+    sender.setChecksumEnabled(true);
+    sender.setZeroCopyThreshold(1024);
+    listener.start();
+
+    std::string small = "hello", large(20000, 'q');
+    SimpleMessage msg_1(1, 0, small);
+    auto msg_2 = std::make_shared<SimpleMessage>(2, 0, large);
+    msg_1.setMessageProtocol(Message::MessageProto::TCP);
+    msg_2->setMessageProtocol(Message::MessageProto::TCP);
+
+    assert_eq<bool>(sender.sendTo("127.0.0.1", 1486, msg_1), true);
+    assert_eq<bool>(sender.sendTo("127.0.0.1", 1486, std::shared_ptr<Message>(msg_2)), true);
+    assert_eq<std::string>(SimpleMessage(*listener.getElement().data).getMessage(), small);
+    assert_eq<std::string>(SimpleMessage(*listener.getElement().data).getMessage(), large);
+
+    // The connection can be reused while the completion is pending
+    assert_eq<bool>(sender.sendTo("127.0.0.1", 1486, msg_1), true);
+    assert_eq<std::string>(SimpleMessage(*listener.getElement().data).getMessage(), small);
+    assert_eq<std::size_t>(sender.getNofConnections(), 1);
+
+    // Closing the connections releases the pinned message
+    std::weak_ptr<SimpleMessage> pinned = msg_2;
+    msg_2 = nullptr;
+    sender.closeSocket();
+    assert_eq<bool>(pinned.expired(), true);
+    listener.stop();
+    listener.join();
+    std::cout << "Passed" << std::endl;
+}
+
+int main()
+{
+    test_prepare_checksum();
+    test_udp_sends();
+    test_tcp_sends();
+    return 0;
+}